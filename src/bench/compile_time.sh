@@ -0,0 +1,72 @@
+#!/bin/bash
+# generate code to serialize structs with 10, 100 and 500 members, and
+# measure the compile time and the size of the object file.
+#
+# usage: compile_time.sh [compiler [include_dir]]
+# set COUNTS="10 100" to change the member counts to measure.
+
+set -e
+
+cxx=${1:-c++}
+include_dir=${2:-$(cd "$(dirname "$0")/../lib" && pwd)}
+# std::tuple of 500 items needs deeper instantiation than the default
+flags="-std=c++11 -O2 -Wall -Wconversion -Wold-style-cast -ftemplate-depth=2048"
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+types=("std::uint8_t" "std::int16_t" "std::uint32_t" "std::int64_t" "float"
+       "double" "std::array<std::uint16_t, 4>")
+
+# struct with $1 members, and a function to serialize and deserialize it
+# through 3 kinds of iterators
+generate() {
+  local count=$1
+  echo "#include <array>"
+  echo "#include <deque>"
+  echo "#include <loleseri/loleseri.hpp>"
+  echo "#include <vector>"
+  echo "struct wide {"
+  for ((i = 0; i < count; ++i)); do
+    echo "  ${types[i % ${#types[@]}]} m$i;"
+  done
+  echo "};"
+  echo "template <> struct loleseri::items<wide> {"
+  local members=""
+  for ((i = 0; i < count; ++i)); do
+    members+="&wide::m$i"
+    if ((i + 1 < count)); then
+      members+=", "
+    fi
+  done
+  echo "  static decltype(std::make_tuple($members)) list() {"
+  echo "    return std::make_tuple($members);"
+  echo "  }"
+  echo "};"
+  cat <<'EOF'
+std::size_t run(wide *w, std::uint8_t *p, std::vector<char> &v,
+                std::deque<char> &d) {
+  auto const size = loleseri::serializer<wide>::size;
+  loleseri::serialize(p, p + size, w);
+  loleseri::deserialize(p, p + size, w);
+  loleseri::serialize(v.begin(), v.end(), w);
+  loleseri::deserialize(v.cbegin(), v.cend(), w);
+  loleseri::serialize(d.begin(), d.end(), w);
+  loleseri::deserialize(d.cbegin(), d.cend(), w);
+  return size;
+}
+EOF
+}
+
+printf "%8s %10s %12s %12s\n" members seconds object text
+for count in ${COUNTS:-10 100 500}; do
+  src="$work/wide_$count.cpp"
+  obj="$work/wide_$count.o"
+  generate "$count" >"$src"
+  start=$(date +%s.%N)
+  "$cxx" $flags -I"$include_dir" -c "$src" -o "$obj"
+  stop=$(date +%s.%N)
+  seconds=$(awk "BEGIN { print $stop - $start }")
+  object=$(wc -c <"$obj")
+  text=$(size -A "$obj" | awk '$1 ~ /^\.text/ { s += $2 } END { print s }')
+  printf "%8d %10.2f %12d %12d\n" "$count" "$seconds" "$object" "$text"
+done
@@ -0,0 +1,412 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <loleseri/compact.hpp>
+#include <loleseri/loleseri.hpp>
+#include <tuple>
+#include <vector>
+
+/** 様々な算術型を持つ構造体 ( examples/simple と同じ ) */
+struct SimpleStruct {
+  std::int8_t foo;
+  std::int16_t bar;
+  std::int32_t baz;
+  std::int64_t qux;
+  float quux;
+  double corge;
+  bool grault;
+};
+
+template <> struct loleseri::items<SimpleStruct> {
+  using s = SimpleStruct;
+  using list_type =
+      std::tuple<std::int8_t s::*, std::int16_t s::*, std::int32_t s::*,
+                 std::int64_t s::*, float s::*, double s::*, bool s::*>;
+  static list_type list() {
+    return list_type(&s::foo, &s::bar, &s::baz, &s::qux, &s::quux, &s::corge,
+                     &s::grault);
+  }
+};
+
+/** 入れ子の構造体 ( examples/complex と同じ ) */
+template <typename element> struct point { element x, y, z; };
+
+struct foo {
+  point<float> bar;
+  std::array<point<int>, 3> baz;
+  point<std::uint16_t> qux[2];
+  point<point<std::int16_t>> quux;
+};
+
+template <typename element> struct loleseri::items<point<element>> {
+  using pt = point<element>;
+  static decltype(std::make_tuple(&pt::x, &pt::y, &pt::z)) list() {
+    return std::make_tuple(&pt::x, &pt::y, &pt::z);
+  }
+};
+
+template <> struct loleseri::items<foo> {
+  static decltype(std::make_tuple(&foo::bar, &foo::baz, &foo::qux,
+                                  &foo::quux))
+  list() {
+    return std::make_tuple(&foo::bar, &foo::baz, &foo::qux, &foo::quux);
+  }
+};
+
+/** 単調増加する時刻の列 */
+struct plain_ticks {
+  std::array<std::uint64_t, 4096> stamps;
+};
+
+/** 同じ列を delta of delta で書く */
+struct delta_ticks {
+  std::array<std::uint64_t, 4096> stamps;
+};
+
+template <> struct loleseri::items<plain_ticks> {
+  using list_type = std::tuple<std::array<std::uint64_t, 4096> plain_ticks::*>;
+  static list_type list() { return list_type{&plain_ticks::stamps}; }
+};
+
+template <> struct loleseri::items<delta_ticks> {
+  using list_type = std::tuple<loleseri::compact_item<
+      std::array<std::uint64_t, 4096>, delta_ticks,
+      loleseri::compact_encoding::delta_of_delta>>;
+  static list_type list() {
+    return list_type{loleseri::delta_of_delta(&delta_ticks::stamps)};
+  }
+};
+
+namespace {
+
+/** 手書きのシリアライザ。リトルエンディアンのホストを前提とする。 */
+struct hand_written {
+  template <typename value_type>
+  static std::uint8_t *put(std::uint8_t *p, value_type v) {
+    std::memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+  }
+  template <typename value_type>
+  static std::uint8_t const *get(std::uint8_t const *p, value_type *v) {
+    std::memcpy(v, p, sizeof(*v));
+    return p + sizeof(*v);
+  }
+  static std::uint8_t *serialize(std::uint8_t *p, SimpleStruct const &s) {
+    p = put(p, s.foo);
+    p = put(p, s.bar);
+    p = put(p, s.baz);
+    p = put(p, s.qux);
+    p = put(p, s.quux);
+    p = put(p, s.corge);
+    *p = s.grault ? 1 : 0;
+    return p + 1;
+  }
+  static std::uint8_t const *deserialize(std::uint8_t const *p,
+                                         SimpleStruct *s) {
+    p = get(p, &s->foo);
+    p = get(p, &s->bar);
+    p = get(p, &s->baz);
+    p = get(p, &s->qux);
+    p = get(p, &s->quux);
+    p = get(p, &s->corge);
+    s->grault = *p != 0;
+    return p + 1;
+  }
+};
+
+SimpleStruct make_simple(int i) {
+  return {static_cast<std::int8_t>(i),
+          static_cast<std::int16_t>(i * 3),
+          i * 5,
+          std::int64_t(i) * 7,
+          static_cast<float>(i) * 0.5f,
+          i * 0.25,
+          i % 2 == 0};
+}
+
+foo make_foo(int i) {
+  foo v;
+  auto f = static_cast<float>(i);
+  v.bar = {f, f + 1, f + 2};
+  for (auto &e : v.baz) {
+    e = {i, i + 1, i + 2};
+  }
+  for (auto &e : v.qux) {
+    auto u = static_cast<std::uint16_t>(i);
+    e = {u, u, u};
+  }
+  auto s = static_cast<std::int16_t>(i);
+  v.quux.x = v.quux.y = v.quux.z = {s, s, s};
+  return v;
+}
+
+template <typename value_type> value_type make_value(int i);
+
+template <> SimpleStruct make_value<SimpleStruct>(int i) {
+  return make_simple(i);
+}
+
+template <> foo make_value<foo>(int i) { return make_foo(i); }
+
+/** 算術型の大きな配列を作る */
+template <typename element, size_t count>
+std::array<element, count> make_array(int i) {
+  std::array<element, count> a;
+  for (size_t j = 0; j < count; ++j) {
+    a[j] = static_cast<element>(static_cast<size_t>(i) + j);
+  }
+  return a;
+}
+
+using u32_array = std::array<std::uint32_t, 4096>;
+using f64_array = std::array<double, 4096>;
+using foo_array = std::array<foo, 256>;
+
+template <> u32_array make_value<u32_array>(int i) {
+  return make_array<std::uint32_t, 4096>(i);
+}
+
+template <> f64_array make_value<f64_array>(int i) {
+  return make_array<double, 4096>(i);
+}
+
+template <> foo_array make_value<foo_array>(int i) {
+  foo_array a;
+  for (size_t j = 0; j < a.size(); ++j) {
+    a[j] = make_foo(i + static_cast<int>(j));
+  }
+  return a;
+}
+
+template <typename ticks> ticks make_ticks(int i) {
+  ticks r;
+  std::uint64_t t = 1600000000000000000ULL + static_cast<std::uint64_t>(i);
+  for (size_t j = 0; j < r.stamps.size(); ++j) {
+    t += 1000 + (j * 7919) % 64;
+    r.stamps[j] = t;
+  }
+  return r;
+}
+
+template <> plain_ticks make_value<plain_ticks>(int i) {
+  return make_ticks<plain_ticks>(i);
+}
+
+template <> delta_ticks make_value<delta_ticks>(int i) {
+  return make_ticks<delta_ticks>(i);
+}
+
+/** 出力先のバッファ
+ * @tparam container 連続した領域を持たないコンテナも可
+ */
+template <typename container> struct buffer_of {
+  container c;
+  explicit buffer_of(size_t size) : c(size) {}
+  typename container::iterator begin() { return c.begin(); }
+  typename container::iterator end() { return c.end(); }
+};
+
+/** 生のポインタを出力先にする */
+struct raw_pointer {};
+
+template <> struct buffer_of<raw_pointer> {
+  std::vector<std::uint8_t> c;
+  explicit buffer_of(size_t size) : c(size) {}
+  std::uint8_t *begin() { return c.data(); }
+  std::uint8_t *end() { return c.data() + c.size(); }
+};
+
+/** std::array を出力先にする */
+template <size_t size>
+struct buffer_of<std::array<std::uint8_t, size>> {
+  std::array<std::uint8_t, size> c;
+  explicit buffer_of(size_t) {}
+  typename std::array<std::uint8_t, size>::iterator begin() {
+    return c.begin();
+  }
+  typename std::array<std::uint8_t, size>::iterator end() { return c.end(); }
+};
+
+template <typename value_type>
+using array_buffer =
+    std::array<std::uint8_t, loleseri::serialized_size<value_type>()>;
+
+template <typename value_type, typename container>
+void BM_Serialize(benchmark::State &state) {
+  constexpr size_t size = loleseri::serialized_size<value_type>();
+  auto const value = make_value<value_type>(1);
+  buffer_of<container> buffer(size);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        loleseri::serialize(buffer.begin(), buffer.end(), &value));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+template <typename value_type, typename container>
+void BM_Deserialize(benchmark::State &state) {
+  constexpr size_t size = loleseri::serialized_size<value_type>();
+  auto const value = make_value<value_type>(1);
+  buffer_of<container> buffer(size);
+  loleseri::serialize(buffer.begin(), buffer.end(), &value);
+  value_type restored;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        loleseri::deserialize(buffer.begin(), buffer.end(), &restored));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+template <typename value_type>
+void BM_SerializeBigEndian(benchmark::State &state) {
+  constexpr size_t size = loleseri::serialized_size<value_type>();
+  auto const value = make_value<value_type>(1);
+  std::vector<std::uint8_t> buffer(size);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(loleseri::serialize<loleseri::byte_order::big>(
+        buffer.data(), buffer.data() + size, &value));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+template <typename value_type>
+void BM_SerializeBackInserter(benchmark::State &state) {
+  constexpr size_t size = loleseri::serialized_size<value_type>();
+  auto const value = make_value<value_type>(1);
+  std::vector<std::uint8_t> buffer;
+  buffer.reserve(size);
+  for (auto _ : state) {
+    buffer.clear();
+    auto out = std::back_inserter(buffer);
+    loleseri::serialize(out, out, &value);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+/** 可変長の値を書く。処理したバイト数はメモリ上の大きさで数える。 */
+template <typename value_type>
+void BM_SerializeVariable(benchmark::State &state) {
+  auto const value = make_value<value_type>(1);
+  std::vector<std::uint8_t> buffer(loleseri::serialized_size(value));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        loleseri::serialize(buffer.data(), buffer.data() + buffer.size(),
+                            &value));
+    benchmark::ClobberMemory();
+  }
+  state.counters["wire_bytes"] = static_cast<double>(buffer.size());
+  state.SetBytesProcessed(
+      static_cast<std::int64_t>(state.iterations() * sizeof(value_type)));
+}
+
+/** 可変長の値を読む。処理したバイト数はメモリ上の大きさで数える。 */
+template <typename value_type>
+void BM_DeserializeVariable(benchmark::State &state) {
+  auto const value = make_value<value_type>(1);
+  std::vector<std::uint8_t> buffer(loleseri::serialized_size(value));
+  loleseri::serialize(buffer.data(), buffer.data() + buffer.size(), &value);
+  value_type restored;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(loleseri::deserialize(
+        buffer.data(), buffer.data() + buffer.size(), &restored));
+    benchmark::ClobberMemory();
+  }
+  state.counters["wire_bytes"] = static_cast<double>(buffer.size());
+  state.SetBytesProcessed(
+      static_cast<std::int64_t>(state.iterations() * sizeof(value_type)));
+}
+
+/** 比較用。メモリ上のバイト列をそのままコピーする。 */
+template <typename value_type> void BM_Memcpy(benchmark::State &state) {
+  auto const value = make_value<value_type>(1);
+  std::vector<std::uint8_t> buffer(sizeof(value_type));
+  for (auto _ : state) {
+    std::memcpy(buffer.data(), &value, sizeof(value_type));
+    benchmark::DoNotOptimize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(
+      static_cast<std::int64_t>(state.iterations() * sizeof(value_type)));
+}
+
+void BM_HandWrittenSerialize(benchmark::State &state) {
+  constexpr size_t size = loleseri::serialized_size<SimpleStruct>();
+  auto const value = make_simple(1);
+  std::vector<std::uint8_t> buffer(size);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hand_written::serialize(buffer.data(), value));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+void BM_HandWrittenDeserialize(benchmark::State &state) {
+  constexpr size_t size = loleseri::serialized_size<SimpleStruct>();
+  auto const value = make_simple(1);
+  std::vector<std::uint8_t> buffer(size);
+  hand_written::serialize(buffer.data(), value);
+  SimpleStruct restored;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        hand_written::deserialize(buffer.data(), &restored));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Memcpy, SimpleStruct);
+BENCHMARK(BM_HandWrittenSerialize);
+BENCHMARK(BM_HandWrittenDeserialize);
+BENCHMARK_TEMPLATE(BM_Serialize, SimpleStruct, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Serialize, SimpleStruct, array_buffer<SimpleStruct>);
+BENCHMARK_TEMPLATE(BM_Serialize, SimpleStruct, std::vector<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_Serialize, SimpleStruct, std::deque<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_SerializeBackInserter, SimpleStruct);
+BENCHMARK_TEMPLATE(BM_SerializeBigEndian, SimpleStruct);
+BENCHMARK_TEMPLATE(BM_Deserialize, SimpleStruct, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Deserialize, SimpleStruct, array_buffer<SimpleStruct>);
+BENCHMARK_TEMPLATE(BM_Deserialize, SimpleStruct, std::vector<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_Deserialize, SimpleStruct, std::deque<std::uint8_t>);
+
+BENCHMARK_TEMPLATE(BM_Memcpy, foo);
+BENCHMARK_TEMPLATE(BM_Serialize, foo, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Serialize, foo, std::deque<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_SerializeBackInserter, foo);
+BENCHMARK_TEMPLATE(BM_Deserialize, foo, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Deserialize, foo, std::deque<std::uint8_t>);
+
+BENCHMARK_TEMPLATE(BM_Memcpy, u32_array);
+BENCHMARK_TEMPLATE(BM_Serialize, u32_array, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Serialize, u32_array, std::deque<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_SerializeBackInserter, u32_array);
+BENCHMARK_TEMPLATE(BM_SerializeBigEndian, u32_array);
+BENCHMARK_TEMPLATE(BM_Deserialize, u32_array, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Deserialize, u32_array, std::deque<std::uint8_t>);
+
+BENCHMARK_TEMPLATE(BM_Memcpy, f64_array);
+BENCHMARK_TEMPLATE(BM_Serialize, f64_array, raw_pointer);
+BENCHMARK_TEMPLATE(BM_SerializeBigEndian, f64_array);
+BENCHMARK_TEMPLATE(BM_Deserialize, f64_array, raw_pointer);
+
+BENCHMARK_TEMPLATE(BM_Memcpy, foo_array);
+BENCHMARK_TEMPLATE(BM_Serialize, foo_array, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Serialize, foo_array, std::vector<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_SerializeBigEndian, foo_array);
+BENCHMARK_TEMPLATE(BM_Deserialize, foo_array, raw_pointer);
+BENCHMARK_TEMPLATE(BM_Deserialize, foo_array, std::vector<std::uint8_t>);
+
+BENCHMARK_TEMPLATE(BM_SerializeVariable, plain_ticks);
+BENCHMARK_TEMPLATE(BM_DeserializeVariable, plain_ticks);
+BENCHMARK_TEMPLATE(BM_SerializeVariable, delta_ticks);
+BENCHMARK_TEMPLATE(BM_DeserializeVariable, delta_ticks);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,460 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/lz4_block.hpp>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace loleseri {
+
+/** header of the block of records. always serialized in little endian. */
+struct block_header {
+  /** "LLSB" */
+  std::array<std::uint8_t, 4> magic;
+
+  /** count of the records in the block */
+  std::uint32_t count;
+
+  /** byte count of serialized size of the record */
+  std::uint32_t record_size;
+
+  /** byte count of the body. the body is not compressed if this is
+   * count * record_size. */
+  std::uint32_t body_size;
+};
+
+/** items of the header of the block */
+template <> struct items<block_header> {
+  using list_type = std::tuple<std::array<std::uint8_t, 4> block_header::*,
+                               std::uint32_t block_header::*,
+                               std::uint32_t block_header::*,
+                               std::uint32_t block_header::*>;
+  static inline list_type list() {
+    return {&block_header::magic, &block_header::count,
+            &block_header::record_size, &block_header::body_size};
+  }
+};
+
+/** exception thrown if the block is broken or is not a block of the type */
+class invalid_block : public std::runtime_error {
+public:
+  /** create exception
+   * @param[in] what description of the error
+   */
+  explicit invalid_block(char const *what)
+      : std::runtime_error(std::string("loleseri: ") + what) {}
+};
+
+/** constants and helpers of the block
+ * @tparam target type of the record
+ * @tparam order byte order of the records
+ */
+template <typename target, byte_order order> struct block_format {
+  static_assert(is_fixed_size<target>::value,
+                "blocks support fixed size types only");
+
+  enum {
+    /** byte count of the header */
+    header_size = serializer<block_header>::size,
+
+    /** byte count of the record */
+    record_size = serializer<target, order>::size
+  };
+
+  /** type of the serialized header */
+  using header_buffer = serializer<block_header>::buffer;
+
+  /** default count of the records in a block
+   * @return count of the records
+   */
+  static size_t default_records() {
+    return std::max<size_t>(1, 64 * 1024 / record_size);
+  }
+
+  /** byte count of the records of a block. the count and the byte count
+   * must fit in the 32bit fields of the header.
+   * @param[in] records count of the records in a block
+   * @return byte count
+   * @throw std::length_error if the block is too large for the header
+   */
+  static size_t block_size(size_t records) {
+    if (std::numeric_limits<std::uint32_t>::max() / record_size < records) {
+      throw std::length_error("loleseri: too many records in a block");
+    }
+    return records * record_size;
+  }
+
+  /** serialize the header
+   * @param[in] count count of the records
+   * @param[in] body_size byte count of the body
+   * @return serialized header
+   */
+  static header_buffer make_header(size_t count, size_t body_size) {
+    block_header const header = {magic(), static_cast<std::uint32_t>(count),
+                                 record_size,
+                                 static_cast<std::uint32_t>(body_size)};
+    header_buffer r;
+    serialize(r.begin(), r.end(), &header);
+    return r;
+  }
+
+  /** deserialize and check the header
+   * @param[in] data top of the serialized header
+   * @return header
+   * @throw invalid_block if the header is broken or does not match
+   */
+  static block_header read_header(std::uint8_t const *data) {
+    auto const header = deserialize<block_header>(data, data + header_size);
+    if (header.magic != magic()) {
+      throw invalid_block("not a block");
+    }
+    if (header.record_size != record_size) {
+      throw invalid_block("record size does not match");
+    }
+    if (raw_size(header) < header.body_size) {
+      throw invalid_block("broken block");
+    }
+    return header;
+  }
+
+  /** byte count of the records in the block
+   * @param[in] header header of the block
+   * @return byte count
+   */
+  static size_t raw_size(block_header const &header) {
+    return static_cast<size_t>(header.count) * record_size;
+  }
+
+  /** magic number of the block
+   * @return "LLSB"
+   */
+  static std::array<std::uint8_t, 4> magic() {
+    return {{'L', 'L', 'S', 'B'}};
+  }
+};
+
+/** writer to gather records into blocks and write them to the sink with
+ * compression. each block is written as the header and the body, and the
+ * body is stored as is if compression does not make it smaller.
+ * @tparam target type of the record
+ * @tparam sink_t type of the sink. fd_sink, ostream_sink or any type which
+ * has write(head, head_size, body, body_size).
+ * @tparam order byte order of serialized data
+ * @tparam codec_t type of the codec. lz4_block_codec or any type which has
+ * max_compressed_size(size), compress(src, size, dest),
+ * max_decompressed_size(size) and decompress(src, size, dest, raw_size).
+ */
+template <typename target, typename sink_t,
+          byte_order order = byte_order::little,
+          typename codec_t = lz4_block_codec>
+class block_writer {
+  /** format of the block */
+  using format = block_format<target, order>;
+
+public:
+  /** type to serialize the record */
+  using seri = serializer<target, order>;
+
+  enum {
+    /** byte count of the record */
+    record_size = format::record_size
+  };
+
+  /** create writer
+   * @param[in] sink sink to write
+   * @param[in] block_records count of the records in a block
+   * @param[in] codec codec to compress blocks
+   * @throw std::length_error if the block is too large for the header
+   */
+  explicit block_writer(sink_t sink, size_t block_records = 0,
+                        codec_t codec = codec_t())
+      : sink_(sink), codec_(codec),
+        raw_(format::block_size(block_records != 0
+                                    ? block_records
+                                    : format::default_records())),
+        body_(codec_t::max_compressed_size(raw_.size())), used_(0) {}
+
+  block_writer(block_writer const &) = delete;
+  block_writer &operator=(block_writer const &) = delete;
+
+  /** flush the block. errors are ignored. call flush() to catch them. */
+  ~block_writer() {
+    try {
+      flush();
+    } catch (...) {
+    }
+  }
+
+  /** write a record
+   * @param[in] obj record to write
+   */
+  void write(target const &obj) {
+    auto p = raw_.data() + used_;
+    seri::serialize(p, p + record_size, &obj);
+    used_ += record_size;
+    if (used_ == raw_.size()) {
+      flush();
+    }
+  }
+
+  /** write records
+   * @param[in] first pointer to the first record
+   * @param[in] count count of the records
+   */
+  void write(target const *first, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      write(first[i]);
+    }
+  }
+
+  /** compress the gathered records and write them as a block */
+  void flush() {
+    if (used_ == 0) {
+      return;
+    }
+    size_t const compressed =
+        codec_.compress(raw_.data(), used_, body_.data());
+    bool const stored = used_ <= compressed;
+    size_t const body_size = stored ? used_ : compressed;
+    auto const header = format::make_header(used_ / record_size, body_size);
+    sink_.write(header.data(), header.size(),
+                stored ? raw_.data() : body_.data(), body_size);
+    used_ = 0;
+  }
+
+private:
+  /** sink to write */
+  sink_t sink_;
+
+  /** codec to compress blocks */
+  codec_t codec_;
+
+  /** serialized records of the block */
+  std::vector<std::uint8_t> raw_;
+
+  /** compressed records of the block */
+  std::vector<std::uint8_t> body_;
+
+  /** byte count of the used area of raw_ */
+  size_t used_;
+};
+
+/** reader to deserialize records from blocks. the body of the block is
+ * decompressed straight into the buffer, and the records are deserialized
+ * from the buffer in place. blocks can be skipped without decompression.
+ * @tparam target type of the record
+ * @tparam source_t type of the source. fd_source, istream_source or any type
+ * which has read(data, size).
+ * @tparam order byte order of serialized data
+ * @tparam codec_t type of the codec. see block_writer.
+ */
+template <typename target, typename source_t,
+          byte_order order = byte_order::little,
+          typename codec_t = lz4_block_codec>
+class block_reader {
+  /** format of the block */
+  using format = block_format<target, order>;
+
+public:
+  /** type to deserialize the record */
+  using deseri = deserializer<target, order>;
+
+  enum {
+    /** byte count of the record */
+    record_size = format::record_size
+  };
+
+  /** create reader
+   * @param[in] source source to read
+   */
+  explicit block_reader(source_t source) : source_(source), pos_(0) {}
+
+  /** read a record
+   * @param[out] obj address to write the record
+   * @return false if there are no more records
+   * @throw buffer_overrun if the stream ends in the middle of a block
+   * @throw invalid_block if the block is broken
+   */
+  bool read(target *obj) {
+    if (pos_ == raw_.size() && !next_block()) {
+      return false;
+    }
+    auto p = raw_.data() + pos_;
+    deseri::deserialize(p, p + record_size, obj);
+    pos_ += record_size;
+    return true;
+  }
+
+  /** read records
+   * @param[out] first address to write the first record
+   * @param[in] count maximum count of the records
+   * @return count of the records read
+   * @throw buffer_overrun if the stream ends in the middle of a block
+   * @throw invalid_block if the block is broken
+   */
+  size_t read(target *first, size_t count) {
+    size_t done = 0;
+    while (done < count) {
+      if (pos_ == raw_.size() && !next_block()) {
+        break;
+      }
+      size_t const n =
+          std::min(count - done, (raw_.size() - pos_) / record_size);
+      auto p = raw_.data() + pos_;
+      auto const end = p + n * record_size;
+      for (size_t i = 0; i < n; ++i) {
+        p = deseri::deserialize(p, end, first + done + i);
+      }
+      pos_ += n * record_size;
+      done += n;
+    }
+    return done;
+  }
+
+  /** skip the rest of the current block, or the next block if all records of
+   * the current block are read. the skipped block is not decompressed.
+   * @return count of the skipped records. 0 if there are no more blocks.
+   * @throw buffer_overrun if the stream ends in the middle of a block
+   * @throw invalid_block if the header is broken
+   */
+  size_t skip_block() {
+    if (pos_ != raw_.size()) {
+      size_t const rest = (raw_.size() - pos_) / record_size;
+      pos_ = raw_.size();
+      return rest;
+    }
+    block_header header;
+    for (;;) {
+      if (!read_header(&header)) {
+        return 0;
+      }
+      discard_body(header.body_size);
+      if (header.count != 0) {
+        return header.count;
+      }
+    }
+  }
+
+private:
+  /** byte count to read from the source at once. the body of the block is
+   * read in chunks, so a broken header cannot allocate a huge area before
+   * the source ends. */
+  enum { chunk_size = 64 * 1024 };
+
+  /** read and check the header of the next block
+   * @param[out] header address to write the header
+   * @return false if there are no more blocks
+   * @throw buffer_overrun if the stream ends in the middle of the header
+   * @throw invalid_block if the header is broken
+   */
+  bool read_header(block_header *header) {
+    typename format::header_buffer head;
+    size_t const r = read_fully(head.data(), head.size());
+    if (r == 0) {
+      return false;
+    }
+    if (r != head.size()) {
+      throw buffer_overrun();
+    }
+    *header = format::read_header(head.data());
+    size_t const raw_size = format::raw_size(*header);
+    if (header->body_size != raw_size &&
+        codec_t::max_decompressed_size(header->body_size) < raw_size) {
+      throw invalid_block("broken block");
+    }
+    return true;
+  }
+
+  /** read the body of the block into body_
+   * @param[in] size byte count of the body
+   * @throw buffer_overrun if the stream ends in the middle of the body
+   */
+  void read_body(size_t size) {
+    body_.clear();
+    while (body_.size() < size) {
+      size_t const done = body_.size();
+      size_t const n = std::min<size_t>(size - done, chunk_size);
+      body_.resize(done + n);
+      if (read_fully(body_.data() + done, n) != n) {
+        throw buffer_overrun();
+      }
+    }
+  }
+
+  /** read the body of the block and throw it away
+   * @param[in] size byte count of the body
+   * @throw buffer_overrun if the stream ends in the middle of the body
+   */
+  void discard_body(size_t size) {
+    std::array<std::uint8_t, 4096> buffer;
+    for (size_t done = 0; done < size;) {
+      size_t const n = std::min(size - done, buffer.size());
+      if (read_fully(buffer.data(), n) != n) {
+        throw buffer_overrun();
+      }
+      done += n;
+    }
+  }
+
+  /** read the next block and decompress it into the buffer
+   * @return false if there are no more blocks
+   */
+  bool next_block() {
+    block_header header;
+    do {
+      if (!read_header(&header)) {
+        return false;
+      }
+      read_body(header.body_size);
+    } while (header.count == 0);
+    size_t const raw_size = format::raw_size(header);
+    if (header.body_size == raw_size) {
+      raw_.swap(body_);
+    } else {
+      raw_.resize(raw_size);
+      if (!codec_t::decompress(body_.data(), body_.size(), raw_.data(),
+                               raw_size)) {
+        throw invalid_block("broken block");
+      }
+    }
+    pos_ = 0;
+    return true;
+  }
+
+  /** read bytes until the area is filled or the source ends
+   * @param[out] data top of the area to write
+   * @param[in] size byte count to read
+   * @return byte count read
+   */
+  size_t read_fully(std::uint8_t *data, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+      size_t const r = source_.read(data + done, size - done);
+      if (r == 0) {
+        break;
+      }
+      done += r;
+    }
+    return done;
+  }
+
+  /** source to read */
+  source_t source_;
+
+  /** decompressed records of the current block */
+  std::vector<std::uint8_t> raw_;
+
+  /** body of the block read from the source */
+  std::vector<std::uint8_t> body_;
+
+  /** byte offset of the next record in raw_ */
+  size_t pos_;
+};
+
+} // namespace loleseri
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined __SSSE3__ || defined __AVX2__
+#include <immintrin.h>
+#endif
+
+#if defined _MSC_VER
+#include <stdlib.h>
+#endif
+
+namespace loleseri {
+
+/** template to reverse byte order of integers
+ * @tparam unit byte count of the integer
+ */
+template <std::size_t unit> struct byte_swapper;
+
+/** reverse byte order of 16bit integers */
+template <> struct byte_swapper<2> {
+  /** unsigned integer type of the unit size */
+  using uint_type = std::uint16_t;
+
+  /** reverse byte order
+   * @param[in] v value to swap
+   * @return swapped value
+   */
+  static uint_type swap(uint_type v) {
+#if __clang__ || __GNUC__
+    return __builtin_bswap16(v);
+#elif defined _MSC_VER
+    return _byteswap_ushort(v);
+#else
+    return static_cast<uint_type>((v >> 8) | (v << 8));
+#endif
+  }
+};
+
+/** reverse byte order of 32bit integers */
+template <> struct byte_swapper<4> {
+  /** unsigned integer type of the unit size */
+  using uint_type = std::uint32_t;
+
+  /** reverse byte order
+   * @param[in] v value to swap
+   * @return swapped value
+   */
+  static uint_type swap(uint_type v) {
+#if __clang__ || __GNUC__
+    return __builtin_bswap32(v);
+#elif defined _MSC_VER
+    return _byteswap_ulong(v);
+#else
+    return ((v & 0xff000000u) >> 24) | ((v & 0x00ff0000u) >> 8) |
+           ((v & 0x0000ff00u) << 8) | ((v & 0x000000ffu) << 24);
+#endif
+  }
+};
+
+/** reverse byte order of 64bit integers */
+template <> struct byte_swapper<8> {
+  /** unsigned integer type of the unit size */
+  using uint_type = std::uint64_t;
+
+  /** reverse byte order
+   * @param[in] v value to swap
+   * @return swapped value
+   */
+  static uint_type swap(uint_type v) {
+#if __clang__ || __GNUC__
+    return __builtin_bswap64(v);
+#elif defined _MSC_VER
+    return _byteswap_uint64(v);
+#else
+    return (static_cast<uint_type>(byte_swapper<4>::swap(
+                static_cast<std::uint32_t>(v)))
+            << 32) |
+           byte_swapper<4>::swap(static_cast<std::uint32_t>(v >> 32));
+#endif
+  }
+};
+
+/** copy integers with reversing byte order of each integer.
+ * uses AVX2 or SSSE3 shuffle if available.
+ * @tparam unit byte count of the integer ( 2, 4 or 8 )
+ * @param[out] dest top of the area to write
+ * @param[in] src top of the integers to copy
+ * @param[in] count count of the integers
+ */
+template <std::size_t unit>
+void copy_swapped(void *dest, void const *src, std::size_t count) {
+  using swapper = byte_swapper<unit>;
+  using uint_type = typename swapper::uint_type;
+  auto d = static_cast<std::uint8_t *>(dest);
+  auto s = static_cast<std::uint8_t const *>(src);
+  std::size_t const size = count * unit;
+  std::size_t i = 0;
+#if defined __SSSE3__ || defined __AVX2__
+  // index of the source byte in the shuffle lane
+#define LOLESERI_SWAP_INDEX(j)                                                 \
+  static_cast<char>((j) / unit * unit + (unit - 1 - (j) % unit))
+#define LOLESERI_SWAP_MASK                                                     \
+  LOLESERI_SWAP_INDEX(0), LOLESERI_SWAP_INDEX(1), LOLESERI_SWAP_INDEX(2),      \
+      LOLESERI_SWAP_INDEX(3), LOLESERI_SWAP_INDEX(4), LOLESERI_SWAP_INDEX(5),  \
+      LOLESERI_SWAP_INDEX(6), LOLESERI_SWAP_INDEX(7), LOLESERI_SWAP_INDEX(8),  \
+      LOLESERI_SWAP_INDEX(9), LOLESERI_SWAP_INDEX(10),                         \
+      LOLESERI_SWAP_INDEX(11), LOLESERI_SWAP_INDEX(12),                        \
+      LOLESERI_SWAP_INDEX(13), LOLESERI_SWAP_INDEX(14), LOLESERI_SWAP_INDEX(15)
+#if defined __AVX2__
+  __m256i const mask256 =
+      _mm256_setr_epi8(LOLESERI_SWAP_MASK, LOLESERI_SWAP_MASK);
+  for (; i + 32 <= size; i += 32) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(s + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i),
+                        _mm256_shuffle_epi8(v, mask256));
+  }
+#endif
+  __m128i const mask128 = _mm_setr_epi8(LOLESERI_SWAP_MASK);
+  for (; i + 16 <= size; i += 16) {
+    auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(s + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i),
+                     _mm_shuffle_epi8(v, mask128));
+  }
+#undef LOLESERI_SWAP_MASK
+#undef LOLESERI_SWAP_INDEX
+#endif
+  for (; i < size; i += unit) {
+    uint_type v;
+    std::memcpy(&v, s + i, unit);
+    v = swapper::swap(v);
+    std::memcpy(d + i, &v, unit);
+  }
+}
+
+} // namespace loleseri
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <loleseri/loleseri.hpp>
+#include <vector>
+
+namespace loleseri {
+
+/** source of serialized bytes which arrive in chunks ( e.g. packets from the
+ * socket ). values in a chunk are deserialized from the chunk directly.
+ * values of fixed size across chunks are gathered into a small buffer, and
+ * values of variable size across chunks are read byte by byte through
+ * iterator.
+ */
+class chunked_source {
+public:
+  /** chunk of the bytes */
+  struct chunk {
+    /** top of the bytes. must be valid until the next refill. */
+    std::uint8_t const *data;
+
+    /** byte count. 0 means end of the source. */
+    size_t size;
+  };
+
+  /** type of the callback to get next chunk */
+  using refill_type = std::function<chunk()>;
+
+  /** single pass input iterator of the bytes of the source. all copies share
+   * the position of the source.
+   */
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::uint8_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::uint8_t const *;
+    using reference = std::uint8_t;
+
+    /** create end of the source */
+    iterator() : source_(nullptr) {}
+
+    /** create iterator
+     * @param[in] source source to read
+     */
+    explicit iterator(chunked_source *source) : source_(source) {}
+
+    /** current byte
+     * @return current byte
+     * @throw buffer_overrun if there are no more bytes
+     */
+    std::uint8_t operator*() const { return source_->peek(); }
+
+    /** go to the next byte
+     * @return this iterator
+     * @throw buffer_overrun if there are no more bytes
+     */
+    iterator &operator++() {
+      source_->skip(1);
+      return *this;
+    }
+
+    /** go to the next byte
+     * @return copy of the iterator
+     * @throw buffer_overrun if there are no more bytes
+     */
+    iterator operator++(int) {
+      iterator r = *this;
+      ++*this;
+      return r;
+    }
+
+    /** compare iterators. only the end of the source is distinguished.
+     * @param[in] that iterator to compare
+     * @return true if both are or are not at the end
+     */
+    bool operator==(iterator const &that) const {
+      return at_end() == that.at_end();
+    }
+
+    /** compare iterators. only the end of the source is distinguished.
+     * @param[in] that iterator to compare
+     * @return false if both are or are not at the end
+     */
+    bool operator!=(iterator const &that) const { return !(*this == that); }
+
+  private:
+    /** check the end of the source
+     * @return true if there are no more bytes
+     */
+    bool at_end() const { return source_ == nullptr || source_->empty(); }
+
+    /** source to read */
+    chunked_source *source_;
+  };
+
+  /** create source
+   * @param[in] refill callback to get the next chunk
+   */
+  explicit chunked_source(refill_type refill)
+      : refill_(std::move(refill)), pos_(nullptr), end_(nullptr),
+        eof_(false) {}
+
+  chunked_source(chunked_source const &) = delete;
+  chunked_source &operator=(chunked_source const &) = delete;
+
+  /** check the end of the source. the next chunk is fetched if needed.
+   * @return true if there are no more bytes
+   */
+  bool empty() {
+    fetch();
+    return pos_ == end_;
+  }
+
+  /** iterator pointing to the current byte
+   * @return iterator
+   */
+  iterator begin() { return iterator(this); }
+
+  /** iterator pointing to the end of the source
+   * @return iterator
+   */
+  iterator end() { return iterator(); }
+
+  /** deserialize a value
+   * @tparam target type of the value
+   * @param[out] obj address to write the value
+   * @throw buffer_overrun if the source ends in the middle of the value
+   */
+  template <typename target> void read(target *obj) {
+    read<byte_order::little>(obj);
+  }
+
+  /** deserialize a value with specified byte order
+   * @tparam order byte order of serialized data
+   * @tparam target type of the value
+   * @param[out] obj address to write the value
+   * @throw buffer_overrun if the source ends in the middle of the value
+   */
+  template <byte_order order, typename target> void read(target *obj) {
+    read<order>(obj, is_fixed_size<target>());
+  }
+
+  /** deserialize a value
+   * @tparam target type of the value
+   * @return deserialized value
+   * @throw buffer_overrun if the source ends in the middle of the value
+   */
+  template <typename target> target read() {
+    return read<byte_order::little, target>();
+  }
+
+  /** deserialize a value with specified byte order
+   * @tparam order byte order of serialized data
+   * @tparam target type of the value
+   * @return deserialized value
+   * @throw buffer_overrun if the source ends in the middle of the value
+   */
+  template <byte_order order, typename target> target read() {
+    target obj;
+    read<order>(&obj);
+    return obj;
+  }
+
+private:
+  /** deserialize a value of fixed size. if the chunk holds whole of the
+   * value, it is deserialized from the chunk directly.
+   * @tparam order byte order of serialized data
+   * @tparam target type of the value
+   * @param[out] obj address to write the value
+   */
+  template <byte_order order, typename target>
+  void read(target *obj, std::true_type) {
+    using deseri = deserializer<target, order>;
+    constexpr size_t size = deseri::size;
+    fetch();
+    if (size <= static_cast<size_t>(end_ - pos_)) {
+      pos_ = deseri::deserialize(pos_, end_, obj);
+      return;
+    }
+    stash_.resize(size);
+    gather(stash_.data(), size);
+    deseri::deserialize(stash_.data(), stash_.data() + size, obj);
+  }
+
+  /** deserialize a value of variable size. the value is deserialized from
+   * the chunk directly first, because deserializers of variable size values
+   * check the length of random access ranges. if the value continues to the
+   * next chunk, it is read again byte by byte through iterator.
+   * @tparam order byte order of serialized data
+   * @tparam target type of the value
+   * @param[out] obj address to write the value
+   */
+  template <byte_order order, typename target>
+  void read(target *obj, std::false_type) {
+    using deseri = deserializer<target, order>;
+    fetch();
+    try {
+      pos_ = deseri::deserialize(pos_, end_, obj);
+      return;
+    } catch (buffer_overrun const &) {
+    }
+    deseri::deserialize(begin(), end(), obj);
+  }
+
+  /** fetch chunks until the current chunk has bytes or the source ends */
+  void fetch() {
+    while (pos_ == end_ && !eof_) {
+      chunk const c = refill_();
+      if (c.size == 0) {
+        eof_ = true;
+      } else {
+        pos_ = c.data;
+        end_ = c.data + c.size;
+      }
+    }
+  }
+
+  /** current byte
+   * @return current byte
+   * @throw buffer_overrun if there are no more bytes
+   */
+  std::uint8_t peek() {
+    if (empty()) {
+      throw buffer_overrun();
+    }
+    return *pos_;
+  }
+
+  /** skip bytes
+   * @param[in] size byte count to skip
+   * @throw buffer_overrun if there are not enough bytes
+   */
+  void skip(size_t size) { gather(nullptr, size); }
+
+  /** copy bytes across chunks
+   * @param[out] dest address to write the bytes. nullptr to discard them.
+   * @param[in] size byte count to copy
+   * @throw buffer_overrun if there are not enough bytes
+   */
+  void gather(std::uint8_t *dest, size_t size) {
+    while (0 < size) {
+      if (empty()) {
+        throw buffer_overrun();
+      }
+      size_t const n = std::min(size, static_cast<size_t>(end_ - pos_));
+      if (dest != nullptr) {
+        std::memcpy(dest, pos_, n);
+        dest += n;
+      }
+      pos_ += n;
+      size -= n;
+    }
+  }
+
+  /** callback to get next chunk */
+  refill_type refill_;
+
+  /** current position in the chunk */
+  std::uint8_t const *pos_;
+
+  /** end of the chunk */
+  std::uint8_t const *end_;
+
+  /** true if the source ended */
+  bool eof_;
+
+  /** buffer to gather a value across chunks */
+  std::vector<std::uint8_t> stash_;
+};
+
+} // namespace loleseri
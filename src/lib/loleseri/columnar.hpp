@@ -0,0 +1,436 @@
+#pragma once
+
+#include <loleseri/loleseri.hpp>
+#include <loleseri/schema.hpp>
+
+namespace loleseri {
+
+/** template to serialize array of struct or class in columnar layout. the
+ * ix-th items of all elements are placed together ( column ), and the columns
+ * are placed in the order of items<target_type>::list(). the ix-th column
+ * starts at offset_of_item<list_type, ix>::value * count, so a column can be
+ * read without reading others.
+ * @tparam target_type type of the element
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order = byte_order::little>
+struct columnar_layout {
+  static_assert(type_category<target_type>::value == tcat::other,
+                "columnar layout is for struct or class");
+  static_assert(is_fixed_size<target_type>::value,
+                "columnar layout supports fixed size types only");
+
+  /** type to get list of items to serialize */
+  using items = loleseri::items<target_type>;
+
+  /** type of the list of items to serialize */
+  using list_type = item_list_type<target_type>;
+
+  static_assert(all_have_plain_codec<list_type>::value,
+                "columnar layout does not support items in their own "
+                "encoding");
+
+  /** type of the ix-th item
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using item_type = typename memptr_value<
+      typename std::tuple_element<ix, list_type>::type>::type;
+
+  enum {
+    /** byte count of serialized size of the element */
+    size = serializer<target_type, order>::size,
+
+    /** count of the items ( columns ) */
+    column_count = std::tuple_size<list_type>::value
+  };
+
+  /** byte offset of the ix-th column
+   * @tparam ix index of the item
+   * @param[in] count count of the elements
+   * @return byte offset
+   */
+  template <size_t ix> static constexpr size_t column_offset(size_t count) {
+    return offset_of_item<list_type, ix>::value * count;
+  }
+
+  /** indices of the items */
+  using indices = make_index_sequence<column_count>;
+
+  /** serialize the ix-th column
+   * @tparam ix index of the item
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @param[in] list items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t write_column(itor_t begin, itor_t end,
+                             target_type const *first, size_t count,
+                             list_type const &list) {
+    using item_serializer = serializer<item_type<ix>, order>;
+    auto m = std::get<ix>(list);
+    auto p = begin;
+    for (size_t i = 0; i < count; ++i) {
+      p = item_serializer::serialize(p, end, &(first[i].*m));
+    }
+    return p;
+  }
+
+  /** deserialize the ix-th column
+   * @tparam ix index of the item
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @param[in] list items
+   * @return iterator pointint to the top of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t read_column(itor_t begin, itor_t end, target_type *first,
+                            size_t count, list_type const &list) {
+    using item_deserializer = deserializer<item_type<ix>, order>;
+    auto m = std::get<ix>(list);
+    auto p = begin;
+    for (size_t i = 0; i < count; ++i) {
+      p = item_deserializer::deserialize(p, end, &(first[i].*m));
+    }
+    return p;
+  }
+
+  /** serialize columns in order. the columns are expanded in the
+   * initializer of the array, which is evaluated from left to right.
+   * @tparam itor_t type of the output iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t serialize_columns(itor_t begin, itor_t end,
+                                  target_type const *first, size_t count,
+                                  index_sequence<ix...>) {
+    auto const list = items::list();
+    int const expanded[] = {
+        0, (begin = write_column<ix>(begin, end, first, count, list), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** deserialize columns in order. the columns are expanded in the
+   * initializer of the array, which is evaluated from left to right.
+   * @tparam itor_t type of the input iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t deserialize_columns(itor_t begin, itor_t end,
+                                    target_type *first, size_t count,
+                                    index_sequence<ix...>) {
+    auto const list = items::list();
+    int const expanded[] = {
+        0, (begin = read_column<ix>(begin, end, first, count, list), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** byte count of serialized size of the elements
+   * @param[in] count count of the elements
+   * @return byte count
+   */
+  static constexpr size_t serialized_size(size_t count) {
+    return size * count;
+  }
+
+  /** serialize elements in columnar layout
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *first,
+                          size_t count) {
+    return serialize_columns(begin, end, first, count, indices());
+  }
+
+  /** deserialize elements in columnar layout
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *first,
+                            size_t count) {
+    return deserialize_columns(begin, end, first, count, indices());
+  }
+
+  /** deserialize the ix-th column only. other columns are not read. arrays
+   * of arithmetic values are copied at once.
+   * @tparam ix index of the item
+   * @tparam itor_t type of the random access input iterator
+   * @param[in] begin top of the serialized elements
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the elements
+   * @param[out] out pointer to the first value to write
+   * @return iterator pointint to the next of the column
+   * @throw buffer_overrun if the range is too short
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_column(itor_t begin, itor_t end, size_t count,
+                                   item_type<ix> *out) {
+    require_size(begin, end, serialized_size(count));
+    return sequence_deserializer<item_type<ix>, order>::deserialize(
+        begin + column_offset<ix>(count), end, out, count);
+  }
+};
+
+/** serialize elements in columnar layout
+ * @tparam target type of the element
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <typename target, typename itor>
+itor serialize_columnar(itor begin, itor end, target const *first,
+                        size_t count) {
+  return columnar_layout<target>::serialize(begin, end, first, count);
+}
+
+/** serialize elements in columnar layout with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the element
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize_columnar(itor begin, itor end, target const *first,
+                        size_t count) {
+  return columnar_layout<target, order>::serialize(begin, end, first, count);
+}
+
+/** deserialize elements in columnar layout
+ * @tparam target type of the element
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <typename target, typename itor>
+itor deserialize_columnar(itor begin, itor end, target *first, size_t count) {
+  return columnar_layout<target>::deserialize(begin, end, first, count);
+}
+
+/** deserialize elements in columnar layout with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the element
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize_columnar(itor begin, itor end, target *first, size_t count) {
+  return columnar_layout<target, order>::deserialize(begin, end, first, count);
+}
+
+/** tag type to select serializer of the array of struct in columnar layout
+ * @tparam value_type std::array or traditional array of struct or class
+ */
+template <typename value_type> struct columnar_array {};
+
+/** item of items<T>::list() which is an array of struct serialized in
+ * columnar layout. create this with columnar().
+ * @tparam value_type std::array or traditional array of struct or class
+ * @tparam owner type of struct or class
+ */
+template <typename value_type, typename owner> struct columnar_item {
+  /** pointer to the data member */
+  value_type owner::*member;
+};
+
+/** mark the data member of array of struct to be serialized in columnar
+ * layout
+ * @tparam value_type std::array or traditional array of struct or class
+ * @tparam owner type of struct or class
+ * @param[in] member pointer to the data member
+ * @return item of items<T>::list()
+ */
+template <typename value_type, typename owner>
+constexpr columnar_item<value_type, owner>
+columnar(value_type owner::*member) {
+  return columnar_item<value_type, owner>{member};
+}
+
+/** access the data member marked as columnar
+ * @param[in] obj pointer to the object
+ * @param[in] item item of items<T>::list()
+ * @return reference to the data member
+ */
+template <typename value_type, typename owner>
+value_type const &operator->*(owner const *obj,
+                              columnar_item<value_type, owner> item) {
+  return obj->*item.member;
+}
+
+/** access the data member marked as columnar
+ * @param[in] obj pointer to the object
+ * @param[in] item item of items<T>::list()
+ * @return reference to the data member
+ */
+template <typename value_type, typename owner>
+value_type &operator->*(owner *obj, columnar_item<value_type, owner> item) {
+  return obj->*item.member;
+}
+
+/** data type of the item marked as columnar */
+template <typename value, typename owner>
+struct memptr_value<columnar_item<value, owner>> {
+  /** data type */
+  using type = value;
+};
+
+/** item marked as columnar is serialized by serializer<columnar_array<...>>
+ */
+template <typename value, typename owner>
+struct item_codec<columnar_item<value, owner>> {
+  /** data type */
+  using value_type = value;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = columnar_array<value>;
+};
+
+/** size of the array in columnar layout is fixed, because columnar_layout
+ * supports elements of fixed size only */
+template <typename value_type>
+struct is_fixed_size<columnar_array<value_type>, tcat::other>
+    : public std::true_type {};
+
+/** the layout of the array is mixed into the schema hash with the mark */
+template <typename value_type>
+struct schema_of<columnar_array<value_type>, tcat::other> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return schema_of<value_type>::hash(fnv1a(h, schema_tag::columnar));
+  }
+};
+
+/** template to serialize and deserialize the array in columnar layout
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, byte_order order,
+          int typecat = type_category<value_type>::value>
+struct columnar_codec {
+  static_assert(typecat == tcat::std_array || typecat == tcat::array,
+                "columnar layout supports arrays of struct only");
+};
+
+/** template to serialize and deserialize array of struct in columnar layout
+ * @tparam value_type std::array or traditional array of struct
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, typename element_type, size_t count,
+          byte_order order>
+struct columnar_array_codec {
+  /** type to serialize and deserialize the elements */
+  using layout = columnar_layout<element_type, order>;
+
+  enum {
+    /** byte count of serialized size */
+    size = layout::size * count
+  };
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static constexpr size_t serialized_size(value_type const *obj) {
+    return size;
+  }
+
+  /** serialize obj to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *obj) {
+    return layout::serialize(begin, end, &(*obj)[0], count);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj) {
+    return layout::deserialize(begin, end, &(*obj)[0], count);
+  }
+};
+
+/** template to serialize and deserialize std::array of struct in columnar
+ * layout
+ * @tparam value_type std::array of struct
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, byte_order order>
+struct columnar_codec<value_type, order, tcat::std_array>
+    : public columnar_array_codec<value_type, typename value_type::value_type,
+                                  std::tuple_size<value_type>::value, order> {
+};
+
+/** template to serialize and deserialize traditional array of struct in
+ * columnar layout
+ * @tparam value_type traditional array of struct
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, byte_order order>
+struct columnar_codec<value_type, order, tcat::array>
+    : public columnar_array_codec<
+          value_type, typename element_type_of_array<value_type>::type,
+          std::extent<value_type>::value, order> {};
+
+} // namespace loleseri
+
+/** type to serialize array of struct in columnar layout
+ * @tparam value_type std::array or traditional array of struct
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, loleseri::byte_order order>
+struct loleseri::serializer_impl<loleseri::columnar_array<value_type>,
+                                 loleseri::tcat::other, order>
+    : public loleseri::columnar_codec<value_type, order> {};
+
+/** type to deserialize array of struct in columnar layout
+ * @tparam value_type std::array or traditional array of struct
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, loleseri::byte_order order>
+struct loleseri::deserializer_impl<loleseri::columnar_array<value_type>,
+                                   loleseri::tcat::other, order>
+    : public loleseri::columnar_codec<value_type, order> {};
@@ -0,0 +1,1138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/schema.hpp>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if defined __SSE2__
+#include <immintrin.h>
+#endif
+
+namespace loleseri {
+
+/** exception thrown if the varint in the serialized data is invalid */
+class invalid_varint : public std::runtime_error {
+public:
+  /** create exception */
+  invalid_varint() : std::runtime_error("loleseri: invalid varint") {}
+};
+
+/** values to specify the compact encoding */
+namespace compact_encoding {
+
+/** integers are written as varint ( LEB128 ) */
+constexpr int varint = 0;
+
+/** signed integers are zigzag encoded and written as varint */
+constexpr int zigzag = 1;
+
+/** differences from the previous elements are zigzag encoded */
+constexpr int delta = 2;
+
+/** differences of the differences are zigzag encoded */
+constexpr int delta_of_delta = 3;
+
+} // namespace compact_encoding
+
+/** tag type to select serializer of the value in compact encoding
+ * @tparam value_type integer type, or std::array, traditional array or
+ * std::vector of integers
+ * @tparam encoding value in compact_encoding
+ */
+template <typename value_type, int encoding> struct compact {};
+
+/** item of items<T>::list() which is serialized in compact encoding.
+ * create this with varint(), zigzag(), delta() or delta_of_delta().
+ * @tparam value_type type of the data member
+ * @tparam owner type of struct or class
+ * @tparam encoding value in compact_encoding
+ */
+template <typename value_type, typename owner, int encoding>
+struct compact_item {
+  /** pointer to the data member */
+  value_type owner::*member;
+};
+
+/** mark the data member to be serialized as varint ( LEB128 ).
+ * arrays and std::vector of integers are serialized in stream-VByte format.
+ * @tparam value_type type of the data member
+ * @tparam owner type of struct or class
+ * @param[in] member pointer to the data member
+ * @return item of items<T>::list()
+ */
+template <typename value_type, typename owner>
+constexpr compact_item<value_type, owner, compact_encoding::varint>
+varint(value_type owner::*member) {
+  return compact_item<value_type, owner, compact_encoding::varint>{member};
+}
+
+/** mark the data member of signed integers to be serialized as zigzag
+ * encoded varint. small negative values become short.
+ * @tparam value_type type of the data member
+ * @tparam owner type of struct or class
+ * @param[in] member pointer to the data member
+ * @return item of items<T>::list()
+ */
+template <typename value_type, typename owner>
+constexpr compact_item<value_type, owner, compact_encoding::zigzag>
+zigzag(value_type owner::*member) {
+  return compact_item<value_type, owner, compact_encoding::zigzag>{member};
+}
+
+/** mark the data member of array or std::vector of integers to be serialized
+ * as differences from the previous elements. suitable for monotonic values
+ * like sequence numbers.
+ * @tparam value_type type of the data member
+ * @tparam owner type of struct or class
+ * @param[in] member pointer to the data member
+ * @return item of items<T>::list()
+ */
+template <typename value_type, typename owner>
+constexpr compact_item<value_type, owner, compact_encoding::delta>
+delta(value_type owner::*member) {
+  return compact_item<value_type, owner, compact_encoding::delta>{member};
+}
+
+/** mark the data member of array or std::vector of integers to be serialized
+ * as differences of the differences. suitable for values which grow at
+ * almost constant rate like timestamps.
+ * @tparam value_type type of the data member
+ * @tparam owner type of struct or class
+ * @param[in] member pointer to the data member
+ * @return item of items<T>::list()
+ */
+template <typename value_type, typename owner>
+constexpr compact_item<value_type, owner, compact_encoding::delta_of_delta>
+delta_of_delta(value_type owner::*member) {
+  return compact_item<value_type, owner, compact_encoding::delta_of_delta>{
+      member};
+}
+
+/** access the data member marked as compact
+ * @param[in] obj pointer to the object
+ * @param[in] item item of items<T>::list()
+ * @return reference to the data member
+ */
+template <typename value_type, typename owner, int encoding>
+value_type const &operator->*(owner const *obj,
+                              compact_item<value_type, owner, encoding> item) {
+  return obj->*item.member;
+}
+
+/** access the data member marked as compact
+ * @param[in] obj pointer to the object
+ * @param[in] item item of items<T>::list()
+ * @return reference to the data member
+ */
+template <typename value_type, typename owner, int encoding>
+value_type &operator->*(owner *obj,
+                        compact_item<value_type, owner, encoding> item) {
+  return obj->*item.member;
+}
+
+/** data type of the item marked as compact */
+template <typename value, typename owner, int encoding>
+struct memptr_value<compact_item<value, owner, encoding>> {
+  /** data type */
+  using type = value;
+};
+
+/** item marked as compact is serialized by serializer<compact<...>> */
+template <typename value, typename owner, int encoding>
+struct item_codec<compact_item<value, owner, encoding>> {
+  /** data type */
+  using value_type = value;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = compact<value, encoding>;
+};
+
+/** size of the value in compact encoding is not fixed */
+template <typename value_type, int encoding>
+struct is_fixed_size<compact<value_type, encoding>, tcat::other>
+    : public std::false_type {};
+
+/** the encoding and the layout of the value are mixed into the schema hash */
+template <typename value_type, int encoding>
+struct schema_of<compact<value_type, encoding>, tcat::other> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return schema_of<value_type>::hash(
+        fnv1a(fnv1a(h, schema_tag::compact), encoding));
+  }
+};
+
+/** template to convert integers to and from unsigned values in varint
+ * @tparam value_type integer type
+ * @tparam zigzag true if the signed integers are zigzag encoded
+ */
+template <typename value_type, bool zigzag> struct compact_integer {
+  static_assert(std::is_integral<value_type>::value &&
+                    !std::is_same<value_type, bool>::value,
+                "compact encoding supports integers only");
+  static_assert(!zigzag || std::is_signed<value_type>::value,
+                "zigzag encoding supports signed integers only");
+
+  /** unsigned integer type of the same size */
+  using unsigned_type = typename std::make_unsigned<value_type>::type;
+
+  /** convert the value to the unsigned value to write
+   * @param[in] v value to convert
+   * @return unsigned value
+   */
+  static std::uint64_t encode(value_type v) {
+    return encode(v, std::integral_constant<bool, zigzag>());
+  }
+
+  /** convert the unsigned value to the value
+   * @param[in] w unsigned value which is read
+   * @return value
+   * @throw invalid_varint if w is too large for value_type
+   */
+  static value_type decode(std::uint64_t w) {
+    if (std::numeric_limits<unsigned_type>::max() < w) {
+      throw invalid_varint();
+    }
+    return decode(static_cast<unsigned_type>(w),
+                  std::integral_constant<bool, zigzag>());
+  }
+
+  /** convert the value to the unsigned value without zigzag encoding
+   * @param[in] v value to convert
+   * @return unsigned value
+   */
+  static std::uint64_t encode(value_type v, std::false_type) {
+    return static_cast<unsigned_type>(v);
+  }
+
+  /** convert the value to the unsigned value with zigzag encoding
+   * @param[in] v value to convert
+   * @return unsigned value
+   */
+  static std::uint64_t encode(value_type v, std::true_type) {
+    auto const u = static_cast<unsigned_type>(v);
+    auto const sign = static_cast<unsigned_type>(
+        v < 0 ? std::numeric_limits<unsigned_type>::max() : 0u);
+    return static_cast<unsigned_type>(static_cast<unsigned_type>(u << 1) ^
+                                      sign);
+  }
+
+  /** convert the unsigned value to the value without zigzag encoding
+   * @param[in] u unsigned value which is read
+   * @return value
+   */
+  static value_type decode(unsigned_type u, std::false_type) {
+    return static_cast<value_type>(u);
+  }
+
+  /** convert the unsigned value to the value with zigzag encoding
+   * @param[in] u unsigned value which is read
+   * @return value
+   */
+  static value_type decode(unsigned_type u, std::true_type) {
+    return static_cast<value_type>(static_cast<unsigned_type>(
+        (u >> 1) ^ (unsigned_type(0) - (u & 1u))));
+  }
+};
+
+/** byte count of the value of the code in stream-VByte format.
+ * codes of 8 bytes integers mean 1, 2, 4 and 8 bytes, and codes of others
+ * mean 1, 2, 3 and 4 bytes.
+ * @tparam unit byte count of the integer
+ * @param[in] code 2 bits code in the control byte
+ * @return byte count
+ */
+template <size_t unit> constexpr size_t stream_vbyte_length(unsigned code) {
+  return unit == 8 ? size_t(1) << code : code + 1u;
+}
+
+#if defined __SSSE3__ || defined __AVX2__
+/** shuffle masks to expand the data bytes in stream-VByte format to 16 bytes
+ * at once. indexed by the control bits of 16 bytes of integers.
+ * @tparam unit byte count of the integer ( 4 or 8 )
+ */
+template <size_t unit> struct stream_vbyte_table {
+  enum {
+    /** count of the integers in 16 bytes */
+    values = 16 / unit,
+
+    /** count of the patterns of the control bits */
+    entries = 1 << (2 * values)
+  };
+
+  /** shuffle masks */
+  std::uint8_t shuffle[entries][16];
+
+  /** byte count of the data bytes */
+  std::uint8_t length[entries];
+
+  /** build the table */
+  stream_vbyte_table() {
+    for (unsigned c = 0; c < entries; ++c) {
+      size_t pos = 0;
+      for (unsigned k = 0; k < values; ++k) {
+        size_t const len = stream_vbyte_length<unit>((c >> (2 * k)) & 3u);
+        for (size_t b = 0; b < unit; ++b) {
+          shuffle[c][k * unit + b] =
+              static_cast<std::uint8_t>(b < len ? pos + b : 0x80u);
+        }
+        pos += len;
+      }
+      length[c] = static_cast<std::uint8_t>(pos);
+    }
+  }
+
+  /** the table built at first use
+   * @return the table
+   */
+  static stream_vbyte_table const &get() {
+    static stream_vbyte_table const table;
+    return table;
+  }
+};
+#endif
+
+/** template to serialize and deserialize integers in stream-VByte format.
+ * control bytes come first and hold 2 bits code of the byte count for each
+ * integer, and the integers follow in little endian with the byte count.
+ * on contiguous bytes, 16 bytes of integers are decoded at once with SSSE3
+ * shuffle if available.
+ * @tparam element_type integer type
+ * @tparam zigzag true if the signed integers are zigzag encoded
+ */
+template <typename element_type, bool zigzag> struct stream_vbyte {
+  /** type to convert the integers */
+  using integer = compact_integer<element_type, zigzag>;
+
+  enum {
+    /** byte count of the integer */
+    unit = sizeof(element_type)
+  };
+
+  /** byte count of the control bytes
+   * @param[in] count count of the integers
+   * @return byte count
+   */
+  static constexpr size_t control_size(size_t count) { return (count + 3) / 4; }
+
+  /** code of the byte count to write the unsigned value
+   * @param[in] w unsigned value
+   * @return 2 bits code
+   */
+  static unsigned code_of(std::uint64_t w) {
+#if __clang__ || __GNUC__
+    auto const bits = 64u - static_cast<unsigned>(__builtin_clzll(w | 1u));
+    auto const n = std::min<unsigned>((bits + 7) / 8, unit);
+#else
+    unsigned n = 1;
+    while (n < unit && (w >> (8 * n)) != 0) {
+      ++n;
+    }
+#endif
+    if (unit != 8) {
+      return n - 1;
+    }
+    return n <= 1 ? 0 : n <= 2 ? 1 : n <= 4 ? 2 : 3;
+  }
+
+  /** function object to get the unsigned values to write of integers */
+  struct words {
+    /** pointer to the first integer */
+    element_type const *first;
+
+    /** the unsigned value to write
+     * @param[in] i index of the integer
+     * @return unsigned value
+     */
+    std::uint64_t operator()(size_t i) const {
+      return integer::encode(first[i]);
+    }
+  };
+
+  /** byte count of serialized integers
+   * @param[in] first pointer to the first integer
+   * @param[in] count count of the integers
+   * @return byte count
+   */
+  static size_t serialized_size(element_type const *first, size_t count) {
+    return encoded_size(words{first}, count);
+  }
+
+  /** serialize integers to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first integer
+   * @param[in] count count of the integers
+   * @return iterator which points to the begin of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, element_type const *first,
+                          size_t count) {
+    return encode(begin, end, words{first}, count);
+  }
+
+  /** byte count of the unsigned values in stream-VByte format
+   * @tparam word_t type of the function object to get the unsigned values
+   * @param[in] word function object to get the i-th unsigned value
+   * @param[in] count count of the values
+   * @return byte count
+   */
+  template <typename word_t>
+  static size_t encoded_size(word_t word, size_t count) {
+    size_t size = control_size(count);
+    for (size_t i = 0; i < count; ++i) {
+      size += stream_vbyte_length<unit>(code_of(word(i)));
+    }
+    return size;
+  }
+
+  /** write the unsigned values in stream-VByte format
+   * @tparam itor_t type of the output iterator
+   * @tparam word_t type of the function object to get the unsigned values
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] word function object to get the i-th unsigned value
+   * @param[in] count count of the values
+   * @return iterator which points to the begin of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t, typename word_t>
+  static itor_t encode(itor_t begin, itor_t end, word_t word, size_t count) {
+    using contiguous = std::integral_constant<
+        bool, is_contiguous_byte_iterator<itor_t>::value>;
+    return encode(begin, end, word, count, contiguous());
+  }
+
+  /** write the unsigned values to contiguous bytes in one pass. the control
+   * bytes and the data bytes are written together.
+   * @tparam itor_t type of the output iterator
+   * @tparam word_t type of the function object to get the unsigned values
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] word function object to get the i-th unsigned value
+   * @param[in] count count of the values
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, typename word_t>
+  static itor_t encode(itor_t begin, itor_t end, word_t word, size_t count,
+                       std::true_type) {
+    size_t const size = encoded_size(word, count);
+    require_size(begin, end, size);
+    if (count == 0) {
+      return begin;
+    }
+    auto const top = reinterpret_cast<std::uint8_t *>(std::addressof(*begin));
+    auto const last = top + size;
+    auto const ctrl = top;
+    auto data = top + control_size(count);
+    std::memset(ctrl, 0, control_size(count));
+    for (size_t i = 0; i < count; ++i) {
+      auto const w = word(i);
+      unsigned const code = code_of(w);
+      ctrl[i / 4] = static_cast<std::uint8_t>(ctrl[i / 4] |
+                                              (code << (2 * (i % 4))));
+      auto const len = stream_vbyte_length<unit>(code);
+#if LOLESERI_LITTLE_ENDIAN
+      if (sizeof(w) <= static_cast<size_t>(last - data)) {
+        // write 8 bytes at once. extra bytes are overwritten by the next.
+        std::memcpy(data, &w, sizeof(w));
+        data += len;
+        continue;
+      }
+#endif
+      for (size_t b = 0; b < len; ++b) {
+        *data++ = static_cast<std::uint8_t>(w >> (8 * b));
+      }
+    }
+    return begin + size;
+  }
+
+  /** write the unsigned values to output iterator byte by byte. the control
+   * bytes are written first.
+   * @tparam itor_t type of the output iterator
+   * @tparam word_t type of the function object to get the unsigned values
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] word function object to get the i-th unsigned value
+   * @param[in] count count of the values
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, typename word_t>
+  static itor_t encode(itor_t begin, itor_t end, word_t word, size_t count,
+                       std::false_type) {
+    require_size(begin, end, encoded_size(word, count));
+    for (size_t i = 0; i < count; i += 4) {
+      unsigned c = 0;
+      for (size_t k = 0; k < 4 && i + k < count; ++k) {
+        c |= code_of(word(i + k)) << (2 * k);
+      }
+      *begin = static_cast<std::uint8_t>(c);
+      ++begin;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      auto const w = word(i);
+      auto const len = stream_vbyte_length<unit>(code_of(w));
+      for (size_t b = 0; b < len; ++b) {
+        *begin = static_cast<std::uint8_t>(w >> (8 * b));
+        ++begin;
+      }
+    }
+    return begin;
+  }
+
+  /** deserialize integers from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first address to write the first integer
+   * @param[in] count count of the integers
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   * @throw invalid_varint if the code is invalid for element_type
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, element_type *first,
+                            size_t count) {
+    using contiguous = std::integral_constant<
+        bool, is_contiguous_byte_iterator<itor_t>::value>;
+    return deserialize(begin, end, first, count, contiguous());
+  }
+
+  /** deserialize integers from contiguous bytes
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first address to write the first integer
+   * @param[in] count count of the integers
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, element_type *first,
+                            size_t count, std::true_type) {
+    size_t const ctrl_size = control_size(count);
+    require_size(begin, end, ctrl_size);
+    if (count == 0) {
+      return begin;
+    }
+    auto const top =
+        reinterpret_cast<std::uint8_t const *>(std::addressof(*begin));
+    auto const last = top + (end - begin);
+    auto const ctrl = top;
+    auto data = top + ctrl_size;
+    size_t i = decode_block(ctrl, data, last, first, count);
+    for (; i < count; ++i) {
+      unsigned const code = (ctrl[i / 4] >> (2 * (i % 4))) & 3u;
+      first[i] = read_value(data, last, code);
+    }
+    return begin + (data - top);
+  }
+
+  /** deserialize integers from input iterator byte by byte
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first address to write the first integer
+   * @param[in] count count of the integers
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, element_type *first,
+                            size_t count, std::false_type) {
+    std::vector<std::uint8_t> ctrl(control_size(count));
+    for (auto &c : ctrl) {
+      if (begin == end) {
+        throw buffer_overrun();
+      }
+      c = static_cast<std::uint8_t>(*begin);
+      ++begin;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      unsigned const code = (ctrl[i / 4] >> (2 * (i % 4))) & 3u;
+      first[i] = read_value(begin, end, code);
+    }
+    return begin;
+  }
+
+  /** read an integer of the code
+   * @tparam itor_t type of the input iterator
+   * @param[in,out] begin top of the input iterator. moved to the next.
+   * @param[in] end end of the input iterator
+   * @param[in] code 2 bits code of the byte count
+   * @return integer
+   */
+  template <typename itor_t>
+  static element_type read_value(itor_t &begin, itor_t end, unsigned code) {
+    size_t const len = stream_vbyte_length<unit>(code);
+    if (unit < len) {
+      throw invalid_varint();
+    }
+    std::uint64_t w = 0;
+    for (size_t b = 0; b < len; ++b) {
+      if (begin == end) {
+        throw buffer_overrun();
+      }
+      w |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(*begin))
+           << (8 * b);
+      ++begin;
+    }
+    return integer::decode(w);
+  }
+
+  /** decode integers 16 bytes at once while the data has 16 bytes at least
+   * @param[in] ctrl top of the control bytes
+   * @param[in,out] data top of the data bytes. moved to the next.
+   * @param[in] last end of the bytes
+   * @param[out] first address to write the first integer
+   * @param[in] count count of the integers
+   * @return count of the decoded integers
+   */
+  static size_t decode_block(std::uint8_t const *ctrl,
+                             std::uint8_t const *&data,
+                             std::uint8_t const *last, element_type *first,
+                             size_t count) {
+    return decode_block(ctrl, data, last, first, count,
+                        std::integral_constant<size_t, unit>());
+  }
+
+  /** decode nothing at once ( no SIMD kernel for the integer size )
+   * @return 0
+   */
+  template <typename unit_t>
+  static size_t decode_block(std::uint8_t const *ctrl,
+                             std::uint8_t const *&data,
+                             std::uint8_t const *last, element_type *first,
+                             size_t count, unit_t) {
+    return 0;
+  }
+
+#if defined __SSSE3__ || defined __AVX2__
+  /** undo zigzag encoding of 32bit integers
+   * @param[in] v encoded integers
+   * @return integers
+   */
+  static __m128i unzigzag(__m128i v, std::integral_constant<size_t, 4>) {
+    return _mm_xor_si128(
+        _mm_srli_epi32(v, 1),
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      _mm_and_si128(v, _mm_set1_epi32(1))));
+  }
+
+  /** undo zigzag encoding of 64bit integers
+   * @param[in] v encoded integers
+   * @return integers
+   */
+  static __m128i unzigzag(__m128i v, std::integral_constant<size_t, 8>) {
+    return _mm_xor_si128(
+        _mm_srli_epi64(v, 1),
+        _mm_sub_epi64(_mm_setzero_si128(),
+                      _mm_and_si128(v, _mm_set1_epi64x(1))));
+  }
+
+  /** decode 32bit or 64bit integers 16 bytes at once with SSSE3 shuffle
+   * @param[in] ctrl top of the control bytes
+   * @param[in,out] data top of the data bytes. moved to the next.
+   * @param[in] last end of the bytes
+   * @param[out] first address to write the first integer
+   * @param[in] count count of the integers
+   * @param[in] u byte count of the integer
+   * @return count of the decoded integers
+   */
+  template <size_t unit_size>
+  static typename std::enable_if<unit_size == 4 || unit_size == 8,
+                                 size_t>::type
+  decode_block(std::uint8_t const *ctrl, std::uint8_t const *&data,
+               std::uint8_t const *last, element_type *first, size_t count,
+               std::integral_constant<size_t, unit_size> u) {
+    using table_type = stream_vbyte_table<unit_size>;
+    constexpr size_t values = table_type::values;
+    auto const &table = table_type::get();
+    size_t i = 0;
+    for (; i + values <= count && 16 <= last - data; i += values) {
+      unsigned const c =
+          (ctrl[i / 4] >> (2 * (i % 4))) & (table_type::entries - 1u);
+      auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+      auto const mask = _mm_loadu_si128(
+          reinterpret_cast<__m128i const *>(table.shuffle[c]));
+      v = _mm_shuffle_epi8(v, mask);
+      if (zigzag) {
+        v = unzigzag(v, u);
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(first + i), v);
+      data += table.length[c];
+    }
+    return i;
+  }
+#endif
+};
+
+/** sum nothing at once ( no SIMD kernel for the integer size )
+ * @return 0
+ */
+template <typename unsigned_type, typename unit_t>
+size_t prefix_sum_block(unsigned_type *first, size_t count, unit_t) {
+  return 0;
+}
+
+#if defined __SSE2__
+/** sum 32bit integers 4 at once. each vector is scanned with two shifted
+ * additions and the last sum of the previous vector is added.
+ * @param[in,out] first pointer to the first integer
+ * @param[in] count count of the integers
+ * @return count of the summed integers
+ */
+template <typename unsigned_type>
+size_t prefix_sum_block(unsigned_type *first, size_t count,
+                        std::integral_constant<size_t, 4>) {
+  auto carry = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    auto p = reinterpret_cast<__m128i *>(first + i);
+    auto v = _mm_loadu_si128(p);
+    v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+    v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+    v = _mm_add_epi32(v, carry);
+    _mm_storeu_si128(p, v);
+    carry = _mm_shuffle_epi32(v, 0xff);
+  }
+  return i;
+}
+
+/** sum 64bit integers 2 at once
+ * @param[in,out] first pointer to the first integer
+ * @param[in] count count of the integers
+ * @return count of the summed integers
+ */
+template <typename unsigned_type>
+size_t prefix_sum_block(unsigned_type *first, size_t count,
+                        std::integral_constant<size_t, 8>) {
+  auto carry = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    auto p = reinterpret_cast<__m128i *>(first + i);
+    auto v = _mm_loadu_si128(p);
+    v = _mm_add_epi64(v, _mm_slli_si128(v, 8));
+    v = _mm_add_epi64(v, carry);
+    _mm_storeu_si128(p, v);
+    carry = _mm_shuffle_epi32(v, 0xee);
+  }
+  return i;
+}
+#endif
+
+/** replace integers with the running sums of them in place.
+ * 32bit and 64bit integers are summed 16 bytes at once with SSE2 if
+ * available.
+ * @tparam unsigned_type unsigned integer type
+ * @param[in,out] first pointer to the first integer
+ * @param[in] count count of the integers
+ */
+template <typename unsigned_type>
+void prefix_sum(unsigned_type *first, size_t count) {
+  size_t i = prefix_sum_block(
+      first, count, std::integral_constant<size_t, sizeof(unsigned_type)>());
+  for (i = std::max<size_t>(i, 1); i < count; ++i) {
+    first[i] = static_cast<unsigned_type>(first[i] + first[i - 1]);
+  }
+}
+
+/** template to serialize and deserialize integers as the level-th
+ * differences in stream-VByte format. the differences are zigzag encoded,
+ * so the integers need not be monotonic.
+ * @tparam element_type integer type
+ * @tparam level 1 for the differences, 2 for the differences of them
+ */
+template <typename element_type, int level> struct delta_block {
+  /** unsigned integer type to calculate differences with wraparound */
+  using unsigned_type = typename std::make_unsigned<element_type>::type;
+
+  /** signed integer type of the differences */
+  using signed_type = typename std::make_signed<element_type>::type;
+
+  /** type to serialize and deserialize the differences */
+  using block = stream_vbyte<signed_type, true>;
+
+  /** function object to get the unsigned values to write of the differences
+   */
+  struct words {
+    /** pointer to the first integer */
+    element_type const *first;
+
+    /** the i-th integer ( 0-th difference )
+     * @param[in] i index of the integer
+     * @return integer
+     */
+    unsigned_type difference(size_t i, std::integral_constant<int, 0>) const {
+      return static_cast<unsigned_type>(first[i]);
+    }
+
+    /** the d-th difference of the i-th integer
+     * @tparam d level of the difference
+     * @param[in] i index of the integer
+     * @return difference
+     */
+    template <int d>
+    unsigned_type difference(size_t i, std::integral_constant<int, d>) const {
+      using lower = std::integral_constant<int, d - 1>;
+      unsigned_type const prev = i == 0 ? 0 : difference(i - 1, lower());
+      return static_cast<unsigned_type>(difference(i, lower()) - prev);
+    }
+
+    /** the unsigned value to write
+     * @param[in] i index of the integer
+     * @return unsigned value
+     */
+    std::uint64_t operator()(size_t i) const {
+      return compact_integer<signed_type, true>::encode(
+          static_cast<signed_type>(
+              difference(i, std::integral_constant<int, level>())));
+    }
+  };
+
+  /** byte count of the control bytes
+   * @param[in] count count of the integers
+   * @return byte count
+   */
+  static constexpr size_t control_size(size_t count) {
+    return block::control_size(count);
+  }
+
+  /** byte count of serialized integers
+   * @param[in] first pointer to the first integer
+   * @param[in] count count of the integers
+   * @return byte count
+   */
+  static size_t serialized_size(element_type const *first, size_t count) {
+    return block::encoded_size(words{first}, count);
+  }
+
+  /** serialize integers to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first integer
+   * @param[in] count count of the integers
+   * @return iterator which points to the begin of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, element_type const *first,
+                          size_t count) {
+    return block::encode(begin, end, words{first}, count);
+  }
+
+  /** deserialize integers from input iterator. the differences are decoded
+   * into the destination and summed up level times.
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first address to write the first integer
+   * @param[in] count count of the integers
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   * @throw invalid_varint if the code is invalid for element_type
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, element_type *first,
+                            size_t count) {
+    auto p = block::deserialize(begin, end,
+                                reinterpret_cast<signed_type *>(first), count);
+    for (int d = 0; d < level; ++d) {
+      prefix_sum(reinterpret_cast<unsigned_type *>(first), count);
+    }
+    return p;
+  }
+};
+
+/** template to get the type to serialize and deserialize the elements of
+ * arrays in compact encoding
+ * @tparam element_type integer type
+ * @tparam encoding value in compact_encoding
+ */
+template <typename element_type, int encoding> struct compact_block {
+  /** type to serialize and deserialize the elements */
+  using type = stream_vbyte<element_type,
+                            encoding == compact_encoding::zigzag>;
+};
+
+/** elements in delta encoding */
+template <typename element_type>
+struct compact_block<element_type, compact_encoding::delta> {
+  /** type to serialize and deserialize the elements */
+  using type = delta_block<element_type, 1>;
+};
+
+/** elements in delta of delta encoding */
+template <typename element_type>
+struct compact_block<element_type, compact_encoding::delta_of_delta> {
+  /** type to serialize and deserialize the elements */
+  using type = delta_block<element_type, 2>;
+};
+
+/** template to serialize and deserialize the value in compact encoding
+ * @tparam value_type type of the value
+ * @tparam encoding value in compact_encoding
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, int encoding,
+          int typecat = type_category<value_type>::value>
+struct compact_codec {
+  static_assert(typecat == tcat::arithmetic || typecat == tcat::std_array ||
+                    typecat == tcat::array || typecat == tcat::vector,
+                "compact encoding supports integers, arrays and std::vector "
+                "of integers only");
+};
+
+/** template to serialize and deserialize an integer as varint ( LEB128 )
+ * @tparam value_type integer type
+ * @tparam encoding value in compact_encoding
+ */
+template <typename value_type, int encoding>
+struct compact_codec<value_type, encoding, tcat::arithmetic> {
+  static_assert(encoding == compact_encoding::varint ||
+                    encoding == compact_encoding::zigzag,
+                "delta encoding supports arrays and std::vector only");
+
+  /** type to convert the integer */
+  using integer =
+      compact_integer<value_type, encoding == compact_encoding::zigzag>;
+
+  /** byte count of the varint of the unsigned value
+   * @param[in] w unsigned value
+   * @return byte count
+   */
+  static size_t varint_size(std::uint64_t w) {
+    size_t n = 1;
+    for (; 0x80u <= w; w >>= 7) {
+      ++n;
+    }
+    return n;
+  }
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(value_type const *obj) {
+    return varint_size(integer::encode(*obj));
+  }
+
+  /** serialize obj to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *obj) {
+    auto w = integer::encode(*obj);
+    require_size(begin, end, varint_size(w));
+    for (; 0x80u <= w; w >>= 7) {
+      *begin = static_cast<std::uint8_t>(w | 0x80u);
+      ++begin;
+    }
+    *begin = static_cast<std::uint8_t>(w);
+    return ++begin;
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   * @throw invalid_varint if the varint is too long for value_type
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj) {
+    std::uint64_t w = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      if (begin == end) {
+        throw buffer_overrun();
+      }
+      auto const b = static_cast<std::uint8_t>(*begin);
+      ++begin;
+      std::uint64_t const bits = b & 0x7fu;
+      if (57 < shift && (bits >> (64 - shift)) != 0) {
+        throw invalid_varint();
+      }
+      w |= bits << shift;
+      if ((b & 0x80u) == 0) {
+        break;
+      }
+      if (57 < shift) {
+        throw invalid_varint();
+      }
+    }
+    *obj = integer::decode(w);
+    return begin;
+  }
+};
+
+/** template to serialize and deserialize array of integers in stream-VByte
+ * format
+ * @tparam value_type std::array or traditional array of integers
+ * @tparam encoding value in compact_encoding
+ * @tparam element_type integer type of the element
+ * @tparam count count of the elements
+ */
+template <typename value_type, int encoding, typename element_type,
+          size_t count>
+struct compact_array_codec {
+  /** type to serialize and deserialize the elements */
+  using block = typename compact_block<element_type, encoding>::type;
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(value_type const *obj) {
+    return block::serialized_size(&(*obj)[0], count);
+  }
+
+  /** serialize obj to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *obj) {
+    return block::serialize(begin, end, &(*obj)[0], count);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj) {
+    return block::deserialize(begin, end, &(*obj)[0], count);
+  }
+};
+
+/** template to serialize and deserialize std::array of integers
+ * @tparam value_type std::array of integers
+ * @tparam encoding value in compact_encoding
+ */
+template <typename value_type, int encoding>
+struct compact_codec<value_type, encoding, tcat::std_array>
+    : public compact_array_codec<value_type, encoding,
+                                 typename value_type::value_type,
+                                 std::tuple_size<value_type>::value> {};
+
+/** template to serialize and deserialize traditional array of integers
+ * @tparam value_type traditional array of integers
+ * @tparam encoding value in compact_encoding
+ */
+template <typename value_type, int encoding>
+struct compact_codec<value_type, encoding, tcat::array>
+    : public compact_array_codec<
+          value_type, encoding,
+          typename element_type_of_array<value_type>::type,
+          std::extent<value_type>::value> {};
+
+/** template to serialize and deserialize std::vector of integers.
+ * the length is written first in the same way as usual std::vector.
+ * @tparam value_type std::vector of integers
+ * @tparam encoding value in compact_encoding
+ */
+template <typename value_type, int encoding>
+struct compact_codec<value_type, encoding, tcat::vector> {
+  /** type to serialize and deserialize the elements */
+  using block =
+      typename compact_block<typename value_type::value_type, encoding>::type;
+
+  /** type to serialize the length */
+  using length_serializer = serializer<length_type>;
+
+  /** type to deserialize the length */
+  using length_deserializer = deserializer<length_type>;
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   * @throw std::length_error if obj has too many elements
+   */
+  static size_t serialized_size(value_type const *obj) {
+    length_of(obj->size());
+    return length_serializer::size +
+           block::serialized_size(obj->data(), obj->size());
+  }
+
+  /** serialize obj to output iterator. the length is written first.
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   * @throw std::length_error if obj has too many elements
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *obj) {
+    require_size(begin, end, serialized_size(obj));
+    auto const length = length_of(obj->size());
+    auto p = length_serializer::serialize(begin, end, &length);
+    return block::serialize(p, end, obj->data(), obj->size());
+  }
+
+  /** deserialize obj from input iterator. the length is checked against the
+   * range before the vector is resized.
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj) {
+    require_size(begin, end, length_deserializer::size);
+    length_type length;
+    auto p = length_deserializer::deserialize(begin, end, &length);
+    require_size(p, end, block::control_size(length) + length);
+    obj->resize(length);
+    return block::deserialize(p, end, obj->data(), length);
+  }
+};
+
+} // namespace loleseri
+
+/** type to serialize the value in compact encoding. varints are always
+ * written in little endian regardless of the byte order.
+ * @tparam value_type type of the value to serialize
+ * @tparam encoding value in compact_encoding
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, int encoding, loleseri::byte_order order>
+struct loleseri::serializer_impl<loleseri::compact<value_type, encoding>,
+                                 loleseri::tcat::other, order>
+    : public loleseri::compact_codec<value_type, encoding> {};
+
+/** type to deserialize the value in compact encoding. varints are always
+ * read in little endian regardless of the byte order.
+ * @tparam value_type type of the value to deserialize
+ * @tparam encoding value in compact_encoding
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, int encoding, loleseri::byte_order order>
+struct loleseri::deserializer_impl<loleseri::compact<value_type, encoding>,
+                                   loleseri::tcat::other, order>
+    : public loleseri::compact_codec<value_type, encoding> {};
@@ -0,0 +1,641 @@
+#pragma once
+
+#if __cplusplus < 201402L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#error "loleseri/compile_time.hpp requires C++14 or later"
+#endif
+
+#include <limits>
+#include <loleseri/loleseri.hpp>
+#include <utility>
+
+#if 202002L <= __cplusplus && defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+#if defined(__cpp_lib_bit_cast)
+#define LOLESERI_BIT_CAST(to, from) std::bit_cast<to>(from)
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define LOLESERI_BIT_CAST(to, from) __builtin_bit_cast(to, from)
+#endif
+#endif
+
+namespace loleseri {
+
+/** template to get unsigned integer type of the size
+ * @tparam size byte count
+ */
+template <size_t size> struct unsigned_of_size;
+
+/** 1 byte unsigned integer */
+template <> struct unsigned_of_size<1> { using type = std::uint8_t; };
+
+/** 2 bytes unsigned integer */
+template <> struct unsigned_of_size<2> { using type = std::uint16_t; };
+
+/** 4 bytes unsigned integer */
+template <> struct unsigned_of_size<4> { using type = std::uint32_t; };
+
+/** 8 bytes unsigned integer */
+template <> struct unsigned_of_size<8> { using type = std::uint64_t; };
+
+/** IEEE 754 encoding of floating point values with arithmetic only. used in
+ * constant expressions if bit_cast is not available. -0.0 is encoded as 0.0
+ * because the sign of zero cannot be checked without bit_cast, and all NaNs
+ * are encoded as the quiet NaN.
+ * @tparam float_type float or double
+ */
+template <typename float_type> struct ieee754 {
+  /** limits of the type */
+  using limits = std::numeric_limits<float_type>;
+
+  static_assert(limits::is_iec559 &&
+                    (sizeof(float_type) == 4 || sizeof(float_type) == 8),
+                "constexpr codec without bit_cast supports only IEEE 754 "
+                "float and double");
+
+  /** unsigned integer type which has the same size */
+  using bits_type = typename unsigned_of_size<sizeof(float_type)>::type;
+
+  enum {
+    /** bit count of the mantissa without the hidden bit */
+    mantissa_bits = limits::digits - 1,
+
+    /** exponent of 1.0 in the biased exponent */
+    bias = limits::max_exponent - 1,
+
+    /** the biased exponent of infinity and NaN */
+    max_biased = 2 * bias + 1
+  };
+
+  /** multiply by the power of 2. exact if the result is representable.
+   * @param[in] v value
+   * @param[in] e exponent of 2
+   * @return v * 2^e
+   */
+  static constexpr float_type scale(float_type v, int e) {
+    for (; 0 < e; --e) {
+      v *= 2;
+    }
+    for (; e < 0; ++e) {
+      v /= 2;
+    }
+    return v;
+  }
+
+  /** bits of the value
+   * @param[in] v value
+   * @return bits of v
+   */
+  static constexpr bits_type encode(float_type v) {
+    constexpr bits_type one = 1;
+    if (v != v) {
+      return static_cast<bits_type>(
+          (static_cast<bits_type>(max_biased) << mantissa_bits) |
+          (one << (mantissa_bits - 1)));
+    }
+    bits_type const sign =
+        v < 0 ? static_cast<bits_type>(one << (8 * sizeof(float_type) - 1))
+              : 0;
+    float_type a = v < 0 ? -v : v;
+    if (limits::max() < a) {
+      return static_cast<bits_type>(
+          sign | (static_cast<bits_type>(max_biased) << mantissa_bits));
+    }
+    if (a == 0) {
+      return sign;
+    }
+    int e = 0;
+    for (; 2 <= a; ++e) {
+      a /= 2;
+    }
+    for (; a < 1; --e) {
+      a *= 2;
+    }
+    if (e < 1 - bias) {
+      // subnormal: v / 2^(1 - bias - mantissa_bits) is an integer
+      auto const m = static_cast<bits_type>(
+          scale(a, e + bias - 1 + mantissa_bits));
+      return static_cast<bits_type>(sign | m);
+    }
+    auto const m = static_cast<bits_type>(scale(a - 1, mantissa_bits));
+    auto const biased = static_cast<bits_type>(e + bias);
+    return static_cast<bits_type>(sign | (biased << mantissa_bits) | m);
+  }
+
+  /** value from the bits
+   * @param[in] bits bits of the value
+   * @return the value
+   */
+  static constexpr float_type decode(bits_type bits) {
+    constexpr bits_type one = 1;
+    bool const negative = (bits >> (8 * sizeof(float_type) - 1)) != 0;
+    auto const m = static_cast<bits_type>(bits & ((one << mantissa_bits) - 1));
+    auto const biased = static_cast<int>(
+        (bits >> mantissa_bits) & static_cast<bits_type>(max_biased));
+    float_type r = 0;
+    if (biased == max_biased) {
+      if (m != 0) {
+        return limits::quiet_NaN();
+      }
+      r = limits::infinity();
+    } else if (biased == 0) {
+      r = scale(static_cast<float_type>(m), 1 - bias - mantissa_bits);
+    } else {
+      r = scale(static_cast<float_type>((one << mantissa_bits) | m),
+                biased - bias - mantissa_bits);
+    }
+    return negative ? -r : r;
+  }
+};
+
+/** bytes which can be modified in constant expressions
+ * @tparam size byte count
+ */
+template <size_t size> struct constexpr_bytes {
+  /** bytes ( at least 1 byte to avoid zero length array ) */
+  std::uint8_t data[size == 0 ? 1 : size];
+
+  /** access the byte
+   * @param[in] ix index of the byte
+   * @return reference to the byte
+   */
+  constexpr std::uint8_t &operator[](size_t ix) { return data[ix]; }
+
+  /** access the byte
+   * @param[in] ix index of the byte
+   * @return the byte
+   */
+  constexpr std::uint8_t operator[](size_t ix) const { return data[ix]; }
+
+  /** convert to std::array
+   * @tparam ix indexes of the bytes
+   * @return std::array which has the same bytes
+   */
+  template <size_t... ix>
+  constexpr std::array<std::uint8_t, size>
+  to_array(std::index_sequence<ix...>) const {
+    return std::array<std::uint8_t, size>{{data[ix]...}};
+  }
+};
+
+/** template to serialize and deserialize in constant expressions. the result
+ * is the same as serializer and deserializer.
+ * @tparam target_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename target_type, byte_order order,
+          int typecat = type_category<target_type>::value>
+struct constexpr_codec;
+
+/** constexpr codec of integer or floating point type. integers are encoded
+ * with shifts, and floating point values are converted to integers with
+ * bit_cast, or with ieee754 if bit_cast is not available.
+ * @tparam target_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order>
+struct constexpr_codec<target_type, order, tcat::arithmetic> {
+  /** byte count of serialized size */
+  enum { size = sizeof(target_type) };
+
+  static_assert(size <= 8, "the type is too large for constexpr codec");
+
+  /** unsigned integer type which has the same size */
+  using bits_type = typename unsigned_of_size<size>::type;
+
+  /** bits of the integer
+   * @param[in] v value
+   * @return bits of v
+   */
+  static constexpr bits_type to_bits(target_type v, std::true_type) {
+    return static_cast<bits_type>(v);
+  }
+
+  /** integer from the bits
+   * @param[in] bits bits of the value
+   * @return the value
+   */
+  static constexpr target_type from_bits(bits_type bits, std::true_type) {
+    return static_cast<target_type>(bits);
+  }
+
+#if defined(LOLESERI_BIT_CAST)
+  /** bits of the floating point value
+   * @param[in] v value
+   * @return bits of v
+   */
+  static constexpr bits_type to_bits(target_type v, std::false_type) {
+    return LOLESERI_BIT_CAST(bits_type, v);
+  }
+
+  /** floating point value from the bits
+   * @param[in] bits bits of the value
+   * @return the value
+   */
+  static constexpr target_type from_bits(bits_type bits, std::false_type) {
+    return LOLESERI_BIT_CAST(target_type, bits);
+  }
+#else
+  /** bits of the floating point value
+   * @param[in] v value
+   * @return bits of v
+   */
+  static constexpr bits_type to_bits(target_type v, std::false_type) {
+    return ieee754<target_type>::encode(v);
+  }
+
+  /** floating point value from the bits
+   * @param[in] bits bits of the value
+   * @return the value
+   */
+  static constexpr target_type from_bits(bits_type bits, std::false_type) {
+    return ieee754<target_type>::decode(bits);
+  }
+#endif
+
+  /** bit count to shift to get the ix-th byte of serialized data
+   * @param[in] ix index of the byte
+   * @return shift count in bits
+   */
+  static constexpr size_t shift(size_t ix) {
+    return 8 * ((order == byte_order::big) ? size - 1 - ix : ix);
+  }
+
+  /** serialize
+   * @tparam bytes_t type of the bytes
+   * @param[out] out bytes to write
+   * @param[in] offset offset to write
+   * @param[in] v value to serialize
+   */
+  template <typename bytes_t>
+  static constexpr void write(bytes_t &out, size_t offset,
+                              target_type const &v) {
+    bits_type const bits = to_bits(v, std::is_integral<target_type>());
+    for (size_t i = 0; i < size; ++i) {
+      out[offset + i] = static_cast<std::uint8_t>(bits >> shift(i));
+    }
+  }
+
+  /** deserialize
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @return deserialized value
+   */
+  template <typename bytes_t>
+  static constexpr target_type read(bytes_t const &in, size_t offset) {
+    bits_type bits = 0;
+    for (size_t i = 0; i < size; ++i) {
+      bits = static_cast<bits_type>(
+          bits | static_cast<bits_type>(
+                     static_cast<bits_type>(in[offset + i]) << shift(i)));
+    }
+    return from_bits(bits, std::is_integral<target_type>());
+  }
+
+  /** deserialize into the object
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @param[out] obj object to write
+   */
+  template <typename bytes_t>
+  static constexpr void read_into(bytes_t const &in, size_t offset,
+                                  target_type &obj) {
+    obj = read(in, offset);
+  }
+};
+
+/** constexpr codec of bool
+ * @tparam target_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order>
+struct constexpr_codec<target_type, order, tcat::boolean> {
+  /** byte count of serialized size */
+  enum { size = 1 };
+
+  /** serialize
+   * @tparam bytes_t type of the bytes
+   * @param[out] out bytes to write
+   * @param[in] offset offset to write
+   * @param[in] v value to serialize
+   */
+  template <typename bytes_t>
+  static constexpr void write(bytes_t &out, size_t offset,
+                              target_type const &v) {
+    out[offset] = v ? 1 : 0;
+  }
+
+  /** deserialize
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @return deserialized value
+   */
+  template <typename bytes_t>
+  static constexpr target_type read(bytes_t const &in, size_t offset) {
+    return in[offset] != 0;
+  }
+
+  /** deserialize into the object
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @param[out] obj object to write
+   */
+  template <typename bytes_t>
+  static constexpr void read_into(bytes_t const &in, size_t offset,
+                                  target_type &obj) {
+    obj = read(in, offset);
+  }
+};
+
+/** constexpr codec of std::array
+ * @tparam target_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order>
+struct constexpr_codec<target_type, order, tcat::std_array> {
+  /** codec of the element */
+  using element = constexpr_codec<typename target_type::value_type, order>;
+
+  enum {
+    /** count of the elements */
+    count = std::tuple_size<target_type>::value,
+
+    /** byte count of serialized size */
+    size = element::size * count
+  };
+
+  /** serialize
+   * @tparam bytes_t type of the bytes
+   * @param[out] out bytes to write
+   * @param[in] offset offset to write
+   * @param[in] v value to serialize
+   */
+  template <typename bytes_t>
+  static constexpr void write(bytes_t &out, size_t offset,
+                              target_type const &v) {
+    for (size_t i = 0; i < count; ++i) {
+      element::write(out, offset + i * element::size, v[i]);
+    }
+  }
+
+  /** deserialize all elements at once
+   * @tparam bytes_t type of the bytes
+   * @tparam ix indexes of the elements
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @return deserialized value
+   */
+  template <typename bytes_t, size_t... ix>
+  static constexpr target_type read(bytes_t const &in, size_t offset,
+                                    std::index_sequence<ix...>) {
+    return target_type{{element::read(in, offset + ix * element::size)...}};
+  }
+
+  /** deserialize
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @return deserialized value
+   */
+  template <typename bytes_t>
+  static constexpr target_type read(bytes_t const &in, size_t offset) {
+    return read(in, offset, std::make_index_sequence<count>());
+  }
+
+  /** deserialize into the object
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @param[out] obj object to write
+   */
+  template <typename bytes_t>
+  static constexpr void read_into(bytes_t const &in, size_t offset,
+                                  target_type &obj) {
+    obj = read(in, offset);
+  }
+};
+
+/** constexpr codec of traditional array
+ * @tparam target_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order>
+struct constexpr_codec<target_type, order, tcat::array> {
+  /** codec of the element */
+  using element =
+      constexpr_codec<typename element_type_of_array<target_type>::type,
+                      order>;
+
+  enum {
+    /** count of the elements */
+    count = std::extent<target_type>::value,
+
+    /** byte count of serialized size */
+    size = element::size * count
+  };
+
+  /** serialize
+   * @tparam bytes_t type of the bytes
+   * @param[out] out bytes to write
+   * @param[in] offset offset to write
+   * @param[in] v value to serialize
+   */
+  template <typename bytes_t>
+  static constexpr void write(bytes_t &out, size_t offset,
+                              target_type const &v) {
+    for (size_t i = 0; i < count; ++i) {
+      element::write(out, offset + i * element::size, v[i]);
+    }
+  }
+
+  /** deserialize into the object
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @param[out] obj object to write
+   */
+  template <typename bytes_t>
+  static constexpr void read_into(bytes_t const &in, size_t offset,
+                                  target_type &obj) {
+    for (size_t i = 0; i < count; ++i) {
+      element::read_into(in, offset + i * element::size, obj[i]);
+    }
+  }
+};
+
+/** constexpr codec of struct or class. items<target_type>::list() should be
+ * constexpr.
+ * @tparam target_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order>
+struct constexpr_codec<target_type, order, tcat::other> {
+  static_assert(is_fixed_size<target_type>::value,
+                "constexpr codec supports fixed size types only");
+
+  /** type to get list of items to serialize */
+  using items = loleseri::items<target_type>;
+
+  /** type of the list of items to serialize */
+  using list_type = item_list_type<target_type>;
+
+  static_assert(all_have_plain_codec<list_type>::value,
+                "constexpr codec does not support items in their own "
+                "encoding");
+
+  /** codec of the ix-th item
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using item_codec = constexpr_codec<
+      typename memptr_value<
+          typename std::tuple_element<ix, list_type>::type>::type,
+      order>;
+
+  enum {
+    /** count of the items */
+    count = std::tuple_size<list_type>::value,
+
+    /** byte count of serialized size */
+    size = sum_of_size<list_type>::value
+  };
+
+  /** serialize all items
+   * @tparam bytes_t type of the bytes
+   * @tparam ix indexes of the items
+   * @param[out] out bytes to write
+   * @param[in] offset offset to write
+   * @param[in] v value to serialize
+   */
+  template <typename bytes_t, size_t... ix>
+  static constexpr void write(bytes_t &out, size_t offset,
+                              target_type const &v,
+                              std::index_sequence<ix...>) {
+    int done[] = {0, (item_codec<ix>::write(
+                          out, offset + offset_of_item<list_type, ix>::value,
+                          v.*std::get<ix>(items::list())),
+                      0)...};
+    static_cast<void>(done);
+  }
+
+  /** serialize
+   * @tparam bytes_t type of the bytes
+   * @param[out] out bytes to write
+   * @param[in] offset offset to write
+   * @param[in] v value to serialize
+   */
+  template <typename bytes_t>
+  static constexpr void write(bytes_t &out, size_t offset,
+                              target_type const &v) {
+    write(out, offset, v, std::make_index_sequence<count>());
+  }
+
+  /** deserialize all items into the object
+   * @tparam bytes_t type of the bytes
+   * @tparam ix indexes of the items
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @param[out] obj object to write
+   */
+  template <typename bytes_t, size_t... ix>
+  static constexpr void read_into(bytes_t const &in, size_t offset,
+                                  target_type &obj,
+                                  std::index_sequence<ix...>) {
+    int done[] = {0, (item_codec<ix>::read_into(
+                          in, offset + offset_of_item<list_type, ix>::value,
+                          obj.*std::get<ix>(items::list())),
+                      0)...};
+    static_cast<void>(done);
+  }
+
+  /** deserialize into the object
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @param[out] obj object to write
+   */
+  template <typename bytes_t>
+  static constexpr void read_into(bytes_t const &in, size_t offset,
+                                  target_type &obj) {
+    read_into(in, offset, obj, std::make_index_sequence<count>());
+  }
+
+  /** deserialize
+   * @tparam bytes_t type of the bytes
+   * @param[in] in bytes to read
+   * @param[in] offset offset to read
+   * @return deserialized value
+   */
+  template <typename bytes_t>
+  static constexpr target_type read(bytes_t const &in, size_t offset) {
+    target_type obj{};
+    read_into(in, offset, obj);
+    return obj;
+  }
+};
+
+/** serialize in constant expressions with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @param[in] obj object to serialize
+ * @return serialized bytes
+ */
+template <byte_order order, typename target>
+constexpr std::array<std::uint8_t, constexpr_codec<target, order>::size>
+constexpr_serialize(target const &obj) {
+  using codec = constexpr_codec<target, order>;
+  constexpr_bytes<codec::size> out{};
+  codec::write(out, 0, obj);
+  return out.to_array(std::make_index_sequence<codec::size>());
+}
+
+/** serialize in constant expressions
+ * @tparam target target type
+ * @param[in] obj object to serialize
+ * @return serialized bytes
+ */
+template <typename target>
+constexpr std::array<std::uint8_t,
+                     constexpr_codec<target, byte_order::little>::size>
+constexpr_serialize(target const &obj) {
+  return constexpr_serialize<byte_order::little>(obj);
+}
+
+/** deserialize in constant expressions with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam size byte count of the serialized bytes
+ * @param[in] bytes serialized bytes
+ * @return deserialized object
+ */
+template <byte_order order, typename target, size_t size>
+constexpr target
+constexpr_deserialize(std::array<std::uint8_t, size> const &bytes) {
+  using codec = constexpr_codec<target, order>;
+  static_assert(codec::size <= size, "bytes are too short");
+  target obj{};
+  codec::read_into(bytes, 0, obj);
+  return obj;
+}
+
+/** deserialize in constant expressions
+ * @tparam target target type
+ * @tparam size byte count of the serialized bytes
+ * @param[in] bytes serialized bytes
+ * @return deserialized object
+ */
+template <typename target, size_t size>
+constexpr target
+constexpr_deserialize(std::array<std::uint8_t, size> const &bytes) {
+  return constexpr_deserialize<byte_order::little, target>(bytes);
+}
+
+} // namespace loleseri
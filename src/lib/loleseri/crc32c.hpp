@@ -0,0 +1,541 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <loleseri/loleseri.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#if defined __SSE4_2__ && (defined __x86_64__ || defined _M_X64)
+#include <nmmintrin.h>
+#define LOLESERI_CRC32C_SSE42 1
+#endif
+
+namespace loleseri {
+
+/** CRC-32C ( Castagnoli, reflected polynomial 0x82f63b78 ) */
+struct crc32c {
+  /** initial value of the running state */
+  static constexpr std::uint32_t initial = 0xffffffffu;
+
+  /** checksum of the running state
+   * @param[in] state running state
+   * @return checksum
+   */
+  static constexpr std::uint32_t finish(std::uint32_t state) {
+    return state ^ 0xffffffffu;
+  }
+
+  /** tables for slicing-by-8. t[k][b] is the state of the byte b followed by
+   * k zero bytes.
+   * @return tables
+   */
+  static std::array<std::array<std::uint32_t, 256>, 8> const &table() {
+    static std::array<std::array<std::uint32_t, 256>, 8> const t = make_table();
+    return t;
+  }
+
+  /** make tables for slicing-by-8
+   * @return tables
+   */
+  static std::array<std::array<std::uint32_t, 256>, 8> make_table() {
+    std::array<std::array<std::uint32_t, 256>, 8> t;
+    for (std::uint32_t b = 0; b < 256; ++b) {
+      std::uint32_t c = b;
+      for (int i = 0; i < 8; ++i) {
+        c = (c >> 1) ^ (0x82f63b78u & (0u - (c & 1u)));
+      }
+      t[0][b] = c;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+      for (size_t b = 0; b < 256; ++b) {
+        auto const prev = t[k - 1][b];
+        t[k][b] = (prev >> 8) ^ t[0][prev & 0xffu];
+      }
+    }
+    return t;
+  }
+
+  /** update the running state with a byte by the table
+   * @param[in] state running state
+   * @param[in] b byte
+   * @return new state
+   */
+  static std::uint32_t update_byte(std::uint32_t state, std::uint8_t b) {
+    return (state >> 8) ^ table()[0][(state ^ b) & 0xffu];
+  }
+
+  /** update the running state with bytes by the tables
+   * @param[in] state running state
+   * @param[in] p top of the bytes
+   * @param[in] n byte count
+   * @return new state
+   */
+  static std::uint32_t update_table(std::uint32_t state, std::uint8_t const *p,
+                                    size_t n) {
+    auto const &t = table();
+    for (; 8 <= n; n -= 8, p += 8) {
+      std::uint32_t const lo =
+          state ^ (static_cast<std::uint32_t>(p[0]) |
+                   (static_cast<std::uint32_t>(p[1]) << 8) |
+                   (static_cast<std::uint32_t>(p[2]) << 16) |
+                   (static_cast<std::uint32_t>(p[3]) << 24));
+      state = t[7][lo & 0xffu] ^ t[6][(lo >> 8) & 0xffu] ^
+              t[5][(lo >> 16) & 0xffu] ^ t[4][lo >> 24] ^ t[3][p[4]] ^
+              t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
+    for (; n != 0; --n, ++p) {
+      state = update_byte(state, *p);
+    }
+    return state;
+  }
+
+#if defined LOLESERI_CRC32C_SSE42
+  /** update the running state with bytes by crc32 instruction of SSE4.2
+   * @param[in] state running state
+   * @param[in] p top of the bytes
+   * @param[in] n byte count
+   * @return new state
+   */
+  static std::uint32_t update_sse42(std::uint32_t state, std::uint8_t const *p,
+                                    size_t n) {
+    std::uint64_t s = state;
+    for (; 8 <= n; n -= 8, p += 8) {
+      std::uint64_t v;
+      std::memcpy(&v, p, 8);
+      s = _mm_crc32_u64(s, v);
+    }
+    auto r = static_cast<std::uint32_t>(s);
+    for (; n != 0; --n, ++p) {
+      r = _mm_crc32_u8(r, *p);
+    }
+    return r;
+  }
+#endif
+
+  /** update the running state with bytes
+   * @param[in] state running state
+   * @param[in] p top of the bytes
+   * @param[in] n byte count
+   * @return new state
+   */
+  static std::uint32_t update(std::uint32_t state, std::uint8_t const *p,
+                              size_t n) {
+#if defined LOLESERI_CRC32C_SSE42
+    return update_sse42(state, p, n);
+#else
+    return update_table(state, p, n);
+#endif
+  }
+
+  /** update the running state with contiguous bytes
+   * @tparam itor_t type of the iterator
+   * @param[in] state running state
+   * @param[in] begin top of the range
+   * @param[in] end end of the range
+   * @return new state
+   */
+  template <typename itor_t>
+  static std::uint32_t update(std::uint32_t state, itor_t begin, itor_t end,
+                              std::true_type) {
+    auto const n = static_cast<size_t>(std::distance(begin, end));
+    if (n == 0) {
+      return state;
+    }
+    auto p = reinterpret_cast<std::uint8_t const *>(std::addressof(*begin));
+    return update(state, p, n);
+  }
+
+  /** update the running state with bytes one by one
+   * @tparam itor_t type of the iterator
+   * @param[in] state running state
+   * @param[in] begin top of the range
+   * @param[in] end end of the range
+   * @return new state
+   */
+  template <typename itor_t>
+  static std::uint32_t update(std::uint32_t state, itor_t begin, itor_t end,
+                              std::false_type) {
+    for (; begin != end; ++begin) {
+      state = update_byte(state, static_cast<std::uint8_t>(*begin));
+    }
+    return state;
+  }
+
+  /** update the running state with the range
+   * @tparam itor_t type of the forward iterator
+   * @param[in] state running state
+   * @param[in] begin top of the range
+   * @param[in] end end of the range
+   * @return new state
+   */
+  template <typename itor_t>
+  static std::uint32_t update(std::uint32_t state, itor_t begin, itor_t end) {
+    using contiguous = std::integral_constant<
+        bool, is_contiguous_byte_iterator<itor_t>::value>;
+    return update(state, begin, end, contiguous());
+  }
+
+  /** checksum of the range
+   * @tparam itor_t type of the forward iterator
+   * @param[in] begin top of the range
+   * @param[in] end end of the range
+   * @return checksum
+   */
+  template <typename itor_t>
+  static std::uint32_t checksum(itor_t begin, itor_t end) {
+    return finish(update(initial, begin, end));
+  }
+};
+
+/** exception thrown if the checksum in the serialized data is different from
+ * the checksum of the data */
+class checksum_mismatch : public std::runtime_error {
+public:
+  /** create exception */
+  checksum_mismatch() : std::runtime_error("loleseri: checksum mismatch") {}
+};
+
+/** template to serialize and deserialize items of struct or class with
+ * updating the checksum. bytes of each item are checked right after they are
+ * written or read, while they are still in cache. the items are expanded in
+ * the initializers of arrays, which are evaluated from left to right.
+ * @tparam target type of struct or class
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct crc_items {
+  /** type of the list of items */
+  using list_type = item_list_type<target>;
+
+  /** indices of the items */
+  using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+
+  /** type to serialize the ix-th item
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using codec_type = typename item_codec<
+      typename std::tuple_element<ix, list_type>::type>::codec_type;
+
+  /** serialize the ix-th item and update the state
+   * @tparam ix index of the item
+   * @tparam itor_t type of the forward iterator
+   * @param[in] begin top of the output range
+   * @param[in] end end of the output range
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @param[in,out] state running state of the checksum
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t serialize_item(itor_t begin, itor_t end, target const *obj,
+                               list_type const &list, std::uint32_t &state) {
+    auto m = std::get<ix>(list);
+    using seri = serializer<codec_type<ix>, order>;
+    auto p = seri::serialize(begin, end, &(obj->*m));
+    state = crc32c::update(state, begin, p);
+    return p;
+  }
+
+  /** deserialize the ix-th item and update the state
+   * @tparam ix index of the item
+   * @tparam itor_t type of the forward iterator
+   * @param[in] begin top of the input range
+   * @param[in] end end of the input range
+   * @param[out] obj pointer to the object to deserialize
+   * @param[in] list items
+   * @param[in,out] state running state of the checksum
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_item(itor_t begin, itor_t end, target *obj,
+                                 list_type const &list, std::uint32_t &state) {
+    auto m = std::get<ix>(list);
+    using deseri = deserializer<codec_type<ix>, order>;
+    using check = std::integral_constant<
+        bool, !is_fixed_size<target>::value &&
+                  is_fixed_size<codec_type<ix>>::value>;
+    require_item_size<codec_type<ix>>(begin, end, check());
+    auto p = deseri::deserialize(begin, end, &(obj->*m));
+    state = crc32c::update(state, begin, p);
+    return p;
+  }
+
+  /** serialize items and update the state
+   * @tparam itor_t type of the forward iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the output range
+   * @param[in] end end of the output range
+   * @param[in] obj pointer to the object to serialize
+   * @param[in,out] state running state of the checksum
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t serialize(itor_t begin, itor_t end, target const *obj,
+                          std::uint32_t &state, index_sequence<ix...>) {
+    auto const list = items<target>::list();
+    int const expanded[] = {
+        0, (begin = serialize_item<ix>(begin, end, obj, list, state), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** serialize items and update the state
+   * @tparam itor_t type of the forward iterator
+   * @param[in] begin top of the output range
+   * @param[in] end end of the output range
+   * @param[in] obj pointer to the object to serialize
+   * @param[in,out] state running state of the checksum
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target const *obj,
+                          std::uint32_t &state) {
+    return serialize(begin, end, obj, state, indices());
+  }
+
+  /** deserialize items and update the state
+   * @tparam itor_t type of the forward iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the input range
+   * @param[in] end end of the input range
+   * @param[out] obj pointer to the object to deserialize
+   * @param[in,out] state running state of the checksum
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t deserialize(itor_t begin, itor_t end, target *obj,
+                            std::uint32_t &state, index_sequence<ix...>) {
+    auto const list = items<target>::list();
+    int const expanded[] = {
+        0,
+        (begin = deserialize_item<ix>(begin, end, obj, list, state), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** deserialize items and update the state
+   * @tparam itor_t type of the forward iterator
+   * @param[in] begin top of the input range
+   * @param[in] end end of the input range
+   * @param[out] obj pointer to the object to deserialize
+   * @param[in,out] state running state of the checksum
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target *obj,
+                            std::uint32_t &state) {
+    return deserialize(begin, end, obj, state, indices());
+  }
+};
+
+/** template to serialize and deserialize the whole value at once with
+ * updating the checksum.
+ * @tparam target type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct crc_whole {
+  /** serialize the value and update the state
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target const *obj,
+                          std::uint32_t &state) {
+    auto p = serializer<target, order>::serialize(begin, end, obj);
+    state = crc32c::update(state, begin, p);
+    return p;
+  }
+
+  /** deserialize the value and update the state
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target *obj,
+                            std::uint32_t &state) {
+    auto p = deserializer<target, order>::deserialize(begin, end, obj);
+    state = crc32c::update(state, begin, p);
+    return p;
+  }
+};
+
+/** template to serialize and deserialize the value with updating the
+ * checksum.
+ * @tparam target type of the value
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of target
+ */
+template <typename target, byte_order order,
+          int typecat = type_category<target>::value>
+struct crc_value : public crc_whole<target, order> {};
+
+/** template to serialize and deserialize struct or class with updating the
+ * checksum. values of fixed size are serialized at once ( by single memcpy
+ * if the layout is native ) and checked in one pass. values of variable size
+ * are checked item by item. */
+template <typename target, byte_order order>
+struct crc_value<target, order, tcat::other>
+    : public std::conditional<is_fixed_size<target>::value,
+                              crc_whole<target, order>,
+                              crc_items<target, order>>::type {};
+
+/** template to calculate the size with the trailer
+ * @tparam target type of the value
+ * @tparam order byte order of serialized data
+ * @tparam fixed true if the size of target is fixed
+ */
+template <typename target, byte_order order,
+          bool fixed = is_fixed_size<target>::value>
+struct crc_checked_size
+    : public std::integral_constant<size_t,
+                                    serializer<target, order>::size + 4> {};
+
+/** template to calculate the size with the trailer ( not used ) */
+template <typename target, byte_order order>
+struct crc_checked_size<target, order, false>
+    : public std::integral_constant<size_t, 0> {};
+
+/** template to serialize and deserialize with the CRC-32C trailer.
+ * 4 bytes of the checksum of the serialized value follow the value.
+ * the checksum is calculated while the value is serialized or deserialized,
+ * so the data is not read again in another pass.
+ * @tparam target target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order>
+struct crc_checked
+    : public fixed_size_base<is_fixed_size<target>::value,
+                             crc_checked_size<target, order>> {
+  /** type to serialize the trailer */
+  using trailer_serializer = serializer<std::uint32_t, order>;
+
+  /** type to deserialize the trailer */
+  using trailer_deserializer = deserializer<std::uint32_t, order>;
+
+  /** type to serialize the value */
+  using seri = serializer<target, order>;
+
+  /** type to serialize and deserialize with the checksum */
+  using value = crc_value<target, order>;
+
+  /** byte count of serialized obj with the trailer
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target const *obj) {
+    return seri::serialized_size(obj) + trailer_serializer::size;
+  }
+
+  /** serialize obj and the trailer
+   * @tparam itor forward iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor>
+  static itor serialize(itor begin, itor end, target const *obj) {
+    static_assert(is_forward<itor>::value,
+                  "checksum requires forward iterators");
+    require_size(begin, end, serialized_size(obj));
+    std::uint32_t state = crc32c::initial;
+    auto p = value::serialize(begin, end, obj, state);
+    std::uint32_t const sum = crc32c::finish(state);
+    return trailer_serializer::serialize(p, end, &sum);
+  }
+
+  /** deserialize obj and check the trailer
+   * @tparam itor forward iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short
+   * @throw checksum_mismatch if the trailer is different from the checksum.
+   * obj may be modified in this case.
+   */
+  template <typename itor>
+  static itor deserialize(itor begin, itor end, target *obj) {
+    static_assert(is_forward<itor>::value,
+                  "checksum requires forward iterators");
+    require_whole_size(begin, end, is_fixed_size<target>());
+    std::uint32_t state = crc32c::initial;
+    auto p = value::deserialize(begin, end, obj, state);
+    require_size(p, end, trailer_deserializer::size);
+    std::uint32_t sum;
+    auto q = trailer_deserializer::deserialize(p, end, &sum);
+    if (sum != crc32c::finish(state)) {
+      throw checksum_mismatch();
+    }
+    return q;
+  }
+
+private:
+  /** template to check the iterator is forward iterator */
+  template <typename itor>
+  using is_forward = std::is_base_of<
+      std::forward_iterator_tag,
+      typename std::iterator_traits<itor>::iterator_category>;
+
+  /** check the range is long enough for the value of fixed size and the
+   * trailer */
+  template <typename itor>
+  static void require_whole_size(itor begin, itor end, std::true_type) {
+    require_size(begin, end, crc_checked_size<target, order>::value);
+  }
+
+  /** do nothing because deserializers of variable size values check the
+   * length of the range */
+  template <typename itor>
+  static void require_whole_size(itor, itor, std::false_type) {}
+};
+
+/** serialize with the CRC-32C trailer
+ * @tparam target target type
+ * @tparam itor forward iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor>
+itor serialize_checked(itor begin, itor end, target const *obj) {
+  return crc_checked<target, byte_order::little>::serialize(begin, end, obj);
+}
+
+/** serialize with the CRC-32C trailer with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor forward iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize_checked(itor begin, itor end, target const *obj) {
+  return crc_checked<target, order>::serialize(begin, end, obj);
+}
+
+/** deserialize with checking the CRC-32C trailer
+ * @tparam target target type
+ * @tparam itor forward iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ * @throw checksum_mismatch if the trailer is different from the checksum
+ */
+template <typename target, typename itor>
+itor deserialize_checked(itor begin, itor end, target *obj) {
+  return crc_checked<target, byte_order::little>::deserialize(begin, end, obj);
+}
+
+/** deserialize with checking the CRC-32C trailer with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor forward iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ * @throw checksum_mismatch if the trailer is different from the checksum
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize_checked(itor begin, itor end, target *obj) {
+  return crc_checked<target, order>::deserialize(begin, end, obj);
+}
+
+} // namespace loleseri
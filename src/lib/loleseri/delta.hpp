@@ -0,0 +1,796 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/packed.hpp>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace loleseri {
+
+/** template to serialize the difference between two values and apply it.
+ * specialize this for the types which have their own serializers.
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, byte_order order,
+          int typecat = type_category<
+              typename std::remove_cv<value_type>::type>::value>
+struct delta_codec;
+
+/** template to write the whole value if it is changed
+ * @tparam codec_type type to select serializer and deserializer
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename codec_type, typename value_type, byte_order order>
+struct delta_full {
+  /** type to serialize the value */
+  using seri = serializer<codec_type, order>;
+
+  /** type to deserialize the value */
+  using deseri = deserializer<codec_type, order>;
+
+  /** byte count of the difference ( whole of cur )
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return byte count
+   */
+  static size_t serialized_size(value_type const *prev,
+                                value_type const *cur) {
+    return seri::serialized_size(cur);
+  }
+
+  /** serialize the difference ( whole of cur )
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *prev,
+                          value_type const *cur) {
+    return seri::serialize(begin, end, cur);
+  }
+
+  /** deserialize the difference into obj
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in,out] obj pointer to the value to update
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the random access range is too short
+   */
+  template <typename itor_t>
+  static itor_t apply(itor_t begin, itor_t end, value_type *obj) {
+    require_item_size<codec_type>(begin, end, is_fixed_size<codec_type>());
+    return deseri::deserialize(begin, end, obj);
+  }
+
+  /** overwrite the serialized value with the difference
+   * @tparam itor_t type of the random access iterator of the difference
+   * @tparam base_itor type of the random access iterator of the value
+   * @param[in] begin top of the difference
+   * @param[in] end end of the difference
+   * @param[in] base top of the serialized value
+   * @return iterator pointint to the top of the unused area of difference
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t, typename base_itor>
+  static itor_t patch(itor_t begin, itor_t end, base_itor base) {
+    require_size(begin, end, seri::size);
+    auto const next = std::next(begin, seri::size);
+    std::copy(begin, next, base);
+    return next;
+  }
+};
+
+/** template to write the whole arithmetic value if the bytes of it are
+ * changed */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::arithmetic>
+    : public delta_full<value_type, value_type, order> {
+  /** check the value is changed. compares the bytes, so that the changes
+   * between 0.0 and -0.0 are found and NaN is not always changed.
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    return std::memcmp(prev, cur, sizeof(value_type)) != 0;
+  }
+};
+
+/** template to write the whole bool if it is changed */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::boolean>
+    : public delta_full<value_type, value_type, order> {
+  /** check the value is changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    return *prev != *cur;
+  }
+};
+
+/** template to write the whole std::basic_string if it is changed */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::string>
+    : public delta_full<value_type, value_type, order> {
+  /** check the value is changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    return *prev != *cur;
+  }
+};
+
+/** template to write the whole std::vector if any element is changed */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::vector>
+    : public delta_full<value_type, value_type, order> {
+  /** type to find the changes of the elements */
+  using element_codec = delta_codec<typename value_type::value_type, order>;
+
+  /** check the value is changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if the size or any element is changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    if (prev->size() != cur->size()) {
+      return true;
+    }
+    for (size_t i = 0; i < cur->size(); ++i) {
+      if (element_codec::changed(&(*prev)[i], &(*cur)[i])) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/** template to write the whole item in its own encoding ( compact, packed,
+ * etc. ) if the serialized bytes are changed
+ * @tparam codec_type type to select serializer and deserializer
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename codec_type, typename value_type, byte_order order>
+struct delta_opaque : public delta_full<codec_type, value_type, order> {
+  /** type to serialize the value */
+  using seri = serializer<codec_type, order>;
+
+  /** check the serialized bytes of fixed size are changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur,
+                      std::true_type) {
+    std::array<std::uint8_t, seri::size> a, b;
+    seri::serialize(a.begin(), a.end(), prev);
+    seri::serialize(b.begin(), b.end(), cur);
+    return a != b;
+  }
+
+  /** check the serialized bytes of variable size are changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur,
+                      std::false_type) {
+    std::vector<std::uint8_t> a(seri::serialized_size(prev));
+    std::vector<std::uint8_t> b(seri::serialized_size(cur));
+    if (a.size() != b.size()) {
+      return true;
+    }
+    seri::serialize(a.begin(), a.end(), prev);
+    seri::serialize(b.begin(), b.end(), cur);
+    return a != b;
+  }
+
+  /** check the serialized bytes are changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    return changed(prev, cur, is_fixed_size<codec_type>());
+  }
+};
+
+/** template to select how to find the changes of the item
+ * @tparam item type of the item in items<T>::list()
+ * @tparam order byte order of serialized data
+ */
+template <typename item, byte_order order> struct delta_item_codec {
+  /** data type */
+  using value_type = typename item_codec<item>::value_type;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = typename item_codec<item>::codec_type;
+
+  /** type to find the changes. the items in their own encoding are
+   * compared as bytes */
+  using type = typename std::conditional<
+      std::is_same<value_type, codec_type>::value,
+      delta_codec<value_type, order>,
+      delta_opaque<codec_type, value_type, order>>::type;
+};
+
+/** template to find, serialize and apply the changes of the items of struct
+ * or class. the items are expanded in the initializers of arrays, which are
+ * evaluated from left to right.
+ * @tparam target_type type of struct or class
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order> struct delta_items {
+  /** type of the list of items */
+  using list_type = item_list_type<target_type>;
+
+  /** indices of the items */
+  using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+
+  /** type to find the changes of the ix-th item
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using codec = typename delta_item_codec<
+      typename std::tuple_element<ix, list_type>::type, order>::type;
+
+  /** check any item is changed
+   * @tparam ix indices of the items
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  template <size_t... ix>
+  static bool changed(list_type const &list, target_type const *prev,
+                      target_type const *cur, index_sequence<ix...>) {
+    bool r = false;
+    int const expanded[] = {
+        0, (r = r || codec<ix>::changed(&(prev->*std::get<ix>(list)),
+                                        &(cur->*std::get<ix>(list))),
+            0)...};
+    static_cast<void>(expanded);
+    return r;
+  }
+
+  /** check any item is changed
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(list_type const &list, target_type const *prev,
+                      target_type const *cur) {
+    return changed(list, prev, cur, indices());
+  }
+
+  /** find the changed items
+   * @tparam ix indices of the items
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[out] flags true for the changed items
+   */
+  template <size_t... ix>
+  static void find(list_type const &list, target_type const *prev,
+                   target_type const *cur, bool *flags,
+                   index_sequence<ix...>) {
+    int const expanded[] = {
+        0, (flags[ix] = codec<ix>::changed(&(prev->*std::get<ix>(list)),
+                                           &(cur->*std::get<ix>(list))),
+            0)...};
+    static_cast<void>(expanded);
+  }
+
+  /** find the changed items
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[out] flags true for the changed items
+   */
+  static void find(list_type const &list, target_type const *prev,
+                   target_type const *cur, bool *flags) {
+    find(list, prev, cur, flags, indices());
+  }
+
+  /** byte count of the changed items
+   * @tparam ix indices of the items
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[in] flags true for the changed items
+   * @return byte count
+   */
+  template <size_t... ix>
+  static size_t serialized_size(list_type const &list, target_type const *prev,
+                                target_type const *cur, bool const *flags,
+                                index_sequence<ix...>) {
+    size_t const sizes[] = {
+        0, (flags[ix] ? codec<ix>::serialized_size(&(prev->*std::get<ix>(list)),
+                                                   &(cur->*std::get<ix>(list)))
+                      : 0)...};
+    size_t r = 0;
+    for (size_t s : sizes) {
+      r += s;
+    }
+    return r;
+  }
+
+  /** byte count of the changed items
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[in] flags true for the changed items
+   * @return byte count
+   */
+  static size_t serialized_size(list_type const &list, target_type const *prev,
+                                target_type const *cur, bool const *flags) {
+    return serialized_size(list, prev, cur, flags, indices());
+  }
+
+  /** serialize the changed items
+   * @tparam itor_t type of the output iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[in] flags true for the changed items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t serialize(itor_t begin, itor_t end, list_type const &list,
+                          target_type const *prev, target_type const *cur,
+                          bool const *flags, index_sequence<ix...>) {
+    int const expanded[] = {
+        0, (begin = flags[ix] ? codec<ix>::serialize(
+                                    begin, end, &(prev->*std::get<ix>(list)),
+                                    &(cur->*std::get<ix>(list)))
+                              : begin,
+            0)...};
+    static_cast<void>(expanded);
+    return begin;
+  }
+
+  /** serialize the changed items
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] list items
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[in] flags true for the changed items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, list_type const &list,
+                          target_type const *prev, target_type const *cur,
+                          bool const *flags) {
+    return serialize(begin, end, list, prev, cur, flags, indices());
+  }
+
+  /** deserialize the changed items into obj
+   * @tparam itor_t type of the input iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] list items
+   * @param[in,out] obj pointer to the value to update
+   * @param[in] flags true for the changed items
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t apply(itor_t begin, itor_t end, list_type const &list,
+                      target_type *obj, bool const *flags,
+                      index_sequence<ix...>) {
+    int const expanded[] = {
+        0, (begin = flags[ix] ? codec<ix>::apply(begin, end,
+                                                 &(obj->*std::get<ix>(list)))
+                              : begin,
+            0)...};
+    static_cast<void>(expanded);
+    return begin;
+  }
+
+  /** deserialize the changed items into obj
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] list items
+   * @param[in,out] obj pointer to the value to update
+   * @param[in] flags true for the changed items
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t apply(itor_t begin, itor_t end, list_type const &list,
+                      target_type *obj, bool const *flags) {
+    return apply(begin, end, list, obj, flags, indices());
+  }
+
+  /** overwrite the changed items in the serialized value of fixed size
+   * @tparam itor_t type of the random access iterator of the difference
+   * @tparam base_itor type of the random access iterator of the value
+   * @tparam ix indices of the items
+   * @param[in] begin top of the difference
+   * @param[in] end end of the difference
+   * @param[in] base top of the serialized value
+   * @param[in] flags true for the changed items
+   * @return iterator pointint to the top of the unused area of difference
+   */
+  template <typename itor_t, typename base_itor, size_t... ix>
+  static itor_t patch(itor_t begin, itor_t end, base_itor base,
+                      bool const *flags, index_sequence<ix...>) {
+    int const expanded[] = {
+        0, (begin = flags[ix] ? codec<ix>::patch(
+                                    begin, end,
+                                    std::next(base, offset_of_item<
+                                                        list_type, ix>::value))
+                              : begin,
+            0)...};
+    static_cast<void>(expanded);
+    return begin;
+  }
+
+  /** overwrite the changed items in the serialized value of fixed size
+   * @tparam itor_t type of the random access iterator of the difference
+   * @tparam base_itor type of the random access iterator of the value
+   * @param[in] begin top of the difference
+   * @param[in] end end of the difference
+   * @param[in] base top of the serialized value
+   * @param[in] flags true for the changed items
+   * @return iterator pointint to the top of the unused area of difference
+   */
+  template <typename itor_t, typename base_itor>
+  static itor_t patch(itor_t begin, itor_t end, base_itor base,
+                      bool const *flags) {
+    return patch(begin, end, base, flags, indices());
+  }
+};
+
+/** template to serialize the changes of struct or class. the bit mask of
+ * the changed items ( bit ( i % 8 ) of byte ( i / 8 ) for i-th item ) is
+ * followed by the changes of them in order.
+ */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::other> {
+  /** type of the list of items */
+  using list_type = item_list_type<value_type>;
+
+  /** count of the items */
+  enum { count = std::tuple_size<list_type>::value };
+
+  /** type to serialize and deserialize the bit mask */
+  using mask = bit_codec<count>;
+
+  /** type to process the items */
+  using first = delta_items<value_type, order>;
+
+  /** type of the flags of the changed items */
+  using flags_type = std::array<bool, count>;
+
+  /** check any item is changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    return first::changed(items<value_type>::list(), prev, cur);
+  }
+
+  /** byte count of the changes
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return byte count
+   */
+  static size_t serialized_size(value_type const *prev,
+                                value_type const *cur) {
+    auto const list = items<value_type>::list();
+    flags_type flags;
+    first::find(list, prev, cur, flags.data());
+    return mask::size + first::serialized_size(list, prev, cur, flags.data());
+  }
+
+  /** serialize the bit mask and the changes
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *prev,
+                          value_type const *cur) {
+    auto const list = items<value_type>::list();
+    flags_type flags;
+    first::find(list, prev, cur, flags.data());
+    auto p = mask::serialize(begin, end, flags.data());
+    return first::serialize(p, end, list, prev, cur, flags.data());
+  }
+
+  /** deserialize the bit mask and the changes into obj
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in,out] obj pointer to the value to update
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the random access range is too short
+   */
+  template <typename itor_t>
+  static itor_t apply(itor_t begin, itor_t end, value_type *obj) {
+    require_size(begin, end, mask::size);
+    flags_type flags;
+    auto p = mask::deserialize(begin, end, flags.data());
+    return first::apply(p, end, items<value_type>::list(), obj,
+                        flags.data());
+  }
+
+  /** overwrite the changed items in the serialized value of fixed size
+   * @tparam itor_t type of the random access iterator of the difference
+   * @tparam base_itor type of the random access iterator of the value
+   * @param[in] begin top of the difference
+   * @param[in] end end of the difference
+   * @param[in] base top of the serialized value
+   * @return iterator pointint to the top of the unused area of difference
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t, typename base_itor>
+  static itor_t patch(itor_t begin, itor_t end, base_itor base) {
+    require_size(begin, end, mask::size);
+    flags_type flags;
+    auto p = mask::deserialize(begin, end, flags.data());
+    return first::patch(p, end, base, flags.data());
+  }
+};
+
+/** template to serialize the changes of array. the bit mask of the changed
+ * elements is followed by the changes of them in order.
+ * @tparam value_type std::array or traditional array
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, typename element_type, size_t count,
+          byte_order order>
+struct delta_array {
+  /** type to serialize and deserialize the bit mask */
+  using mask = bit_codec<count>;
+
+  /** type to find the changes of the elements */
+  using element_codec = delta_codec<element_type, order>;
+
+  /** type of the flags of the changed elements */
+  using flags_type = std::array<bool, count>;
+
+  /** check any element is changed
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return true if changed
+   */
+  static bool changed(value_type const *prev, value_type const *cur) {
+    for (size_t i = 0; i < count; ++i) {
+      if (element_codec::changed(&(*prev)[i], &(*cur)[i])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** find the changed elements
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @param[out] flags true for the changed elements
+   */
+  static void find(value_type const *prev, value_type const *cur,
+                   flags_type *flags) {
+    for (size_t i = 0; i < count; ++i) {
+      (*flags)[i] = element_codec::changed(&(*prev)[i], &(*cur)[i]);
+    }
+  }
+
+  /** byte count of the changes
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return byte count
+   */
+  static size_t serialized_size(value_type const *prev,
+                                value_type const *cur) {
+    size_t size = mask::size;
+    for (size_t i = 0; i < count; ++i) {
+      if (element_codec::changed(&(*prev)[i], &(*cur)[i])) {
+        size += element_codec::serialized_size(&(*prev)[i], &(*cur)[i]);
+      }
+    }
+    return size;
+  }
+
+  /** serialize the bit mask and the changes
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] prev pointer to the previous value
+   * @param[in] cur pointer to the current value
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *prev,
+                          value_type const *cur) {
+    flags_type flags;
+    find(prev, cur, &flags);
+    auto p = mask::serialize(begin, end, flags.data());
+    for (size_t i = 0; i < count; ++i) {
+      if (flags[i]) {
+        p = element_codec::serialize(p, end, &(*prev)[i], &(*cur)[i]);
+      }
+    }
+    return p;
+  }
+
+  /** deserialize the bit mask and the changes into obj
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in,out] obj pointer to the value to update
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the random access range is too short
+   */
+  template <typename itor_t>
+  static itor_t apply(itor_t begin, itor_t end, value_type *obj) {
+    require_size(begin, end, mask::size);
+    flags_type flags;
+    auto p = mask::deserialize(begin, end, flags.data());
+    for (size_t i = 0; i < count; ++i) {
+      if (flags[i]) {
+        p = element_codec::apply(p, end, &(*obj)[i]);
+      }
+    }
+    return p;
+  }
+
+  /** overwrite the changed elements in the serialized value of fixed size
+   * @tparam itor_t type of the random access iterator of the difference
+   * @tparam base_itor type of the random access iterator of the value
+   * @param[in] begin top of the difference
+   * @param[in] end end of the difference
+   * @param[in] base top of the serialized value
+   * @return iterator pointint to the top of the unused area of difference
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t, typename base_itor>
+  static itor_t patch(itor_t begin, itor_t end, base_itor base) {
+    constexpr size_t element_size = serializer<element_type>::size;
+    require_size(begin, end, mask::size);
+    flags_type flags;
+    auto p = mask::deserialize(begin, end, flags.data());
+    for (size_t i = 0; i < count; ++i) {
+      if (flags[i]) {
+        auto const offset = static_cast<std::ptrdiff_t>(i * element_size);
+        p = element_codec::patch(p, end, std::next(base, offset));
+      }
+    }
+    return p;
+  }
+};
+
+/** template to serialize the changes of std::array */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::std_array>
+    : public delta_array<value_type, typename value_type::value_type,
+                         std::tuple_size<value_type>::value, order> {};
+
+/** template to serialize the changes of traditional array */
+template <typename value_type, byte_order order>
+struct delta_codec<value_type, order, tcat::array>
+    : public delta_array<value_type,
+                         typename element_type_of_array<value_type>::type,
+                         std::extent<value_type>::value, order> {};
+
+/** byte count of the changes from prev to cur
+ * @tparam target target type
+ * @param[in] prev pointer to the previous value
+ * @param[in] cur pointer to the current value
+ * @return byte count
+ */
+template <typename target>
+size_t serialized_delta_size(target const *prev, target const *cur) {
+  return delta_codec<target, byte_order::little>::serialized_size(prev, cur);
+}
+
+/** serialize the changes from prev to cur. the bit mask of the changed
+ * items is followed by the changed items. nested structs and arrays are
+ * written as their changes recursively, and other items are written whole.
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @param[in] prev pointer to the previous value
+ * @param[in] cur pointer to the current value
+ * @return top of iterator pointing to the top of unused area
+ */
+template <typename target, typename itor>
+itor serialize_delta(itor begin, itor end, target const *prev,
+                     target const *cur) {
+  return delta_codec<target, byte_order::little>::serialize(begin, end, prev,
+                                                            cur);
+}
+
+/** serialize the changes from prev to cur with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @param[in] prev pointer to the previous value
+ * @param[in] cur pointer to the current value
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize_delta(itor begin, itor end, target const *prev,
+                     target const *cur) {
+  return delta_codec<target, order>::serialize(begin, end, prev, cur);
+}
+
+/** apply the changes to obj
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @param[in,out] obj pointer to the previous value to update
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <typename target, typename itor>
+itor apply_delta(itor begin, itor end, target *obj) {
+  return delta_codec<target, byte_order::little>::apply(begin, end, obj);
+}
+
+/** apply the changes to obj with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @param[in,out] obj pointer to the previous value to update
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <byte_order order, typename target, typename itor>
+itor apply_delta(itor begin, itor end, target *obj) {
+  return delta_codec<target, order>::apply(begin, end, obj);
+}
+
+/** apply the changes to the serialized value of fixed size in place. the
+ * changed items are copied to their offsets without deserializing. the
+ * byte order of the changes must be same as the value.
+ * @tparam target target type
+ * @tparam itor random access iterator type of the changes
+ * @tparam base_itor random access iterator type of the serialized value
+ * @param[in] begin top of the changes
+ * @param[in] end end of the changes
+ * @param[in] base_begin top of the serialized value
+ * @param[in] base_end end of the serialized value
+ * @return top of iterator pointing to the top of unused area of the changes
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor, typename base_itor>
+itor apply_delta(itor begin, itor end, base_itor base_begin,
+                 base_itor base_end) {
+  static_assert(is_fixed_size<target>::value,
+                "serialized value to patch must have fixed size");
+  require_size(base_begin, base_end, serializer<target>::size);
+  return delta_codec<target, byte_order::little>::patch(begin, end,
+                                                        base_begin);
+}
+
+} // namespace loleseri
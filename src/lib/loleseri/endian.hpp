@@ -1,17 +1,47 @@
 #pragma once
 
+#if (!defined LOLESERI_LITTLE_ENDIAN) && (!defined LOLESERI_BIG_ENDIAN)
+
 #if __clang__ || __GNUC__
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 #define LOLESERI_LITTLE_ENDIAN 1
-#else
+#elif __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
 #define LOLESERI_BIG_ENDIAN 1
 #endif
 #endif
 
-#if defined _MSC_VER &&  (_M_IX86 || _M_AMD64 )
+#if defined _MSC_VER &&                                                        \
+    (_M_IX86 || _M_AMD64 || _M_X64 || _M_ARM || _M_ARM64)
 #define LOLESERI_LITTLE_ENDIAN 1
 #endif
 
+#endif
+
 #if (! defined LOLESERI_LITTLE_ENDIAN) && (! defined LOLESERI_BIG_ENDIAN)
 #error "you should define LOLESERI_LITTLE_ENDIAN or LOLESERI_BIG_ENDIAN"
 #endif
+
+#if (defined LOLESERI_LITTLE_ENDIAN) && (defined LOLESERI_BIG_ENDIAN)
+#error "LOLESERI_LITTLE_ENDIAN and LOLESERI_BIG_ENDIAN are both defined"
+#endif
+
+namespace loleseri {
+
+/** byte order of serialized data */
+enum class byte_order {
+  /** little endian ( default ) */
+  little,
+
+  /** big endian ( network byte order ) */
+  big,
+
+#if LOLESERI_LITTLE_ENDIAN
+  /** byte order of the host */
+  native = little
+#else
+  /** byte order of the host */
+  native = big
+#endif
+};
+
+} // namespace loleseri
@@ -0,0 +1,474 @@
+#pragma once
+
+#include <cstdint>
+#include <loleseri/loleseri.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+namespace loleseri {
+
+/** exception thrown if the version of the serialized data is unknown */
+class unknown_version : public std::runtime_error {
+public:
+  /** create exception */
+  unknown_version() : std::runtime_error("loleseri: unknown version") {}
+};
+
+/** current version of the layout of the type. specialize this when the
+ * items of the type are changed, like
+ * template <> struct schema_version<foo> : std::integral_constant<...,2> {};
+ * @tparam target_type target type
+ */
+template <typename target_type>
+struct schema_version : public std::integral_constant<std::uint32_t, 0> {};
+
+/** items of the older version of the type. specialize this for the older
+ * versions whose layouts are different from the current one. list() returns
+ * the items of the current type in the order of the older layout. the
+ * members which are not in the list keep their values.
+ * the layout is same as items<T> if this is not specialized.
+ * @tparam target_type target type
+ * @tparam version version of the layout
+ */
+template <typename target_type, std::uint32_t version>
+struct legacy_items : public items<target_type> {};
+
+/** template to specify the layout of the version is same as the current one
+ * @tparam target_type target type
+ * @tparam version version of the layout
+ */
+template <typename target_type, std::uint32_t version>
+struct is_current_layout
+    : public std::integral_constant<
+          bool,
+          version == schema_version<target_type>::value ||
+              std::is_base_of<items<target_type>,
+                              legacy_items<target_type, version>>::value> {};
+
+/** item of legacy_items<T, v>::list() for the member which was removed. the
+ * value is read and discarded.
+ * @tparam value_type type of the removed member
+ */
+template <typename value_type> struct skip {};
+
+/** data type of the removed member */
+template <typename value> struct memptr_value<skip<value>> {
+  /** data type */
+  using type = value;
+};
+
+/** item of legacy_items<T, v>::list() for the member whose type was changed.
+ * the value of old type is read and converted with static_cast.
+ * @tparam old_type type of the member in the older layout
+ * @tparam value_type type of the member
+ * @tparam owner type of struct or class
+ */
+template <typename old_type, typename value_type, typename owner>
+struct converted_item {
+  /** pointer to the data member */
+  value_type owner::*member;
+};
+
+/** create item which reads the value of old type into the member
+ * @tparam old_type type of the member in the older layout
+ * @param[in] member pointer to the data member
+ * @return item
+ */
+template <typename old_type, typename value_type, typename owner>
+converted_item<old_type, value_type, owner> convert(value_type owner::*member) {
+  return converted_item<old_type, value_type, owner>{member};
+}
+
+/** data type of the member in the older layout */
+template <typename old_type, typename value, typename owner>
+struct memptr_value<converted_item<old_type, value, owner>> {
+  /** data type */
+  using type = old_type;
+};
+
+/** template to deserialize an item of the older layout
+ * @tparam item type of the item in legacy_items<T, v>::list()
+ * @tparam order byte order of serialized data
+ */
+template <typename item, byte_order order> struct legacy_item {
+  /** deserialize the item into the member
+   * @tparam target_type type of the object
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj object which has the member
+   * @param[in] m item
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename target_type, typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            item const &m) {
+    using deseri = deserializer<typename item_codec<item>::codec_type, order>;
+    return deseri::deserialize(begin, end, &(obj->*m));
+  }
+};
+
+/** template to deserialize and discard the removed member
+ * @tparam value_type type of the removed member
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, byte_order order>
+struct legacy_item<skip<value_type>, order> {
+  /** deserialize the value and discard it
+   * @tparam target_type type of the object
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename target_type, typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *,
+                            skip<value_type> const &) {
+    value_type discarded;
+    return deserializer<value_type, order>::deserialize(begin, end,
+                                                        &discarded);
+  }
+};
+
+/** template to deserialize the value of old type into the member
+ * @tparam old_type type of the member in the older layout
+ * @tparam value_type type of the member
+ * @tparam owner type of struct or class
+ * @tparam order byte order of serialized data
+ */
+template <typename old_type, typename value_type, typename owner,
+          byte_order order>
+struct legacy_item<converted_item<old_type, value_type, owner>, order> {
+  /** deserialize the value of old type and convert it
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj object which has the member
+   * @param[in] m item
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  deserialize(itor_t begin, itor_t end, owner *obj,
+              converted_item<old_type, value_type, owner> const &m) {
+    old_type old;
+    auto p = deserializer<old_type, order>::deserialize(begin, end, &old);
+    obj->*m.member = static_cast<value_type>(old);
+    return p;
+  }
+};
+
+/** type to deserialize the older layout into the current type. the items of
+ * the older layout are deserialized in order by the plan generated at
+ * compile time. the layout same as the current one is deserialized by
+ * deserializer<T> ( and copied with memcpy if the layout is native ).
+ * @tparam target_type target type
+ * @tparam version version of the layout
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, std::uint32_t version, byte_order order>
+struct legacy_deserializer
+    : public fixed_size_base<
+          all_have_fixed_size<typename std::remove_cv<decltype(
+              legacy_items<target_type, version>::list())>::type>::value,
+          sum_of_size<typename std::remove_cv<decltype(
+              legacy_items<target_type, version>::list())>::type>> {
+  /** type to get list of items of the older layout */
+  using items = legacy_items<target_type, version>;
+
+  /** type of the list of items of the older layout */
+  using list_type = typename std::remove_cv<decltype(items::list())>::type;
+
+  /** true if the size of the older layout is fixed */
+  using fixed = std::integral_constant<
+      bool, all_have_fixed_size<list_type>::value>;
+
+  /** deserialize the ix-th item of the older layout
+   * @tparam ix index of the item
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @param[in] list items of the older layout
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_item(itor_t begin, itor_t end, target_type *obj,
+                                 list_type const &list) {
+    using item = typename std::tuple_element<ix, list_type>::type;
+    using codec_type = typename item_codec<item>::codec_type;
+    using check = std::integral_constant<
+        bool, !fixed::value && is_fixed_size<codec_type>::value>;
+    require_item_size<codec_type>(begin, end, check());
+    return legacy_item<item, order>::deserialize(begin, end, obj,
+                                                 std::get<ix>(list));
+  }
+
+  /** deserialize items of the older layout in order. the items are expanded
+   * in the initializer of the array, which is evaluated from left to right.
+   * @tparam itor_t input iterator
+   * @tparam ix indices of the items
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t deserialize_items(itor_t begin, itor_t end, target_type *obj,
+                                  index_sequence<ix...>) {
+    auto const list = items::list();
+    int const expanded[] = {
+        0, (begin = deserialize_item<ix>(begin, end, obj, list), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** check the range for the older layout of fixed size at once
+   * @tparam itor_t type of the iterator
+   * @param[in] begin top of the range
+   * @param[in] end end of the range
+   */
+  template <typename itor_t>
+  static void require_layout_size(itor_t begin, itor_t end, std::true_type) {
+    require_size(begin, end, sum_of_size<list_type>::value);
+  }
+
+  /** check the range for the older layout of variable size ( do nothing
+   * because each item is checked )
+   * @tparam itor_t type of the iterator
+   */
+  template <typename itor_t>
+  static void require_layout_size(itor_t, itor_t, std::false_type) {}
+
+  /** deserialize obj in the current layout
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the object to deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::true_type) {
+    using deseri = deserializer<target_type, order>;
+    require_item_size<target_type>(begin, end, is_fixed_size<target_type>());
+    return deseri::deserialize(begin, end, obj);
+  }
+
+  /** deserialize obj in the older layout item by item
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the object to deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::false_type) {
+    using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+    require_layout_size(begin, end, fixed());
+    return deserialize_items(begin, end, obj, indices());
+  }
+
+  /** deserialize obj in the layout of the version. the members which are
+   * not in the older layout keep their values.
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in,out] obj pointer to the object to deserialize
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the random access range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    return deserialize(begin, end, obj,
+                       is_current_layout<target_type, version>());
+  }
+};
+
+/** template to select legacy_deserializer by the version at runtime
+ * @tparam target_type target type
+ * @tparam order byte order of serialized data
+ * @tparam version largest version to check
+ * @tparam last true if version is 0
+ */
+template <typename target_type, byte_order order, std::uint32_t version,
+          bool last = version == 0>
+struct version_dispatcher {
+  /** deserialize obj in the layout of the version
+   * @tparam itor_t type of the input iterator
+   * @param[in] v version of the serialized data
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in,out] obj pointer to the object to deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(std::uint32_t v, itor_t begin, itor_t end,
+                            target_type *obj) {
+    using next = version_dispatcher<target_type, order, version - 1>;
+    return v == version ? legacy_deserializer<target_type, version,
+                                              order>::deserialize(begin, end,
+                                                                  obj)
+                        : next::deserialize(v, begin, end, obj);
+  }
+};
+
+/** template to select legacy_deserializer of the version 0
+ * @tparam target_type target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order>
+struct version_dispatcher<target_type, order, 0, true> {
+  /** deserialize obj in the layout of the version 0
+   * @tparam itor_t type of the input iterator
+   * @param[in] v version of the serialized data
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in,out] obj pointer to the object to deserialize
+   * @return iterator pointint to the top of the unused area
+   * @throw unknown_version if v is not 0
+   */
+  template <typename itor_t>
+  static itor_t deserialize(std::uint32_t v, itor_t begin, itor_t end,
+                            target_type *obj) {
+    if (v != 0) {
+      throw unknown_version();
+    }
+    return legacy_deserializer<target_type, 0, order>::deserialize(begin, end,
+                                                                   obj);
+  }
+};
+
+/** template to serialize and deserialize with the version header. 4 bytes of
+ * the version precede the value. the value is serialized in the current
+ * layout, and deserialized in the layout of the version in the header.
+ * @tparam target target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct versioned {
+  /** type to serialize the header */
+  using header_serializer = serializer<std::uint32_t, order>;
+
+  /** type to deserialize the header */
+  using header_deserializer = deserializer<std::uint32_t, order>;
+
+  /** type to serialize the value */
+  using seri = serializer<target, order>;
+
+  /** type to select the deserializer of the version */
+  using dispatcher =
+      version_dispatcher<target, order, schema_version<target>::value>;
+
+  /** byte count of serialized obj with the header
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target const *obj) {
+    return header_serializer::size + seri::serialized_size(obj);
+  }
+
+  /** serialize the current version and obj
+   * @tparam itor output iterator type
+   * @return top of iterator pointing to the top of unused area
+   */
+  template <typename itor>
+  static itor serialize(itor begin, itor end, target const *obj) {
+    std::uint32_t const version = schema_version<target>::value;
+    auto p = header_serializer::serialize(begin, end, &version);
+    return seri::serialize(p, end, obj);
+  }
+
+  /** read the version and deserialize obj in the layout of it
+   * @tparam itor input iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the random access range is too short
+   * @throw unknown_version if the version is newer than the current one
+   */
+  template <typename itor>
+  static itor deserialize(itor begin, itor end, target *obj) {
+    require_size(begin, end, header_deserializer::size);
+    std::uint32_t version;
+    auto p = header_deserializer::deserialize(begin, end, &version);
+    return dispatcher::deserialize(version, p, end, obj);
+  }
+};
+
+/** deserialize obj in the layout of the version. the members which are not
+ * in the older layout keep their values.
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @param[in] version version of the serialized data
+ * @return top of iterator pointing to the top of unused area
+ * @throw unknown_version if the version is newer than the current one
+ */
+template <typename target, typename itor>
+itor deserialize_version(std::uint32_t version, itor begin, itor end,
+                         target *obj) {
+  return versioned<target, byte_order::little>::dispatcher::deserialize(
+      version, begin, end, obj);
+}
+
+/** deserialize obj in the layout of the version with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @param[in] version version of the serialized data
+ * @return top of iterator pointing to the top of unused area
+ * @throw unknown_version if the version is newer than the current one
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize_version(std::uint32_t version, itor begin, itor end,
+                         target *obj) {
+  return versioned<target, order>::dispatcher::deserialize(version, begin, end,
+                                                           obj);
+}
+
+/** serialize with the version header
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <typename target, typename itor>
+itor serialize_versioned(itor begin, itor end, target const *obj) {
+  return versioned<target, byte_order::little>::serialize(begin, end, obj);
+}
+
+/** serialize with the version header with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize_versioned(itor begin, itor end, target const *obj) {
+  return versioned<target, order>::serialize(begin, end, obj);
+}
+
+/** deserialize in the layout of the version in the header
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw unknown_version if the version is newer than the current one
+ */
+template <typename target, typename itor>
+itor deserialize_versioned(itor begin, itor end, target *obj) {
+  return versioned<target, byte_order::little>::deserialize(begin, end, obj);
+}
+
+/** deserialize in the layout of the version in the header with specified
+ * byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw unknown_version if the version is newer than the current one
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize_versioned(itor begin, itor end, target *obj) {
+  return versioned<target, order>::deserialize(begin, end, obj);
+}
+
+} // namespace loleseri
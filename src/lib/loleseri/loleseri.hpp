@@ -1,10 +1,18 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <limits>
+#include <loleseri/byteswap.hpp>
 #include <loleseri/endian.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 /** low level serializer */
 namespace loleseri {
@@ -30,14 +38,20 @@ template <typename t> struct items;
 /** template to serialize
  * @tparam target_type target type
  * @tparam typecat integer to specity category of target type
+ * @tparam order byte order of serialized data
  */
-template <typename target_type, int typecat> struct serializer_impl;
+template <typename target_type, int typecat,
+          byte_order order = byte_order::little>
+struct serializer_impl;
 
 /** template to deserialize
  * @tparam target_type target type
  * @tparam typecat integer to specity category of target type
+ * @tparam order byte order of serialized data
  */
-template <typename target_type, int typecat> struct deserializer_impl;
+template <typename target_type, int typecat,
+          byte_order order = byte_order::little>
+struct deserializer_impl;
 
 /** template to specify type is std::array or not
  * @tparam type target type
@@ -50,6 +64,29 @@ template <class type> struct is_std_array : public std::false_type {};
 template <class type, size_t size>
 struct is_std_array<std::array<type, size>> : public std::true_type {};
 
+/** template to specify type is std::vector or not
+ * @tparam type target type
+ */
+template <class type> struct is_std_vector : public std::false_type {};
+
+/** template to specify type is std::vector or not
+ * @tparam type target type
+ */
+template <class type, class alloc>
+struct is_std_vector<std::vector<type, alloc>> : public std::true_type {};
+
+/** template to specify type is std::basic_string or not
+ * @tparam type target type
+ */
+template <class type> struct is_std_string : public std::false_type {};
+
+/** template to specify type is std::basic_string or not
+ * @tparam type target type
+ */
+template <class char_type, class traits, class alloc>
+struct is_std_string<std::basic_string<char_type, traits, alloc>>
+    : public std::true_type {};
+
 /** template to calculate category value of target type
  * @tparam target_type calculate category value of this type
  */
@@ -59,7 +96,9 @@ template <typename target_type> struct type_category {
     value = (typename std::is_same<bool, target_type>::type() ? 1 : 0) +
             (typename std::is_arithmetic<target_type>::type() ? 2 : 0) +
             (typename is_std_array<target_type>::type() ? 4 : 0) +
-            (typename std::is_array<target_type>::type() ? 8 : 0)
+            (typename std::is_array<target_type>::type() ? 8 : 0) +
+            (typename is_std_vector<target_type>::type() ? 16 : 0) +
+            (typename is_std_string<target_type>::type() ? 32 : 0)
   };
 };
 
@@ -78,6 +117,12 @@ constexpr int std_array = type_category<std::array<int, 1>>::value;
 /** this value means "traditional array" */
 constexpr int array = type_category<int[1]>::value;
 
+/** this value means "std::vector" */
+constexpr int vector = type_category<std::vector<int>>::value;
+
+/** this value means "std::basic_string" */
+constexpr int string = type_category<std::string>::value;
+
 /** type to create constant "other" */
 struct structure {};
 
@@ -87,17 +132,19 @@ constexpr int other = type_category<structure>::value;
 
 /** type to deserialize target type
  * @tparam target_type type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type>
+template <typename target_type, byte_order order = byte_order::little>
 using deserializer =
-    deserializer_impl<target_type, type_category<target_type>::value>;
+    deserializer_impl<target_type, type_category<target_type>::value, order>;
 
 /** type to serialize target type
  * @tparam target_type type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type>
+template <typename target_type, byte_order order = byte_order::little>
 using serializer =
-    serializer_impl<target_type, type_category<target_type>::value>;
+    serializer_impl<target_type, type_category<target_type>::value, order>;
 
 /** template to get data type from pointer to data member */
 template <typename memptr> struct memptr_value;
@@ -108,6 +155,103 @@ template <typename value, typename owner> struct memptr_value<value owner::*> {
   using type = value;
 };
 
+/** template to get how the item of struct or class is serialized. the item
+ * is serialized by serializer<codec_type>. specialize this for the wrappers
+ * of pointers to data members which change the encoding of the item.
+ * @tparam item type of the item in items<T>::list()
+ */
+template <typename item> struct item_codec {
+  /** data type */
+  using value_type = typename memptr_value<item>::type;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = value_type;
+};
+
+/** sequence of indices ( std::index_sequence of C++14 )
+ * @tparam ix indices
+ */
+template <size_t... ix> struct index_sequence {
+  /** this type */
+  using type = index_sequence;
+};
+
+/** template to concatenate two sequences of indices. indices of the second
+ * one are shifted by the size of the first one.
+ * @tparam first first sequence
+ * @tparam second second sequence
+ */
+template <typename first, typename second> struct concat_index_sequence;
+
+/** template to concatenate two sequences of indices
+ * @tparam a indices of the first sequence
+ * @tparam b indices of the second sequence
+ */
+template <size_t... a, size_t... b>
+struct concat_index_sequence<index_sequence<a...>, index_sequence<b...>>
+    : public index_sequence<a..., (sizeof...(a) + b)...> {};
+
+/** template to make the sequence 0, 1, ... count - 1. the sequence is made
+ * from two halves, so the depth of instantiation is log2(count).
+ * @tparam count count of the indices
+ */
+template <size_t count>
+struct make_index_sequence_impl
+    : public concat_index_sequence<
+          typename make_index_sequence_impl<count / 2>::type,
+          typename make_index_sequence_impl<count - count / 2>::type> {};
+
+/** template to make the empty sequence */
+template <> struct make_index_sequence_impl<0> : public index_sequence<> {};
+
+/** template to make the sequence of 0 */
+template <> struct make_index_sequence_impl<1> : public index_sequence<0> {};
+
+/** sequence 0, 1, ... count - 1 ( std::make_index_sequence of C++14 )
+ * @tparam count count of the indices
+ */
+template <size_t count>
+using make_index_sequence = typename make_index_sequence_impl<count>::type;
+
+/** sum of the range of the array. the range is split into two halves, so
+ * the depth of the recursion is log2(e - b).
+ * @param[in] values top of the array
+ * @param[in] b index of the first value
+ * @param[in] e index of the next of the last value
+ * @return sum of the values
+ */
+constexpr size_t sum_of_range(size_t const *values, size_t b, size_t e) {
+  return e - b == 0   ? 0
+         : e - b == 1 ? values[b]
+                      : sum_of_range(values, b, b + (e - b) / 2) +
+                            sum_of_range(values, b + (e - b) / 2, e);
+}
+
+/** array of the values. the last element is a terminator to allow no
+ * values.
+ * @tparam values values
+ */
+template <size_t... values> struct value_array {
+  /** values and the terminator */
+  static constexpr size_t data[sizeof...(values) + 1] = {values..., 0};
+
+  enum {
+    /** sum of the values */
+    sum = sum_of_range(data, 0, sizeof...(values))
+  };
+};
+
+/** values and the terminator */
+template <size_t... values>
+constexpr size_t value_array<values...>::data[sizeof...(values) + 1];
+
+/** template to check that all of the values are true
+ * @tparam values values
+ */
+template <bool... values>
+struct all_of
+    : public std::is_same<all_of<true, values...>, all_of<values..., true>> {};
+
 /** type that calculates the sum of the sizes of values pointed to by template
  * member tuple types
  * @tparam tuple_type target type
@@ -116,24 +260,970 @@ template <typename tuple_type> struct sum_of_size;
 
 /** type that calculates the sum of the sizes of values pointed to by template
  * member tuple types
- * @tparam arg0 first tuple member type
- * @tparam args rest of tuple member types
+ * @tparam args tuple member types
+ */
+template <typename... args> struct sum_of_size<std::tuple<args...>> {
+  enum {
+    value = value_array<
+        serializer<typename item_codec<args>::codec_type>::size...>::sum
+  };
+};
+
+/** type that calculates the sum of the sizes of the items of the indices
+ * @tparam tuple_type target type
+ * @tparam indices index_sequence of the items
  */
-template <typename arg0, typename... args>
-struct sum_of_size<std::tuple<arg0, args...>> {
+template <typename tuple_type, typename indices> struct sum_of_item_size;
 
-  /** data type of arg0 */
-  using arg0_value_type = typename memptr_value<arg0>::type;
+/** type that calculates the sum of the sizes of the items of the indices
+ * @tparam tuple_type target type
+ * @tparam ix indices of the items
+ */
+template <typename tuple_type, size_t... ix>
+struct sum_of_item_size<tuple_type, index_sequence<ix...>> {
   enum {
-    value = serializer<arg0_value_type>::size +
-            sum_of_size<std::tuple<args...>>::value
+    value = value_array<serializer<typename item_codec<
+        typename std::tuple_element<ix, tuple_type>::type>::codec_type>::
+                            size...>::sum
   };
 };
 
-/** type that calculates the sum of the sizes of values pointed to by template
- * member tuple types */
-template <> struct sum_of_size<std::tuple<>> {
-  enum { value = 0 };
+
+/** type of the length of std::vector and std::basic_string in serialized
+ * data */
+using length_type = std::uint32_t;
+
+/** convert the count of the elements of std::vector or std::basic_string to
+ * the length in serialized data
+ * @param[in] count count of the elements
+ * @return the length
+ * @throw std::length_error if the count does not fit in length_type
+ */
+inline length_type length_of(size_t count) {
+  if (std::numeric_limits<length_type>::max() < count) {
+    throw std::length_error("loleseri: too many elements");
+  }
+  return static_cast<length_type>(count);
+}
+
+/** type of the list of items of struct or class
+ * @tparam target_type target type
+ */
+template <typename target_type>
+using item_list_type = typename std::remove_cv<decltype(
+    items<typename std::remove_cv<target_type>::type>::list())>::type;
+
+/** template to specify serialized size of the type is fixed or not
+ * @tparam type target type
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename type, int typecat = type_category<
+                             typename std::remove_cv<type>::type>::value>
+struct is_fixed_size : public std::true_type {};
+
+/** template to check that all types pointed to by template member tuple types
+ * have fixed size
+ * @tparam tuple_type target type
+ */
+template <typename tuple_type> struct all_have_fixed_size;
+
+/** template to check that all types pointed to by template member tuple types
+ * have fixed size
+ * @tparam args tuple member types
+ */
+template <typename... args> struct all_have_fixed_size<std::tuple<args...>> {
+  enum {
+    /** true if all types have fixed size */
+    value = all_of<
+        is_fixed_size<typename item_codec<args>::codec_type>::value...>::value
+  };
+};
+
+/** template to check that all items are serialized as their data types
+ * ( no items in their own encoding like packed() or compact() )
+ * @tparam tuple_type target type
+ */
+template <typename tuple_type> struct all_have_plain_codec;
+
+/** template to check that all items are serialized as their data types
+ * @tparam args tuple member types
+ */
+template <typename... args> struct all_have_plain_codec<std::tuple<args...>> {
+  enum {
+    /** true if codec_type is value_type for all items */
+    value = all_of<std::is_same<typename item_codec<args>::codec_type,
+                                typename item_codec<args>::value_type>::
+                       value...>::value
+  };
+};
+
+/** array of the sizes of values pointed to by template member tuple types
+ * @tparam tuple_type target type
+ */
+template <typename tuple_type> struct sizes_of_items;
+
+/** array of the sizes of values pointed to by template member tuple types
+ * @tparam args tuple member types
+ */
+template <typename... args>
+struct sizes_of_items<std::tuple<args...>>
+    : public value_array<
+          serializer<typename item_codec<args>::codec_type>::size...> {};
+
+/** type that calculates the offset of the ix-th item from the sizes of all
+ * items. the sizes are shared by all indices.
+ * @tparam tuple_type target type
+ * @tparam ix index of the item
+ */
+template <typename tuple_type, size_t ix> struct offset_in_fixed_items {
+  enum { value = sum_of_range(sizes_of_items<tuple_type>::data, 0, ix) };
+};
+
+/** type that calculates the offset of the ix-th item from the sizes of the
+ * first ix items. the items after ix may have variable size.
+ * @tparam tuple_type target type
+ * @tparam ix index of the item
+ */
+template <typename tuple_type, size_t ix>
+struct offset_in_leading_items
+    : public sum_of_item_size<tuple_type, make_index_sequence<ix>> {};
+
+/** type that calculates the offset of the serialized value pointed to by the
+ * ix-th template member tuple type
+ * @tparam tuple_type target type
+ * @tparam ix index of the item
+ */
+template <typename tuple_type, size_t ix>
+struct offset_of_item
+    : public std::conditional<all_have_fixed_size<tuple_type>::value,
+                              offset_in_fixed_items<tuple_type, ix>,
+                              offset_in_leading_items<tuple_type, ix>>::type {
+};
+
+/** size of struct or class is fixed if all items have fixed size
+ * @tparam type target type
+ */
+template <typename type>
+struct is_fixed_size<type, tcat::other>
+    : public std::integral_constant<
+          bool, all_have_fixed_size<item_list_type<type>>::value> {};
+
+/** size of std::array is fixed if the element has fixed size
+ * @tparam type target type
+ */
+template <typename type>
+struct is_fixed_size<type, tcat::std_array>
+    : public is_fixed_size<typename type::value_type> {};
+
+/** size of traditional array is fixed if the element has fixed size
+ * @tparam type target type
+ */
+template <typename type>
+struct is_fixed_size<type, tcat::array>
+    : public is_fixed_size<typename element_type_of_array<type>::type> {};
+
+/** size of std::vector is not fixed
+ * @tparam type target type
+ */
+template <typename type>
+struct is_fixed_size<type, tcat::vector> : public std::false_type {};
+
+/** size of std::basic_string is not fixed
+ * @tparam type target type
+ */
+template <typename type>
+struct is_fixed_size<type, tcat::string> : public std::false_type {};
+
+/** least byte count of serialized value of variable size. used to check the
+ * length of std::vector and std::basic_string before resizing them.
+ * @tparam type target type
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename type, int typecat = type_category<
+                             typename std::remove_cv<type>::type>::value>
+struct min_serialized_size : public std::integral_constant<size_t, 1> {};
+
+/** least byte count of serialized std::vector ( the length only )
+ * @tparam type target type
+ */
+template <typename type>
+struct min_serialized_size<type, tcat::vector>
+    : public std::integral_constant<size_t, sizeof(length_type)> {};
+
+/** least byte count of serialized std::basic_string ( the length only )
+ * @tparam type target type
+ */
+template <typename type>
+struct min_serialized_size<type, tcat::string>
+    : public std::integral_constant<size_t, sizeof(length_type)> {};
+
+/** type that calculates the sum of the sizes of the elements
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ */
+template <typename element_type, size_t count> struct size_of_elements {
+  enum { value = serializer<element_type>::size * count };
+};
+
+/** base of serializers and deserializers. defines "size" and "buffer" only if
+ * the size is fixed.
+ * @tparam fixed true if the size is fixed
+ * @tparam size_type type which has the size as "value"
+ */
+template <bool fixed, typename size_type> struct fixed_size_base {
+  /** byte count of serialized size */
+  enum { size = size_type::value };
+
+  /** type of array of the right size for serialization */
+  using buffer = std::array<std::uint8_t, size>;
+};
+
+/** base of serializers and deserializers of variable size types
+ * @tparam size_type type which has the size as "value" ( not used )
+ */
+template <typename size_type> struct fixed_size_base<false, size_type> {};
+
+/** template to specify type is single byte integer or not
+ * @tparam type target type
+ */
+template <typename type>
+struct is_byte
+    : public std::integral_constant<
+          bool, !std::is_same<bool, type>::value &&
+                    (std::is_integral<type>::value ||
+                     std::is_enum<type>::value) &&
+                    sizeof(type) == 1> {};
+
+/** template to specify type is single byte integer or not
+ * @tparam type target type
+ */
+template <> struct is_byte<void> : public std::false_type {};
+
+/** template to specify iterator points to contiguous bytes or not.
+ * specialize this if your own iterator type is contiguous.
+ * @tparam itor iterator type
+ */
+template <typename itor> struct is_contiguous_byte_iterator {
+  /** type of the value pointed by itor */
+  using value_type = typename std::remove_cv<
+      typename std::iterator_traits<itor>::value_type>::type;
+
+  /** byte type used to check iterators of std::vector and std::basic_string
+   */
+  using byte_type = typename std::conditional<is_byte<value_type>::value,
+                                              value_type, char>::type;
+
+  /** vector of byte_type */
+  using vector_type = std::vector<byte_type>;
+
+  /** string of byte_type */
+  using string_type = std::basic_string<byte_type>;
+
+  enum {
+    /** true if itor points to contiguous bytes */
+    value = is_byte<value_type>::value &&
+            (std::is_same<itor, typename vector_type::iterator>::value ||
+             std::is_same<itor, typename vector_type::const_iterator>::value ||
+             std::is_same<itor, typename string_type::iterator>::value ||
+             std::is_same<itor, typename string_type::const_iterator>::value)
+  };
+};
+
+/** template to specify iterator points to contiguous bytes or not.
+ * @tparam element type pointed by the pointer
+ */
+template <typename element> struct is_contiguous_byte_iterator<element *> {
+  enum {
+    /** true if element is a byte */
+    value = is_byte<typename std::remove_cv<element>::type>::value
+  };
+};
+
+/** template to get byte count of the integer or floating point value which
+ * the type consists of. the value is 0 if the type is neither an integer or
+ * floating point value ( except bool ) nor an array of them.
+ * @tparam type target type
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename type, int typecat = type_category<type>::value>
+struct arithmetic_unit : public std::integral_constant<size_t, 0> {};
+
+/** byte count of integer or floating point value
+ * @tparam type target type
+ */
+template <typename type>
+struct arithmetic_unit<type, tcat::arithmetic>
+    : public std::integral_constant<size_t, sizeof(type)> {};
+
+/** byte count of the element of std::array
+ * @tparam type target type
+ */
+template <typename type>
+struct arithmetic_unit<type, tcat::std_array>
+    : public std::integral_constant<
+          size_t, sizeof(type) == sizeof(typename type::value_type) *
+                                      std::tuple_size<type>::value
+                      ? arithmetic_unit<typename type::value_type>::value
+                      : 0> {};
+
+/** byte count of the element of traditional array
+ * @tparam type target type
+ */
+template <typename type>
+struct arithmetic_unit<type, tcat::array>
+    : public arithmetic_unit<typename element_type_of_array<type>::type> {};
+
+/** template to specify serialized bytes of the type are equal to its bytes in
+ * memory or not. struct or class is not included because the order of the
+ * members can be checked only at runtime. see native_layout.
+ * @tparam type target type
+ * @tparam order byte order of serialized data
+ */
+template <typename type, byte_order order = byte_order::little>
+struct has_native_layout
+    : public std::integral_constant<
+          bool, arithmetic_unit<type>::value == 1 ||
+                    (arithmetic_unit<type>::value != 0 &&
+                     order == byte_order::native)> {};
+
+/** template to check that all types pointed to by template member tuple types
+ * have native layout
+ * @tparam tuple_type target type
+ * @tparam order byte order of serialized data
+ */
+template <typename tuple_type, byte_order order> struct all_have_native_layout;
+
+/** template to check that all types pointed to by template member tuple types
+ * have native layout
+ * @tparam args tuple member types
+ * @tparam order byte order of serialized data
+ */
+template <typename... args, byte_order order>
+struct all_have_native_layout<std::tuple<args...>, order> {
+  enum {
+    /** true if all types have native layout */
+    value = all_of<has_native_layout<typename item_codec<args>::codec_type,
+                                     order>::value...>::value
+  };
+};
+
+/** template to check serialized bytes of struct or class are equal to its
+ * bytes in memory.
+ * @tparam target_type target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, byte_order order = byte_order::little>
+struct native_layout {
+  /** type to get list of items to serialize */
+  using items = loleseri::items<target_type>;
+
+  /** type of the list of items to serialize */
+  using list_type = typename std::remove_cv<decltype(items::list())>::type;
+
+  enum {
+    /** true if the layout can be native. members are not padded, and all of
+     * them have native layout. */
+    candidate =
+        std::conditional<all_have_native_layout<list_type, order>::value,
+                         sum_of_size<list_type>,
+                         std::integral_constant<size_t, 0>>::type::value ==
+        sizeof(target_type)
+  };
+
+  /** check the offset of the ix-th member
+   * @tparam ix index of the item
+   * @param[in] obj pointer to the object
+   * @param[in] list items
+   * @return true if the ix-th item is placed as serialized
+   */
+  template <size_t ix>
+  static bool matches_item(target_type const *obj, list_type const &list) {
+    auto m = std::get<ix>(list);
+    auto top = reinterpret_cast<char const *>(obj);
+    auto item = reinterpret_cast<char const *>(std::addressof(obj->*m));
+    return item - top == static_cast<std::ptrdiff_t>(
+                             offset_of_item<list_type, ix>::value);
+  }
+
+  /** check offsets of all members
+   * @tparam ix indices of the items
+   * @param[in] obj pointer to the object
+   * @return true if all items are placed as serialized
+   */
+  template <size_t... ix>
+  static bool matches(target_type const *obj, index_sequence<ix...>) {
+    auto const list = items::list();
+    bool const results[] = {true, matches_item<ix>(obj, list)...};
+    static_cast<void>(list);
+    for (bool r : results) {
+      if (!r) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** check serialized bytes of struct or class are equal to its bytes in
+   * memory. the result is calculated once and cached.
+   * @param[in] obj pointer to the object ( only its address is used )
+   * @return true if the layout is native
+   */
+  static bool matches(target_type const *obj) {
+    using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+    static bool const result = matches(obj, indices());
+    return result;
+  }
+};
+
+/** copy bytes to contiguous output iterator
+ * @tparam itor_t type of the output iterator
+ * @param[in] begin top of the output iterator
+ * @param[in] src top of the bytes to copy
+ * @param[in] size byte count to copy
+ * @return iterator which points to the begin of the unused area
+ */
+template <typename itor_t>
+itor_t copy_bytes_to(itor_t begin, void const *src, size_t size) {
+  std::memcpy(static_cast<void *>(std::addressof(*begin)), src, size);
+  return begin + size;
+}
+
+/** copy bytes from contiguous input iterator
+ * @tparam itor_t type of the input iterator
+ * @param[in] begin top of the input iterator
+ * @param[out] dest top of the area to write
+ * @param[in] size byte count to copy
+ * @return iterator pointint to the top of the unused area
+ */
+template <typename itor_t>
+itor_t copy_bytes_from(itor_t begin, void *dest, size_t size) {
+  std::memcpy(dest, static_cast<void const *>(std::addressof(*begin)), size);
+  return begin + size;
+}
+
+/** copy integers to contiguous output iterator with reversing byte order
+ * @tparam unit byte count of the integer
+ * @tparam itor_t type of the output iterator
+ * @param[in] begin top of the output iterator
+ * @param[in] src top of the integers to copy
+ * @param[in] size byte count to copy
+ * @return iterator which points to the begin of the unused area
+ */
+template <size_t unit, typename itor_t>
+itor_t copy_swapped_to(itor_t begin, void const *src, size_t size) {
+  copy_swapped<unit>(static_cast<void *>(std::addressof(*begin)), src,
+                     size / unit);
+  return begin + size;
+}
+
+/** copy integers from contiguous input iterator with reversing byte order
+ * @tparam unit byte count of the integer
+ * @tparam itor_t type of the input iterator
+ * @param[in] begin top of the input iterator
+ * @param[out] dest top of the area to write
+ * @param[in] size byte count to copy
+ * @return iterator pointint to the top of the unused area
+ */
+template <size_t unit, typename itor_t>
+itor_t copy_swapped_from(itor_t begin, void *dest, size_t size) {
+  copy_swapped<unit>(dest, static_cast<void const *>(std::addressof(*begin)),
+                     size / unit);
+  return begin + size;
+}
+
+/** exception thrown if the buffer is too short to serialize or deserialize */
+class buffer_overrun : public std::out_of_range {
+public:
+  /** create exception */
+  buffer_overrun() : std::out_of_range("loleseri: buffer is too short") {}
+};
+
+/** check that the random access iterator range is long enough
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] size required byte count
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename itor_t>
+void require_size(itor_t begin, itor_t end, size_t size,
+                  std::random_access_iterator_tag) {
+  using diff_t = typename std::iterator_traits<itor_t>::difference_type;
+  if (end - begin < static_cast<diff_t>(size)) {
+    throw buffer_overrun();
+  }
+}
+
+/** check that the forward iterator range is long enough. the range is
+ * walked at most size steps, so the check costs no more than reading it.
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] size required byte count
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename itor_t>
+void require_size(itor_t begin, itor_t end, size_t size,
+                  std::forward_iterator_tag) {
+  for (size_t i = 0; i < size; ++i, ++begin) {
+    if (begin == end) {
+      throw buffer_overrun();
+    }
+  }
+}
+
+/** check that the single pass input iterator range is long enough ( do
+ * nothing because the range cannot be walked twice. deserializers compare
+ * each byte with the end instead. )
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] size required byte count
+ */
+template <typename itor_t>
+void require_size(itor_t begin, itor_t end, size_t size,
+                  std::input_iterator_tag) {}
+
+/** check that the output iterator range is long enough ( do nothing because
+ * the range is unbounded like std::back_insert_iterator )
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] size required byte count
+ */
+template <typename itor_t>
+void require_size(itor_t begin, itor_t end, size_t size,
+                  std::output_iterator_tag) {}
+
+/** check that the iterator range is long enough
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] size required byte count
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename itor_t>
+void require_size(itor_t begin, itor_t end, size_t size) {
+  using category_t = typename std::iterator_traits<itor_t>::iterator_category;
+  require_size(begin, end, size, category_t());
+}
+
+/** check that the random access iterator range is long enough for the values
+ * without overflow of count * unit
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] count count of the values
+ * @param[in] unit least byte count of a value
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename itor_t>
+void require_count(itor_t begin, itor_t end, size_t count, size_t unit,
+                   std::random_access_iterator_tag) {
+  auto const rest = end - begin;
+  if (rest < 0 || static_cast<size_t>(rest) / unit < count) {
+    throw buffer_overrun();
+  }
+}
+
+/** check that the iterator range is long enough for the values ( do nothing
+ * because the length of the range cannot be measured )
+ * @tparam itor_t type of the iterator
+ * @tparam category_t category of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] count count of the values
+ * @param[in] unit least byte count of a value
+ */
+template <typename itor_t, typename category_t>
+void require_count(itor_t begin, itor_t end, size_t count, size_t unit,
+                   category_t) {}
+
+/** check that the iterator range is long enough for the values
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] count count of the values
+ * @param[in] unit least byte count of a value
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename itor_t>
+void require_count(itor_t begin, itor_t end, size_t count, size_t unit) {
+  using category_t = typename std::iterator_traits<itor_t>::iterator_category;
+  require_count(begin, end, count, unit, category_t());
+}
+
+/** check that the iterator range is long enough for the value of fixed size
+ * which is a part of variable size value
+ * @tparam type type of the value
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename type, typename itor_t>
+void require_item_size(itor_t begin, itor_t end, std::true_type) {
+  require_size(begin, end, serializer<type>::size);
+}
+
+/** check that the iterator range is long enough for the value ( do nothing
+ * because the value checks the range by itself, or the value is a part of
+ * fixed size value which is checked at once )
+ * @tparam type type of the value
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ */
+template <typename type, typename itor_t>
+void require_item_size(itor_t begin, itor_t end, std::false_type) {}
+
+/** values to specify how to copy arrays */
+namespace copy_method {
+
+/** this value means "serialize element by element" */
+constexpr int element_by_element = 0;
+
+/** this value means "copy whole array with memcpy" */
+constexpr int block = 1;
+
+/** this value means "copy whole array with reversing byte order" */
+constexpr int byteswap = 2;
+} // namespace copy_method
+
+/** template to choose how to copy arrays
+ * @tparam type type of the array
+ * @tparam order byte order of serialized data
+ * @tparam itor_t type of the iterator
+ */
+template <typename type, byte_order order, typename itor_t>
+struct array_copy_method {
+  /** byte count of the element */
+  using unit = arithmetic_unit<type>;
+
+  enum {
+    /** true if whole array can be copied at once */
+    bulk = sizeof(type) != 0 && is_contiguous_byte_iterator<itor_t>::value,
+
+    /** method to copy */
+    value = !bulk ? copy_method::element_by_element
+                  : has_native_layout<type, order>::value
+                        ? copy_method::block
+                        : (unit::value == 2 || unit::value == 4 ||
+                           unit::value == 8)
+                              ? copy_method::byteswap
+                              : copy_method::element_by_element
+  };
+};
+
+/** template to serialize elements of contiguous containers
+ * @tparam element_type type of the element
+ * @tparam order byte order of serialized data
+ */
+template <typename element_type, byte_order order> struct sequence_serializer {
+  /** type to serialize the element */
+  using element_serializer = serializer<element_type, order>;
+
+  /** byte count of serialized elements
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return byte count
+   */
+  static size_t serialized_size(element_type const *first, size_t count) {
+    return serialized_size(first, count, is_fixed_size<element_type>());
+  }
+
+  /** byte count of serialized elements of fixed size
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return byte count
+   */
+  static size_t serialized_size(element_type const *first, size_t count,
+                                std::true_type) {
+    return element_serializer::size * count;
+  }
+
+  /** byte count of serialized elements of variable size
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return byte count
+   */
+  static size_t serialized_size(element_type const *first, size_t count,
+                                std::false_type) {
+    size_t r = 0;
+    for (size_t i = 0; i < count; ++i) {
+      r += element_serializer::serialized_size(first + i);
+    }
+    return r;
+  }
+
+  /** serialize elements element by element
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  serialize(itor_t begin, itor_t end, element_type const *first, size_t count,
+            std::integral_constant<int, copy_method::element_by_element>) {
+    auto p = begin;
+    for (size_t i = 0; i < count; ++i) {
+      p = element_serializer::serialize(p, end, first + i);
+    }
+    return p;
+  }
+
+  /** serialize elements with single memcpy
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, element_type const *first,
+                          size_t count,
+                          std::integral_constant<int, copy_method::block>) {
+    if (count == 0) {
+      return begin;
+    }
+    return copy_bytes_to(begin, first, count * sizeof(element_type));
+  }
+
+  /** serialize elements with reversing byte order of all elements at once
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, element_type const *first,
+                          size_t count,
+                          std::integral_constant<int, copy_method::byteswap>) {
+    if (count == 0) {
+      return begin;
+    }
+    constexpr size_t unit = arithmetic_unit<element_type>::value;
+    return copy_swapped_to<unit>(begin, first, count * sizeof(element_type));
+  }
+
+  /** serialize elements
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, element_type const *first,
+                          size_t count) {
+    using method = array_copy_method<element_type, order, itor_t>;
+    return serialize(begin, end, first, count,
+                     std::integral_constant<int, method::value>());
+  }
+};
+
+/** template to deserialize elements of contiguous containers
+ * @tparam element_type type of the element
+ * @tparam order byte order of serialized data
+ */
+template <typename element_type, byte_order order>
+struct sequence_deserializer {
+  /** type to deserialize the element */
+  using element_deserializer = deserializer<element_type, order>;
+
+  /** deserialize elements element by element
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  deserialize(itor_t begin, itor_t end, element_type *first, size_t count,
+              std::integral_constant<int, copy_method::element_by_element>) {
+    auto p = begin;
+    for (size_t i = 0; i < count; ++i) {
+      p = element_deserializer::deserialize(p, end, first + i);
+    }
+    return p;
+  }
+
+  /** deserialize elements with single memcpy
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, element_type *first,
+                            size_t count,
+                            std::integral_constant<int, copy_method::block>) {
+    if (count == 0) {
+      return begin;
+    }
+    return copy_bytes_from(begin, first, count * sizeof(element_type));
+  }
+
+  /** deserialize elements with reversing byte order of all elements at once
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  deserialize(itor_t begin, itor_t end, element_type *first, size_t count,
+              std::integral_constant<int, copy_method::byteswap>) {
+    if (count == 0) {
+      return begin;
+    }
+    constexpr size_t unit = arithmetic_unit<element_type>::value;
+    return copy_swapped_from<unit>(begin, first, count * sizeof(element_type));
+  }
+
+  /** check that the iterator range is long enough for elements of fixed size
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the elements
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static void require(itor_t begin, itor_t end, size_t count, std::true_type) {
+    constexpr size_t unit = serializer<element_type>::size;
+    if (unit != 0) {
+      require_count(begin, end, count, unit);
+    }
+  }
+
+  /** check that the iterator range is long enough for the least bytes of
+   * elements of variable size. each element checks the rest by itself.
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the elements
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static void require(itor_t begin, itor_t end, size_t count,
+                      std::false_type) {
+    require_count(begin, end, count, min_serialized_size<element_type>::value);
+  }
+
+  /** check that the iterator range is long enough for elements
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the elements
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static void require(itor_t begin, itor_t end, size_t count) {
+    require(begin, end, count, is_fixed_size<element_type>());
+  }
+
+  /** deserialize elements
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first element
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, element_type *first,
+                            size_t count) {
+    using method = array_copy_method<element_type, order, itor_t>;
+    return deserialize(begin, end, first, count,
+                       std::integral_constant<int, method::value>());
+  }
+
+  /** byte count of the elements to read at once into the container if the
+   * length of the range cannot be measured */
+  enum { growth_bytes = 4096 };
+
+  /** deserialize elements into the container. the length of the range is
+   * checked before the container is resized.
+   * @tparam container_t std::vector or std::basic_string
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj container to write the elements
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename container_t, typename itor_t>
+  static itor_t fill(itor_t begin, itor_t end, container_t *obj, size_t count,
+                     std::random_access_iterator_tag) {
+    require(begin, end, count);
+    obj->resize(count);
+    if (count == 0) {
+      return begin;
+    }
+    return deserialize(begin, end, &(*obj)[0], count);
+  }
+
+  /** deserialize elements into the container. the length of the range
+   * cannot be measured, so the container grows as the elements are read
+   * and a broken count cannot request a huge allocation at once. reading
+   * an element throws at the end of the range.
+   * @tparam container_t std::vector or std::basic_string
+   * @tparam itor_t type of the input iterator
+   * @tparam category_t category of the iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj container to write the elements
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename container_t, typename itor_t, typename category_t>
+  static itor_t fill(itor_t begin, itor_t end, container_t *obj, size_t count,
+                     category_t) {
+    constexpr size_t step = sizeof(element_type) < growth_bytes
+                                ? growth_bytes / sizeof(element_type)
+                                : 1;
+    obj->clear();
+    auto p = begin;
+    for (size_t done = 0; done < count;) {
+      size_t const n = count - done < step ? count - done : step;
+      obj->resize(done + n);
+      p = deserialize(p, end, &(*obj)[done], n);
+      done += n;
+    }
+    return p;
+  }
+
+  /** deserialize elements into the container
+   * @tparam container_t std::vector or std::basic_string
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj container to write the elements
+   * @param[in] count count of the elements
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename container_t, typename itor_t>
+  static itor_t fill(itor_t begin, itor_t end, container_t *obj,
+                     size_t count) {
+    using category_t = typename std::iterator_traits<itor_t>::iterator_category;
+    return fill(begin, end, obj, count, category_t());
+  }
 };
 
 /** serialized size in bytes
@@ -144,6 +1234,15 @@ template <typename target> constexpr size_t serialized_size() {
   return serializer<target>::size;
 }
 
+/** serialized size of the object in bytes. available for variable size types.
+ * @tparam target target type
+ * @param[in] obj object to serialize
+ * @return serialize size in bytes
+ */
+template <typename target> size_t serialized_size(target const &obj) {
+  return serializer<target>::serialized_size(&obj);
+}
+
 /** serialize
  * @tparam target target type
  * @tparam itor output iterator type
@@ -154,6 +1253,17 @@ itor serialize(itor begin, itor end, target const *obj) {
   return serializer<target>::serialize(begin, end, obj);
 }
 
+/** serialize with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize(itor begin, itor end, target const *obj) {
+  return serializer<target, order>::serialize(begin, end, obj);
+}
+
 /** deserialize
  * @tparam target target type
  * @tparam itor input iterator type
@@ -164,6 +1274,17 @@ itor deserialize(itor begin, itor end, target *obj) {
   return deserializer<target>::deserialize(begin, end, obj);
 }
 
+/** deserialize with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize(itor begin, itor end, target *obj) {
+  return deserializer<target, order>::deserialize(begin, end, obj);
+}
+
 /** deserialize
  * @tparam target target type
  * @tparam itor input iterator type
@@ -174,13 +1295,275 @@ target deserialize(itor begin, itor end) {
   return deserializer<target>::deserialize(begin, end);
 }
 
+/** deserialize with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return deserialized object
+ */
+template <byte_order order, typename target, typename itor>
+target deserialize(itor begin, itor end) {
+  return deserializer<target, order>::deserialize(begin, end);
+}
+
+/** template to serialize and deserialize with checking the length of the
+ * range. fixed size values are checked only once before serialization.
+ * forward iterator ranges are walked to check, and single pass input
+ * iterators are checked byte by byte while reading.
+ * @tparam target target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct bounded {
+  /** type to serialize */
+  using seri = serializer<target, order>;
+
+  /** type to deserialize */
+  using deseri = deserializer<target, order>;
+
+  /** serialize
+   * @tparam itor output iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor>
+  static itor serialize(itor begin, itor end, target const *obj) {
+    require_size(begin, end, seri::serialized_size(obj));
+    return seri::serialize(begin, end, obj);
+  }
+
+  /** deserialize value of fixed size
+   * @tparam itor input iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor>
+  static itor deserialize(itor begin, itor end, target *obj, std::true_type) {
+    require_size(begin, end, seri::size);
+    return deseri::deserialize(begin, end, obj);
+  }
+
+  /** deserialize value of variable size. deserializers of variable size
+   * values always check the length of the range.
+   * @tparam itor input iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor>
+  static itor deserialize(itor begin, itor end, target *obj, std::false_type) {
+    return deseri::deserialize(begin, end, obj);
+  }
+
+  /** deserialize
+   * @tparam itor input iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor>
+  static itor deserialize(itor begin, itor end, target *obj) {
+    return deserialize(begin, end, obj, is_fixed_size<target>());
+  }
+};
+
+/** serialize with checking the length of the range
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor>
+itor serialize_bounded(itor begin, itor end, target const *obj) {
+  return bounded<target, byte_order::little>::serialize(begin, end, obj);
+}
+
+/** serialize with checking the length of the range with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize_bounded(itor begin, itor end, target const *obj) {
+  return bounded<target, order>::serialize(begin, end, obj);
+}
+
+/** deserialize with checking the length of the range
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor>
+itor deserialize_bounded(itor begin, itor end, target *obj) {
+  return bounded<target, byte_order::little>::deserialize(begin, end, obj);
+}
+
+/** deserialize with checking the length of the range with specified byte
+ * order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize_bounded(itor begin, itor end, target *obj) {
+  return bounded<target, order>::deserialize(begin, end, obj);
+}
+
+/** deserialize with checking the length of the range
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return deserialized object
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor>
+target deserialize_bounded(itor begin, itor end) {
+  target obj;
+  bounded<target, byte_order::little>::deserialize(begin, end, &obj);
+  return obj;
+}
+
+/** deserialize with checking the length of the range with specified byte
+ * order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return deserialized object
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename itor>
+target deserialize_bounded(itor begin, itor end) {
+  target obj;
+  bounded<target, order>::deserialize(begin, end, &obj);
+  return obj;
+}
+
+/** template to append serialized objects to std::vector. the vector is
+ * resized once and the objects are serialized through a raw pointer.
+ * @tparam target target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct appender {
+  /** type to serialize */
+  using seri = serializer<target, order>;
+
+  /** byte count of the serialized objects of fixed size
+   * @param[in] first pointer to the first object
+   * @param[in] count count of the objects
+   * @return byte count
+   */
+  static size_t size_of(target const *first, size_t count, std::true_type) {
+    return seri::size * count;
+  }
+
+  /** byte count of the serialized objects of variable size
+   * @param[in] first pointer to the first object
+   * @param[in] count count of the objects
+   * @return byte count
+   */
+  static size_t size_of(target const *first, size_t count, std::false_type) {
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i) {
+      size += seri::serialized_size(first + i);
+    }
+    return size;
+  }
+
+  /** append serialized objects
+   * @tparam byte_type type of the element of the vector
+   * @tparam allocator type of the allocator of the vector
+   * @param[in,out] out vector to append
+   * @param[in] first pointer to the first object
+   * @param[in] count count of the objects
+   * @return byte count appended
+   */
+  template <typename byte_type, typename allocator>
+  static size_t append(std::vector<byte_type, allocator> &out,
+                       target const *first, size_t count) {
+    static_assert(is_byte<byte_type>::value,
+                  "element of the vector should be a byte");
+    size_t const top = out.size();
+    size_t const size = size_of(first, count, is_fixed_size<target>());
+    out.resize(top + size);
+    auto p = out.data() + top;
+    auto const end = p + size;
+    for (size_t i = 0; i < count; ++i) {
+      p = seri::serialize(p, end, first + i);
+    }
+    return size;
+  }
+};
+
+/** append serialized object to std::vector
+ * @tparam target target type
+ * @tparam byte_type type of the element of the vector
+ * @tparam allocator type of the allocator of the vector
+ * @param[in,out] out vector to append
+ * @param[in] obj object to serialize
+ * @return byte count appended
+ */
+template <typename target, typename byte_type, typename allocator>
+size_t append(std::vector<byte_type, allocator> &out, target const &obj) {
+  return appender<target, byte_order::little>::append(out, &obj, 1);
+}
+
+/** append serialized object to std::vector with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam byte_type type of the element of the vector
+ * @tparam allocator type of the allocator of the vector
+ * @param[in,out] out vector to append
+ * @param[in] obj object to serialize
+ * @return byte count appended
+ */
+template <byte_order order, typename target, typename byte_type,
+          typename allocator>
+size_t append(std::vector<byte_type, allocator> &out, target const &obj) {
+  return appender<target, order>::append(out, &obj, 1);
+}
+
+/** append serialized objects to std::vector
+ * @tparam target target type
+ * @tparam byte_type type of the element of the vector
+ * @tparam allocator type of the allocator of the vector
+ * @param[in,out] out vector to append
+ * @param[in] first pointer to the first object
+ * @param[in] count count of the objects
+ * @return byte count appended
+ */
+template <typename target, typename byte_type, typename allocator>
+size_t append(std::vector<byte_type, allocator> &out, target const *first,
+              size_t count) {
+  return appender<target, byte_order::little>::append(out, first, count);
+}
+
+/** append serialized objects to std::vector with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam byte_type type of the element of the vector
+ * @tparam allocator type of the allocator of the vector
+ * @param[in,out] out vector to append
+ * @param[in] first pointer to the first object
+ * @param[in] count count of the objects
+ * @return byte count appended
+ */
+template <byte_order order, typename target, typename byte_type,
+          typename allocator>
+size_t append(std::vector<byte_type, allocator> &out, target const *first,
+              size_t count) {
+  return appender<target, order>::append(out, first, count);
+}
+
 } // namespace loleseri
 
 /** type to serialize integer or floating point type
  * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::serializer_impl<target_type_, loleseri::tcat::arithmetic> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::arithmetic,
+                                 order> {
 
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
@@ -191,6 +1574,12 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::arithmetic> {
   /** type of array of the right size for serialization */
   using buffer = std::array<std::uint8_t, size>;
 
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj) { return size; }
+
   /** serialize obj to output iterator
    * @tparam itor_t type of the output iterator
    * @param[in] begin top of the output iterator
@@ -200,20 +1589,43 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::arithmetic> {
    */
   template <typename itor_t>
   static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
-#if LOLESERI_LITTLE_ENDIAN
     auto p = reinterpret_cast<std::uint8_t const *>(obj);
-    return std::copy(p, p + sizeof(target_type), begin);
-#else
-#error "you should write something here."
-#endif
+    return write_bytes(begin, p, has_native_layout<target_type, order>());
+  }
+
+  /** write bytes of the value in the same order
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] p top of the bytes of the value
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t write_bytes(itor_t begin, std::uint8_t const *p,
+                            std::true_type) {
+    return std::copy(p, p + size, begin);
+  }
+
+  /** write bytes of the value in reverse order
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] p top of the bytes of the value
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t write_bytes(itor_t begin, std::uint8_t const *p,
+                            std::false_type) {
+    using reversed = std::reverse_iterator<std::uint8_t const *>;
+    return std::copy(reversed(p + size), reversed(p), begin);
   }
 };
 
 /** type to serialize bool
  * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::serializer_impl<target_type_, loleseri::tcat::boolean> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::boolean,
+                                 order> {
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
 
@@ -223,6 +1635,12 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::boolean> {
   /** type of array of the right size for serialization */
   using buffer = std::array<std::uint8_t, size>;
 
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj) { return size; }
+
   /** serialize obj to output iterator
    * @tparam itor_t type of the output iterator
    * @param[in] begin top of the output iterator
@@ -233,15 +1651,19 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::boolean> {
   template <typename itor_t>
   static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
     *begin = *obj ? 1 : 0;
-    return std::next(begin);
+    return ++begin;
   }
 };
 
 /** type to serialize struct or class
  * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::serializer_impl<target_type_, loleseri::tcat::other> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::other, order>
+    : public loleseri::fixed_size_base<
+          loleseri::is_fixed_size<target_type_>::value,
+          loleseri::sum_of_size<loleseri::item_list_type<target_type_>>> {
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
 
@@ -251,57 +1673,136 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::other> {
   /** type of the list of items to serialize */
   using list_type = typename std::remove_cv<decltype(items::list())>::type;
 
-  /** byte count of serialized size */
-  enum { size = sum_of_size<list_type>::value };
+  /** base class which defines size and buffer if the size is fixed */
+  using base = fixed_size_base<is_fixed_size<target_type>::value,
+                               sum_of_size<list_type>>;
 
-  /** type of array of the right size for serialization */
-  using buffer = std::array<std::uint8_t, size>;
+  /** indices of the items */
+  using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+
+  /** serialize the ix-th item
+   * @tparam ix index of the item
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t serialize_item(itor_t begin, itor_t end, target_type const *obj,
+                               list_type const &list) {
+    auto m = std::get<ix>(list);
+    using item_type = typename item_codec<decltype(m)>::codec_type;
+    using seri = loleseri::serializer<item_type, order>;
+    return seri::serialize(begin, end, &(obj->*m));
+  }
+
+  /** serialize items in order. the items are expanded in the initializer
+   * of the array, which is evaluated from left to right.
+   * @tparam itor_t type of the output iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t serialize_items(itor_t begin, itor_t end,
+                                target_type const *obj,
+                                index_sequence<ix...>) {
+    auto const list = items::list();
+    int const expanded[] = {
+        0, (begin = serialize_item<ix>(begin, end, obj, list), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
 
-  /** template to serialize part of struct or class
-   * @tparam ix skip first ix items
-   * @tparam bool true if nothing to do more
+  /** byte count of the serialized ix-th item
+   * @tparam ix index of the item
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return byte count
    */
-  template <size_t ix, bool end_of_tuple> struct partial_serializer;
+  template <size_t ix>
+  static size_t item_size(target_type const *obj, list_type const &list) {
+    auto m = std::get<ix>(list);
+    using item_type = typename item_codec<decltype(m)>::codec_type;
+    using seri = loleseri::serializer<item_type, order>;
+    return seri::serialized_size(&(obj->*m));
+  }
 
-  /** template to terminate serialization
-   * @tparam ix skip first ix items
+  /** byte count of serialized items
+   * @tparam ix indices of the items
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
    */
-  template <size_t ix> struct partial_serializer<ix, true> {
-    /** returns begin ( there is nothing to serialize )
-     * @param[in] begin top of the output iterator
-     * @param[in] end end of the output iterator
-     * @param[in] obj pointer to the object to serialize
-     * @return iterator which points to the begin of the unused area
-     */
-    template <typename itor_t>
-    static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
-      return begin;
+  template <size_t... ix>
+  static size_t items_size(target_type const *obj, index_sequence<ix...>) {
+    auto const list = items::list();
+    size_t const sizes[] = {0, item_size<ix>(obj, list)...};
+    static_cast<void>(list);
+    size_t r = 0;
+    for (size_t s : sizes) {
+      r += s;
     }
-  };
+    return r;
+  }
+
+  /** byte count of serialized obj of fixed size
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj, std::true_type) {
+    return base::size;
+  }
+
+  /** byte count of serialized obj of variable size
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj, std::false_type) {
+    return items_size(obj, indices());
+  }
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj) {
+    return serialized_size(obj, is_fixed_size<target_type>());
+  }
+
+  /** serialize obj to output iterator item by item
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj,
+                          std::false_type) {
+    return serialize_items(begin, end, obj, indices());
+  }
 
-  /** template to serialize part of struct or class
-   * @tparam ix skip first ix items
+  /** serialize obj to contiguous output iterator with single memcpy if the
+   * layout of target_type is native
+   * @tparam itor_t type of the output iterator
    * @param[in] begin top of the output iterator
    * @param[in] end end of the output iterator
    * @param[in] obj pointer to the object to serialize
    * @return iterator which points to the begin of the unused area
    */
-  template <size_t ix> struct partial_serializer<ix, false> {
-    /** serialize obj to output iterator
-     * @tparam itor_t type of the output iterator
-     * @param[in] begin top of the output iterator
-     * @param[in] end end of the output iterator
-     * @param[in] obj pointer to the object to serialize
-     * @return iterator which points to the begin of the unused area
-     */
-    template <typename itor_t>
-    static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
-      constexpr size_t tc = std::tuple_size<list_type>::value;
-      auto m = std::get<ix>(items::list());
-      auto p = loleseri::serialize(begin, end, &(obj->*m));
-      return partial_serializer<ix + 1, (tc <= ix + 1)>::serialize(p, end, obj);
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj,
+                          std::true_type) {
+    if (native_layout<target_type, order>::matches(obj)) {
+      return copy_bytes_to(begin, obj, base::size);
     }
-  };
+    return serialize(begin, end, obj, std::false_type());
+  }
 
   /** serialize obj to output iterator
    * @tparam itor_t type of the output iterator
@@ -312,29 +1813,51 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::other> {
    */
   template <typename itor_t>
   static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
-    constexpr size_t tc = std::tuple_size<list_type>::value;
-    return partial_serializer<0, (tc <= 0)>::serialize(begin, end, obj);
+    using bulk = std::integral_constant<
+        bool, native_layout<target_type, order>::candidate &&
+                  is_contiguous_byte_iterator<itor_t>::value>;
+    return serialize(begin, end, obj, bulk());
   }
 };
 
 /** type to serialize std::array
  * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::serializer_impl<target_type_, loleseri::tcat::std_array> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::std_array,
+                                 order>
+    : public loleseri::fixed_size_base<
+          loleseri::is_fixed_size<target_type_>::value,
+          loleseri::size_of_elements<
+              typename target_type_::value_type,
+              std::tuple_size<typename std::remove_cv<target_type_>::type>::
+                  value>> {
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
 
-  /** byte count of serialized size */
+  /** element type of std::array "target_type" */
+  using element_type = typename target_type::value_type;
+
   enum {
-    size = serializer<typename target_type::value_type>::size *
-           std::tuple_size<target_type>::value
+    /** element count of std::array "target_type" */
+    element_count = std::tuple_size<target_type>::value
   };
 
-  /** type of array of the right size for serialization */
-  using buffer = std::array<std::uint8_t, size>;
+  /** base class which defines size and buffer if the size is fixed */
+  using base = fixed_size_base<is_fixed_size<target_type>::value,
+                               size_of_elements<element_type, element_count>>;
 
-  /** serialize obj to output iterator
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj) {
+    using sequence = sequence_serializer<element_type, order>;
+    return sequence::serialized_size(obj->data(), element_count);
+  }
+
+  /** serialize obj to output iterator element by element
    * @tparam itor_t type of the output iterator
    * @param[in] begin top of the output iterator
    * @param[in] end end of the output iterator
@@ -342,34 +1865,144 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::std_array> {
    * @return iterator which points to the begin of the unused area
    */
   template <typename itor_t>
-  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
+  static itor_t
+  serialize(itor_t begin, itor_t end, target_type const *obj,
+            std::integral_constant<int, copy_method::element_by_element>) {
     auto p = begin;
+    using seri = loleseri::serializer<element_type, order>;
     for (auto const &e : *obj) {
-      p = loleseri::serialize(p, end, &e);
+      p = seri::serialize(p, end, &e);
     }
     return p;
   }
+
+  /** serialize obj to contiguous output iterator with single memcpy
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj,
+                          std::integral_constant<int, copy_method::block>) {
+    return copy_bytes_to(begin, obj, base::size);
+  }
+
+  /** serialize obj to contiguous output iterator with reversing byte order of
+   * all elements at once
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  serialize(itor_t begin, itor_t end, target_type const *obj,
+            std::integral_constant<int, copy_method::byteswap>) {
+    constexpr size_t unit = arithmetic_unit<target_type>::value;
+    return copy_swapped_to<unit>(begin, obj, base::size);
+  }
+
+  /** serialize obj to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
+    using method = array_copy_method<target_type, order, itor_t>;
+    return serialize(begin, end, obj,
+                     std::integral_constant<int, method::value>());
+  }
 };
 
 /** type to serialize traditional array
  * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::serializer_impl<target_type_, loleseri::tcat::array> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::array, order>
+    : public loleseri::fixed_size_base<
+          loleseri::is_fixed_size<target_type_>::value,
+          loleseri::size_of_elements<
+              typename loleseri::element_type_of_array<
+                  typename std::remove_cv<target_type_>::type>::type,
+              std::extent<target_type_>::value>> {
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
 
   /** element type of traditional array "target_type" */
   using element_type = typename element_type_of_array<target_type>::type;
 
-  /** byte count of serialized size */
   enum {
-    element_count = size_of_array(target_type{}),
-    size = serializer<element_type>::size * element_count
+    /** element count of traditional array "target_type" */
+    element_count = std::extent<target_type>::value
   };
 
-  /** type of array of the right size for serialization */
-  using buffer = std::array<std::uint8_t, size>;
+  /** base class which defines size and buffer if the size is fixed */
+  using base = fixed_size_base<is_fixed_size<target_type>::value,
+                               size_of_elements<element_type, element_count>>;
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target_type const *obj) {
+    using sequence = sequence_serializer<element_type, order>;
+    return sequence::serialized_size(*obj, element_count);
+  }
+
+  /** serialize obj to output iterator element by element
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  serialize(itor_t begin, itor_t end, target_type const *obj,
+            std::integral_constant<int, copy_method::element_by_element>) {
+    auto p = begin;
+    using seri = loleseri::serializer<element_type, order>;
+    for (auto const &e : *obj) {
+      p = seri::serialize(p, end, &e);
+    }
+    return p;
+  }
+
+  /** serialize obj to contiguous output iterator with single memcpy
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj,
+                          std::integral_constant<int, copy_method::block>) {
+    return copy_bytes_to(begin, obj, base::size);
+  }
+
+  /** serialize obj to contiguous output iterator with reversing byte order of
+   * all elements at once
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  serialize(itor_t begin, itor_t end, target_type const *obj,
+            std::integral_constant<int, copy_method::byteswap>) {
+    constexpr size_t unit = arithmetic_unit<target_type>::value;
+    return copy_swapped_to<unit>(begin, obj, base::size);
+  }
 
   /** serialize obj to output iterator
    * @tparam itor_t type of the output iterator
@@ -380,19 +2013,19 @@ struct loleseri::serializer_impl<target_type_, loleseri::tcat::array> {
    */
   template <typename itor_t>
   static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
-    auto p = begin;
-    for (auto const &e : *obj) {
-      p = loleseri::serialize(p, end, &e);
-    }
-    return p;
+    using method = array_copy_method<target_type, order, itor_t>;
+    return serialize(begin, end, obj,
+                     std::integral_constant<int, method::value>());
   }
 };
 
 /** type to deserialize integer or floating point type
  * @tparam target_type_ type of the value to deserialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::deserializer_impl<target_type_, loleseri::tcat::arithmetic> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::arithmetic,
+                                   order> {
 
   /** type of the value to deserialize */
   using target_type = typename std::remove_cv<target_type_>::type;
@@ -400,7 +2033,7 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::arithmetic> {
   /** byte count of serialized size */
   enum { size = sizeof(target_type) };
 
-  /** deserialize obj from input iterator
+  /** deserialize obj from random access iterator
    * @tparam itor_t type of the input iterator
    * @param[in] begin top of the input iterator
    * @param[in] end end of the input iterator
@@ -408,15 +2041,70 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::arithmetic> {
    * @return iterator pointint to the top of the unused area
    */
   template <typename itor_t>
-  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
-#if LOLESERI_LITTLE_ENDIAN
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::true_type) {
     auto p = reinterpret_cast<std::uint8_t *>(obj);
-    std::copy(begin, begin + sizeof(target_type), p);
-#else
-#error "you should write something here."
-#endif
+    read_bytes(begin, p, has_native_layout<target_type, order>());
     return begin + sizeof(target_type);
   }
+
+  /** deserialize obj from single pass input iterator byte by byte
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::false_type) {
+    constexpr bool same = has_native_layout<target_type, order>::value;
+    auto p = reinterpret_cast<std::uint8_t *>(obj);
+    for (size_t i = 0; i < size; ++i, ++begin) {
+      if (begin == end) {
+        throw buffer_overrun();
+      }
+      p[same ? i : size - 1 - i] = static_cast<std::uint8_t>(*begin);
+    }
+    return begin;
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    using category = typename std::iterator_traits<itor_t>::iterator_category;
+    using random_access =
+        std::is_base_of<std::random_access_iterator_tag, category>;
+    return deserialize(begin, end, obj, random_access());
+  }
+
+  /** read bytes of the value in the same order
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[out] p top of the bytes of the value
+   */
+  template <typename itor_t>
+  static void read_bytes(itor_t begin, std::uint8_t *p, std::true_type) {
+    std::copy(begin, begin + size, p);
+  }
+
+  /** read bytes of the value in reverse order
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[out] p top of the bytes of the value
+   */
+  template <typename itor_t>
+  static void read_bytes(itor_t begin, std::uint8_t *p, std::false_type) {
+    std::copy(begin, begin + size,
+              std::reverse_iterator<std::uint8_t *>(p + size));
+  }
   /** deserialize obj from input iterator
    * @tparam itor_t type of the input iterator
    * @param[in] begin top of the input iterator
@@ -433,9 +2121,11 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::arithmetic> {
 
 /** type to deserialize boolean type
  * @tparam target_type_ type of the value to deserialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::deserializer_impl<target_type_, loleseri::tcat::boolean> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::boolean,
+                                   order> {
 
   /** type of the value to deserialize */
   using target_type = typename std::remove_cv<target_type_>::type;
@@ -449,9 +2139,13 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::boolean> {
    * @param[in] end end of the input iterator
    * @param[in] obj pointer to the object to serialize
    * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is empty
    */
   template <typename itor_t>
   static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    if (begin == end) {
+      throw buffer_overrun();
+    }
     *obj = !!*begin;
     return std::next(begin);
   }
@@ -460,18 +2154,27 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::boolean> {
    * @param[in] begin top of the input iterator
    * @param[in] end end of the input iterator
    * @return deserialized object
+   * @throw buffer_overrun if the range is empty
    */
   template <typename itor_t>
   static target_type deserialize(itor_t begin, itor_t end) {
+    if (begin == end) {
+      throw buffer_overrun();
+    }
     return !!*begin;
   }
 };
 
 /** type to deserialize struct or class
  * @tparam target_type_ type of the value to deserialize
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::deserializer_impl<target_type_, loleseri::tcat::other> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::other,
+                                   order>
+    : public loleseri::fixed_size_base<
+          loleseri::is_fixed_size<target_type_>::value,
+          loleseri::sum_of_size<loleseri::item_list_type<target_type_>>> {
   /** target type */
   using target_type = typename std::remove_cv<target_type_>::type;
 
@@ -481,56 +2184,84 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::other> {
   /** type of the list of items to serialize */
   using list_type = typename std::remove_cv<decltype(items::list())>::type;
 
-  /** byte count of serialized size */
-  enum { size = sum_of_size<list_type>::value };
+  /** base class which defines size and buffer if the size is fixed */
+  using base = fixed_size_base<is_fixed_size<target_type>::value,
+                               sum_of_size<list_type>>;
+
+  /** indices of the items */
+  using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+
+  /** deserialize the ix-th item
+   * @tparam ix index of the item
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @param[in] list items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_item(itor_t begin, itor_t end, target_type *obj,
+                                 list_type const &list) {
+    auto m = std::get<ix>(list);
+    using item_type = typename item_codec<decltype(m)>::codec_type;
+    using deseri = loleseri::deserializer<item_type, order>;
+    using check = std::integral_constant<
+        bool, !is_fixed_size<target_type>::value &&
+                  is_fixed_size<item_type>::value>;
+    require_item_size<item_type>(begin, end, check());
+    return deseri::deserialize(begin, end, &(obj->*m));
+  }
 
-  template <size_t ix, bool end_of_tuple> struct partial_deserializer;
+  /** deserialize items in order. the items are expanded in the initializer
+   * of the array, which is evaluated from left to right.
+   * @tparam itor_t input iterator
+   * @tparam ix indices of the items
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t deserialize_items(itor_t begin, itor_t end, target_type *obj,
+                                  index_sequence<ix...>) {
+    auto const list = items::list();
+    int const expanded[] = {
+        0, (begin = deserialize_item<ix>(begin, end, obj, list), 0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
 
-  /** template to deserialize part of struct or class
-   * @tparam ix skip first ix items
+  /** deserialize obj from input iterator item by item
+   * @tparam itor_t type of the input iterator
    * @param[in] begin top of the input iterator
    * @param[in] end end of the input iterator
-   * @param[in] obj pointer
-   * @return iterator which points to the begin of the unused area
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator pointint to the top of the unused area
    */
-  template <size_t ix> struct partial_deserializer<ix, false> {
-    /** deserialize part of struct or class
-     * @tparam itor_t input iterator
-     * @param[in] begin begin of input iterator
-     * @param[in] end end of input iterator
-     * @param[out] obj address to write the result of deserialize
-     */
-    template <typename itor_t>
-    static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
-      constexpr size_t tc = std::tuple_size<list_type>::value;
-      auto m = std::get<ix>(items::list());
-      using item_type = typename std::remove_reference<decltype(obj->*m)>::type;
-      using deseri = loleseri::deserializer<item_type>;
-      auto p = deseri::deserialize(begin, end, &(obj->*m));
-      using partial = partial_deserializer<ix + 1, (tc <= ix + 1)>;
-      return partial::deserialize(p, end, obj);
-    }
-  };
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::false_type) {
+    return deserialize_items(begin, end, obj, indices());
+  }
 
-  /** template to deserialize part of struct or class
-   * @tparam ix skip first ix items
+  /** deserialize obj from contiguous input iterator with single memcpy if the
+   * layout of target_type is native
+   * @tparam itor_t type of the input iterator
    * @param[in] begin top of the input iterator
    * @param[in] end end of the input iterator
-   * @param[in] obj pointer
-   * @return iterator which points to the begin of the unused area
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator pointint to the top of the unused area
    */
-  template <size_t ix> struct partial_deserializer<ix, true> {
-    /** deserialize part of struct or class ( do nothing because ix is too big )
-     * @tparam itor_t input iterator
-     * @param[in] begin begin of input iterator
-     * @param[in] end end of input iterator
-     * @param[out] obj address to write the result of deserialize
-     */
-    template <typename itor_t>
-    static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
-      return begin;
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::true_type) {
+    if (native_layout<target_type, order>::matches(obj)) {
+      return copy_bytes_from(begin, obj, base::size);
     }
-  };
+    return deserialize(begin, end, obj, std::false_type());
+  }
 
   /** deserialize obj from input iterator
    * @tparam itor_t type of the input iterator
@@ -541,8 +2272,10 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::other> {
    */
   template <typename itor_t>
   static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
-    constexpr size_t tc = std::tuple_size<list_type>::value;
-    return partial_deserializer<0, (tc <= 0)>::deserialize(begin, end, obj);
+    using bulk = std::integral_constant<
+        bool, native_layout<target_type, order>::candidate &&
+                  is_contiguous_byte_iterator<itor_t>::value>;
+    return deserialize(begin, end, obj, bulk());
   }
   /** deserialize obj from input iterator
    * @tparam itor_t type of the input iterator
@@ -561,32 +2294,92 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::other> {
 /** template to deserialize
  * @tparam target_type target type
  * @tparam typecat integer to specity category of target type
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::deserializer_impl<target_type_, loleseri::tcat::std_array> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::std_array,
+                                   order>
+    : public loleseri::fixed_size_base<
+          loleseri::is_fixed_size<target_type_>::value,
+          loleseri::size_of_elements<
+              typename target_type_::value_type,
+              std::tuple_size<typename std::remove_cv<target_type_>::type>::
+                  value>> {
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
 
+  /** element type of std::array "target_type" */
+  using element_type = typename target_type::value_type;
+
   enum {
-    /** byte count of serialized size */
-    size = serializer<typename target_type::value_type>::size *
-           std::tuple_size<target_type>::value
+    /** element count of std::array "target_type" */
+    element_count = std::tuple_size<target_type>::value
   };
-  /** deserialize
+
+  /** base class which defines size and buffer if the size is fixed */
+  using base = fixed_size_base<is_fixed_size<target_type>::value,
+                               size_of_elements<element_type, element_count>>;
+
+  /** deserialize element by element
    * @tparam itor_t input iterator
    * @param[in] begin begin of input iterator
    * @param[in] end end of input iterator
    * @param[obj] address to write the result of deserialize
    */
   template <typename itor_t>
-  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+  static itor_t
+  deserialize(itor_t begin, itor_t end, target_type *obj,
+              std::integral_constant<int, copy_method::element_by_element>) {
     auto p = begin;
-    using deseri = loleseri::deserializer<typename target_type::value_type>;
+    using deseri = loleseri::deserializer<element_type, order>;
     for (auto &e : *obj) {
       p = deseri::deserialize(p, end, &e);
     }
     return p;
   }
+
+  /** deserialize obj from contiguous input iterator with single memcpy
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::integral_constant<int, copy_method::block>) {
+    return copy_bytes_from(begin, obj, base::size);
+  }
+
+  /** deserialize obj from contiguous input iterator with reversing byte order
+   * of all elements at once
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  deserialize(itor_t begin, itor_t end, target_type *obj,
+              std::integral_constant<int, copy_method::byteswap>) {
+    constexpr size_t unit = arithmetic_unit<target_type>::value;
+    return copy_swapped_from<unit>(begin, obj, base::size);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    using method = array_copy_method<target_type, order, itor_t>;
+    return deserialize(begin, end, obj,
+                       std::integral_constant<int, method::value>());
+  }
   /** deserialize obj from input iterator
    * @tparam itor_t type of the input iterator
    * @param[in] begin top of the input iterator
@@ -604,9 +2397,17 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::std_array> {
 /** template to deserialize
  * @tparam target_type target type
  * @tparam typecat integer to specity category of target type
+ * @tparam order byte order of serialized data
  */
-template <typename target_type_>
-struct loleseri::deserializer_impl<target_type_, loleseri::tcat::array> {
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::array,
+                                   order>
+    : public loleseri::fixed_size_base<
+          loleseri::is_fixed_size<target_type_>::value,
+          loleseri::size_of_elements<
+              typename loleseri::element_type_of_array<
+                  typename std::remove_cv<target_type_>::type>::type,
+              std::extent<target_type_>::value>> {
   /** type of the value to serialize */
   using target_type = typename std::remove_cv<target_type_>::type;
 
@@ -615,16 +2416,14 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::array> {
 
   enum {
     /** element count of traditional array "target_type" */
-    element_count = size_of_array(target_type{}),
-
-    /** byte count of serialized size */
-    size = serializer<element_type>::size * element_count
+    element_count = std::extent<target_type>::value
   };
 
-  /** type of array of the right size for serialization */
-  using buffer = std::array<std::uint8_t, size>;
+  /** base class which defines size and buffer if the size is fixed */
+  using base = fixed_size_base<is_fixed_size<target_type>::value,
+                               size_of_elements<element_type, element_count>>;
 
-  /** serialize obj to output iterator
+  /** deserialize obj from input iterator element by element
    * @tparam itor_t type of the output iterator
    * @param[in] begin top of the output iterator
    * @param[in] end end of the output iterator
@@ -632,12 +2431,253 @@ struct loleseri::deserializer_impl<target_type_, loleseri::tcat::array> {
    * @return iterator which points to the begin of the unused area
    */
   template <typename itor_t>
-  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+  static itor_t
+  deserialize(itor_t begin, itor_t end, target_type *obj,
+              std::integral_constant<int, copy_method::element_by_element>) {
     auto p = begin;
-    using deseri = loleseri::deserializer<element_type>;
+    using deseri = loleseri::deserializer<element_type, order>;
     for (auto &e : *obj) {
       p = deseri::deserialize(p, end, &e);
     }
     return p;
   }
+
+  /** deserialize obj from contiguous input iterator with single memcpy
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj,
+                            std::integral_constant<int, copy_method::block>) {
+    return copy_bytes_from(begin, obj, base::size);
+  }
+
+  /** deserialize obj from contiguous input iterator with reversing byte order
+   * of all elements at once
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t
+  deserialize(itor_t begin, itor_t end, target_type *obj,
+              std::integral_constant<int, copy_method::byteswap>) {
+    constexpr size_t unit = arithmetic_unit<target_type>::value;
+    return copy_swapped_from<unit>(begin, obj, base::size);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t input iterator
+   * @param[in] begin begin of input iterator
+   * @param[in] end end of input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    using method = array_copy_method<target_type, order, itor_t>;
+    return deserialize(begin, end, obj,
+                       std::integral_constant<int, method::value>());
+  }
+};
+
+/** type to serialize std::vector
+ * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::vector,
+                                 order> {
+  /** type of the value to serialize */
+  using target_type = typename std::remove_cv<target_type_>::type;
+
+  /** element type of std::vector "target_type" */
+  using element_type = typename target_type::value_type;
+
+  static_assert(!std::is_same<element_type, bool>::value,
+                "std::vector<bool> is not supported");
+
+  /** type to serialize the length */
+  using length_serializer = serializer<length_type, order>;
+
+  /** type to serialize the elements */
+  using sequence = sequence_serializer<element_type, order>;
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   * @throw std::length_error if obj has too many elements
+   */
+  static size_t serialized_size(target_type const *obj) {
+    length_of(obj->size());
+    return length_serializer::size +
+           sequence::serialized_size(obj->data(), obj->size());
+  }
+
+  /** serialize obj to output iterator. the length is written first.
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   * @throw std::length_error if obj has too many elements
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
+    auto const length = length_of(obj->size());
+    auto p = length_serializer::serialize(begin, end, &length);
+    return sequence::serialize(p, end, obj->data(), obj->size());
+  }
+};
+
+/** type to serialize std::basic_string
+ * @tparam target_type_ type of the value to serialize
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::serializer_impl<target_type_, loleseri::tcat::string,
+                                 order> {
+  /** type of the value to serialize */
+  using target_type = typename std::remove_cv<target_type_>::type;
+
+  /** character type of std::basic_string "target_type" */
+  using element_type = typename target_type::value_type;
+
+  /** type to serialize the length */
+  using length_serializer = serializer<length_type, order>;
+
+  /** type to serialize the characters */
+  using sequence = sequence_serializer<element_type, order>;
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   * @throw std::length_error if obj has too many elements
+   */
+  static size_t serialized_size(target_type const *obj) {
+    length_of(obj->size());
+    return length_serializer::size +
+           sequence::serialized_size(obj->data(), obj->size());
+  }
+
+  /** serialize obj to output iterator. the length is written first.
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   * @throw std::length_error if obj has too many elements
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target_type const *obj) {
+    auto const length = length_of(obj->size());
+    auto p = length_serializer::serialize(begin, end, &length);
+    return sequence::serialize(p, end, obj->data(), obj->size());
+  }
+};
+
+/** type to deserialize std::vector
+ * @tparam target_type_ type of the value to deserialize
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::vector,
+                                   order> {
+  /** type of the value to deserialize */
+  using target_type = typename std::remove_cv<target_type_>::type;
+
+  /** element type of std::vector "target_type" */
+  using element_type = typename target_type::value_type;
+
+  static_assert(!std::is_same<element_type, bool>::value,
+                "std::vector<bool> is not supported");
+
+  /** type to deserialize the length */
+  using length_deserializer = deserializer<length_type, order>;
+
+  /** type to deserialize the elements */
+  using sequence = sequence_deserializer<element_type, order>;
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    require_size(begin, end, length_deserializer::size);
+    length_type length;
+    auto p = length_deserializer::deserialize(begin, end, &length);
+    return sequence::fill(p, end, obj, length);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return deserialized object
+   */
+  template <typename itor_t>
+  static target_type deserialize(itor_t begin, itor_t end) {
+    target_type obj;
+    deserialize(begin, end, &obj);
+    return obj;
+  }
+};
+
+/** type to deserialize std::basic_string
+ * @tparam target_type_ type of the value to deserialize
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, loleseri::byte_order order>
+struct loleseri::deserializer_impl<target_type_, loleseri::tcat::string,
+                                   order> {
+  /** type of the value to deserialize */
+  using target_type = typename std::remove_cv<target_type_>::type;
+
+  /** character type of std::basic_string "target_type" */
+  using element_type = typename target_type::value_type;
+
+  /** type to deserialize the length */
+  using length_deserializer = deserializer<length_type, order>;
+
+  /** type to deserialize the characters */
+  using sequence = sequence_deserializer<element_type, order>;
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target_type *obj) {
+    require_size(begin, end, length_deserializer::size);
+    length_type length;
+    auto p = length_deserializer::deserialize(begin, end, &length);
+    return sequence::fill(p, end, obj, length);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return deserialized object
+   */
+  template <typename itor_t>
+  static target_type deserialize(itor_t begin, itor_t end) {
+    target_type obj;
+    deserialize(begin, end, &obj);
+    return obj;
+  }
 };
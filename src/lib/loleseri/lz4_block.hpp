@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace loleseri {
+
+/** codec of LZ4 block format. blocks compressed by this codec can be
+ * decompressed by LZ4_decompress_safe, and vice versa.
+ * compression is greedy with a hash table of 4 byte sequences.
+ */
+class lz4_block_codec {
+public:
+  enum {
+    /** minimum length of the match */
+    min_match = 4,
+
+    /** the last match must start before this count of bytes from the end */
+    match_start_limit = 12,
+
+    /** the last bytes of this count are always literals */
+    last_literals = 5,
+
+    /** maximum offset of the match */
+    max_offset = 65535,
+
+    /** bit count of the hash */
+    hash_bits = 12
+  };
+
+  /** create codec */
+  lz4_block_codec() : table_(1u << hash_bits) {}
+
+  /** maximum byte count of compressed data
+   * @param[in] size byte count of the source
+   * @return byte count
+   */
+  static size_t max_compressed_size(size_t size) {
+    return size + size / 255 + 16;
+  }
+
+  /** maximum byte count of decompressed data. used to reject broken headers
+   * before the area to decompress is allocated.
+   * @param[in] size byte count of compressed data
+   * @return byte count
+   */
+  static size_t max_decompressed_size(size_t size) { return 255 * size + 16; }
+
+  /** compress bytes
+   * @param[in] src top of the source
+   * @param[in] size byte count of the source
+   * @param[out] dest top of the area of max_compressed_size(size) bytes
+   * @return byte count of compressed data
+   */
+  size_t compress(std::uint8_t const *src, size_t size, std::uint8_t *dest) {
+    std::uint8_t *op = dest;
+    std::uint8_t const *anchor = src;
+    if (match_start_limit < size) {
+      std::fill(table_.begin(), table_.end(), 0);
+      std::uint8_t const *const start_limit = src + size - match_start_limit;
+      std::uint8_t const *const match_limit = src + size - last_literals;
+      std::uint8_t const *ip = src;
+      while (ip < start_limit) {
+        std::uint32_t const seq = read32(ip);
+        std::uint32_t &slot = table_[hash(seq)];
+        std::uint8_t const *ref = src + slot;
+        slot = static_cast<std::uint32_t>(ip - src);
+        if (ip <= ref || max_offset < ip - ref || read32(ref) != seq) {
+          ip += 1 + ((ip - anchor) >> 6);
+          continue;
+        }
+        while (anchor < ip && src < ref && ip[-1] == ref[-1]) {
+          --ip;
+          --ref;
+        }
+        std::uint8_t const *mp = ip + min_match;
+        std::uint8_t const *mr = ref + min_match;
+        while (mp < match_limit && *mp == *mr) {
+          ++mp;
+          ++mr;
+        }
+        op = write_sequence(op, anchor, static_cast<size_t>(ip - anchor),
+                            static_cast<size_t>(ip - ref),
+                            static_cast<size_t>(mp - ip));
+        ip = mp;
+        anchor = ip;
+      }
+    }
+    size_t const rest = static_cast<size_t>(src + size - anchor);
+    op = write_literals(op, anchor, rest);
+    return static_cast<size_t>(op - dest);
+  }
+
+  /** decompress bytes. broken data never makes it read or write out of the
+   * ranges.
+   * @param[in] src top of the compressed data
+   * @param[in] size byte count of the compressed data
+   * @param[out] dest top of the area to write
+   * @param[in] raw_size byte count of the decompressed data
+   * @return false if the data is broken or the size is different
+   */
+  static bool decompress(std::uint8_t const *src, size_t size,
+                         std::uint8_t *dest, size_t raw_size) {
+    std::uint8_t const *ip = src;
+    std::uint8_t const *const iend = src + size;
+    std::uint8_t *op = dest;
+    std::uint8_t *const oend = dest + raw_size;
+    for (;;) {
+      if (ip == iend) {
+        return false;
+      }
+      unsigned const token = *ip++;
+      size_t literals = token >> 4;
+      if (!read_length(&ip, iend, &literals) ||
+          static_cast<size_t>(iend - ip) < literals ||
+          static_cast<size_t>(oend - op) < literals) {
+        return false;
+      }
+      std::memcpy(op, ip, literals);
+      ip += literals;
+      op += literals;
+      if (ip == iend) {
+        return op == oend;
+      }
+      if (iend - ip < 2) {
+        return false;
+      }
+      size_t const offset = static_cast<size_t>(ip[0]) |
+                            (static_cast<size_t>(ip[1]) << 8);
+      ip += 2;
+      size_t length = token & 15u;
+      if (offset == 0 || static_cast<size_t>(op - dest) < offset ||
+          !read_length(&ip, iend, &length)) {
+        return false;
+      }
+      length += min_match;
+      if (static_cast<size_t>(oend - op) < length) {
+        return false;
+      }
+      std::uint8_t const *ref = op - offset;
+      if (length <= offset) {
+        std::memcpy(op, ref, length);
+        op += length;
+      } else {
+        for (size_t i = 0; i < length; ++i) {
+          *op++ = *ref++;
+        }
+      }
+    }
+  }
+
+private:
+  /** read 4 bytes
+   * @param[in] p top of the bytes
+   * @return bytes as integer in native byte order
+   */
+  static std::uint32_t read32(std::uint8_t const *p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+  }
+
+  /** hash of 4 bytes
+   * @param[in] seq 4 bytes
+   * @return index of the table
+   */
+  static size_t hash(std::uint32_t seq) {
+    return static_cast<size_t>((seq * 2654435761u) >> (32 - hash_bits));
+  }
+
+  /** write the rest of the length
+   * @param[out] op top of the area to write
+   * @param[in] rest length minus 15
+   * @return iterator pointing to the next of the written bytes
+   */
+  static std::uint8_t *write_length(std::uint8_t *op, size_t rest) {
+    for (; 255 <= rest; rest -= 255) {
+      *op++ = 255;
+    }
+    *op++ = static_cast<std::uint8_t>(rest);
+    return op;
+  }
+
+  /** read the rest of the length
+   * @param[in,out] ip pointer to the iterator pointing to the length
+   * @param[in] iend end of the data
+   * @param[in,out] length length in the token
+   * @return false if the data is broken
+   */
+  static bool read_length(std::uint8_t const **ip, std::uint8_t const *iend,
+                          size_t *length) {
+    if (*length != 15) {
+      return true;
+    }
+    for (;;) {
+      if (*ip == iend) {
+        return false;
+      }
+      unsigned const b = *(*ip)++;
+      *length += b;
+      if (b != 255) {
+        return true;
+      }
+    }
+  }
+
+  /** write the last sequence which has literals only
+   * @param[out] op top of the area to write
+   * @param[in] literals top of the literals
+   * @param[in] count byte count of the literals
+   * @return iterator pointing to the next of the written bytes
+   */
+  static std::uint8_t *write_literals(std::uint8_t *op,
+                                      std::uint8_t const *literals,
+                                      size_t count) {
+    *op++ = static_cast<std::uint8_t>((count < 15 ? count : 15) << 4);
+    if (15 <= count) {
+      op = write_length(op, count - 15);
+    }
+    std::memcpy(op, literals, count);
+    return op + count;
+  }
+
+  /** write a sequence of literals and a match
+   * @param[out] op top of the area to write
+   * @param[in] literals top of the literals
+   * @param[in] count byte count of the literals
+   * @param[in] offset distance to the match
+   * @param[in] length length of the match
+   * @return iterator pointing to the next of the written bytes
+   */
+  static std::uint8_t *write_sequence(std::uint8_t *op,
+                                      std::uint8_t const *literals,
+                                      size_t count, size_t offset,
+                                      size_t length) {
+    size_t const ml = length - min_match;
+    std::uint8_t *token = op;
+    op = write_literals(op, literals, count);
+    *token = static_cast<std::uint8_t>(*token | (ml < 15 ? ml : 15));
+    *op++ = static_cast<std::uint8_t>(offset & 0xff);
+    *op++ = static_cast<std::uint8_t>(offset >> 8);
+    if (15 <= ml) {
+      op = write_length(op, ml - 15);
+    }
+    return op;
+  }
+
+  /** positions of the last 4 byte sequences indexed by their hash */
+  std::vector<std::uint32_t> table_;
+};
+
+} // namespace loleseri
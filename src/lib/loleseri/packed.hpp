@@ -0,0 +1,892 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/schema.hpp>
+#include <memory>
+
+#if defined __SSE2__
+#include <immintrin.h>
+#endif
+
+namespace loleseri {
+
+/** pack bools into bits. the i-th bool is written to the bit ( i % 8 ) of
+ * the byte ( i / 8 ), and the unused bits of the last byte are 0.
+ * 16 bools are packed at once with SSE2 movemask, and 8 bools at once with
+ * multiplication on little endian hosts.
+ * @param[in] src top of the bools
+ * @param[in] count count of the bools
+ * @param[out] dest top of the area to write ( count + 7 ) / 8 bytes
+ */
+inline void pack_bools(bool const *src, size_t count, std::uint8_t *dest) {
+  size_t i = 0;
+#if defined __SSE2__
+  for (; i + 16 <= count; i += 16) {
+    auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    auto const bits =
+        _mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_setzero_si128()));
+    dest[i / 8] = static_cast<std::uint8_t>(bits);
+    dest[i / 8 + 1] = static_cast<std::uint8_t>(bits >> 8);
+  }
+#endif
+#if LOLESERI_LITTLE_ENDIAN
+  for (; i + 8 <= count; i += 8) {
+    std::uint64_t x;
+    std::memcpy(&x, src + i, sizeof(x));
+    dest[i / 8] = static_cast<std::uint8_t>((x * 0x0102040810204080u) >> 56);
+  }
+#endif
+  for (; i < count; i += 8) {
+    unsigned bits = 0;
+    for (size_t k = 0; k < 8 && i + k < count; ++k) {
+      bits |= (src[i + k] ? 1u : 0u) << k;
+    }
+    dest[i / 8] = static_cast<std::uint8_t>(bits);
+  }
+}
+
+/** unpack bits into bools. the reverse of pack_bools.
+ * 16 bools are unpacked at once with SSE2, and 8 bools at once with
+ * multiplication on little endian hosts.
+ * @param[in] src top of the ( count + 7 ) / 8 bytes
+ * @param[in] count count of the bools
+ * @param[out] dest top of the bools to write
+ */
+inline void unpack_bools(std::uint8_t const *src, size_t count, bool *dest) {
+  size_t i = 0;
+#if defined __SSE2__
+  auto const mask = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+                                  16, 32, 64, -128);
+  for (; i + 16 <= count; i += 16) {
+    auto const lo = _mm_set1_epi8(static_cast<char>(src[i / 8]));
+    auto const hi = _mm_set1_epi8(static_cast<char>(src[i / 8 + 1]));
+    auto v = _mm_unpacklo_epi64(lo, hi);
+    v = _mm_cmpeq_epi8(_mm_and_si128(v, mask), mask);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i),
+                     _mm_and_si128(v, _mm_set1_epi8(1)));
+  }
+#endif
+#if LOLESERI_LITTLE_ENDIAN
+  for (; i + 8 <= count; i += 8) {
+    std::uint64_t x = (src[i / 8] * 0x0101010101010101u) & 0x8040201008040201u;
+    x = ((x + 0x7f7f7f7f7f7f7f7fu) >> 7) & 0x0101010101010101u;
+    std::memcpy(dest + i, &x, sizeof(x));
+  }
+#endif
+  for (; i < count; ++i) {
+    dest[i] = ((src[i / 8] >> (i % 8)) & 1u) != 0;
+  }
+}
+
+/** template to serialize and deserialize bools as bits
+ * @tparam count count of the bools
+ */
+template <size_t count> struct bit_codec {
+  enum {
+    /** byte count of serialized size */
+    size = (count + 7) / 8
+  };
+
+  /** serialize bools to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] src top of the bools
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, bool const *src) {
+    using contiguous = std::integral_constant<
+        bool, is_contiguous_byte_iterator<itor_t>::value>;
+    return serialize(begin, end, src, contiguous());
+  }
+
+  /** serialize bools to contiguous bytes directly
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] src top of the bools
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, bool const *src,
+                          std::true_type) {
+    pack_bools(src, count,
+               reinterpret_cast<std::uint8_t *>(std::addressof(*begin)));
+    return begin + size;
+  }
+
+  /** serialize bools to output iterator through a buffer
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] src top of the bools
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, bool const *src,
+                          std::false_type) {
+    std::array<std::uint8_t, size> bytes;
+    pack_bools(src, count, bytes.data());
+    for (auto b : bytes) {
+      *begin = b;
+      ++begin;
+    }
+    return begin;
+  }
+
+  /** deserialize bools from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] dest top of the bools to write
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, bool *dest) {
+    using contiguous = std::integral_constant<
+        bool, is_contiguous_byte_iterator<itor_t>::value>;
+    return deserialize(begin, end, dest, contiguous());
+  }
+
+  /** deserialize bools from contiguous bytes directly
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] dest top of the bools to write
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, bool *dest,
+                            std::true_type) {
+    unpack_bools(
+        reinterpret_cast<std::uint8_t const *>(std::addressof(*begin)), count,
+        dest);
+    return begin + size;
+  }
+
+  /** deserialize bools from input iterator through a buffer
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] dest top of the bools to write
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, bool *dest,
+                            std::false_type) {
+    std::array<std::uint8_t, size> bytes;
+    for (auto &b : bytes) {
+      if (begin == end) {
+        throw buffer_overrun();
+      }
+      b = static_cast<std::uint8_t>(*begin);
+      ++begin;
+    }
+    unpack_bools(bytes.data(), count, dest);
+    return begin;
+  }
+};
+
+/** tag type to select serializer of the bools packed into bits
+ * @tparam value_type std::array of bools, traditional array of bools, or
+ * struct or class whose consecutive bool members are packed
+ */
+template <typename value_type> struct packed_bools {};
+
+/** item of items<T>::list() which is an array of bools packed into bits, or
+ * a struct whose consecutive bool members are packed into bits.
+ * create this with packed().
+ * @tparam value_type array of bools, or struct or class
+ * @tparam owner type of struct or class
+ */
+template <typename value_type, typename owner> struct packed_item {
+  /** pointer to the data member */
+  value_type owner::*member;
+};
+
+/** mark the data member of array of bools or struct to be packed 8 bools per
+ * byte
+ * @tparam value_type array of bools, or struct or class
+ * @tparam owner type of struct or class
+ * @param[in] member pointer to the data member
+ * @return item of items<T>::list()
+ */
+template <typename value_type, typename owner>
+constexpr packed_item<value_type, owner> packed(value_type owner::*member) {
+  return packed_item<value_type, owner>{member};
+}
+
+/** access the data member marked as packed
+ * @param[in] obj pointer to the object
+ * @param[in] item item of items<T>::list()
+ * @return reference to the data member
+ */
+template <typename value_type, typename owner>
+value_type const &operator->*(owner const *obj,
+                              packed_item<value_type, owner> item) {
+  return obj->*item.member;
+}
+
+/** access the data member marked as packed
+ * @param[in] obj pointer to the object
+ * @param[in] item item of items<T>::list()
+ * @return reference to the data member
+ */
+template <typename value_type, typename owner>
+value_type &operator->*(owner *obj, packed_item<value_type, owner> item) {
+  return obj->*item.member;
+}
+
+/** data type of the item marked as packed */
+template <typename value, typename owner>
+struct memptr_value<packed_item<value, owner>> {
+  /** data type */
+  using type = value;
+};
+
+/** item marked as packed is serialized by serializer<packed_bools<...>> */
+template <typename value, typename owner>
+struct item_codec<packed_item<value, owner>> {
+  /** data type */
+  using value_type = value;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = packed_bools<value>;
+};
+
+/** size of the bools packed into bits is fixed if the size of the value is
+ * fixed ( always for arrays ) */
+template <typename value_type>
+struct is_fixed_size<packed_bools<value_type>, tcat::other>
+    : public is_fixed_size<value_type> {};
+
+/** the layout of the array is mixed into the schema hash with the mark */
+template <typename value_type>
+struct schema_of<packed_bools<value_type>, tcat::other> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return schema_of<value_type>::hash(fnv1a(h, schema_tag::packed));
+  }
+};
+
+/** item of items<T>::list() which packs consecutive bool members into bits.
+ * the members are fixed at compile time, like
+ * bool_group<foo, &foo::a, &foo::b, &foo::c>().
+ * @tparam owner type of struct or class
+ * @tparam members pointers to the bool data members
+ */
+template <typename owner, bool owner::*... members> struct bool_group {
+  static_assert(0 < sizeof...(members), "bool_group requires members");
+
+  /** count of the members */
+  enum { count = sizeof...(members) };
+};
+
+/** access the object which has the members of the group. the serializer of
+ * the group reads and writes the members.
+ * @param[in] obj pointer to the object
+ * @return reference to the object
+ */
+template <typename owner, bool owner::*... members>
+owner const &operator->*(owner const *obj, bool_group<owner, members...>) {
+  return *obj;
+}
+
+/** access the object which has the members of the group
+ * @param[in] obj pointer to the object
+ * @return reference to the object
+ */
+template <typename owner, bool owner::*... members>
+owner &operator->*(owner *obj, bool_group<owner, members...>) {
+  return *obj;
+}
+
+/** data type of the group ( the object which has the members ) */
+template <typename owner, bool owner::*... members>
+struct memptr_value<bool_group<owner, members...>> {
+  /** data type */
+  using type = owner;
+};
+
+/** group is serialized by serializer<bool_group<...>> */
+template <typename owner, bool owner::*... members>
+struct item_codec<bool_group<owner, members...>> {
+  /** data type */
+  using value_type = owner;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = bool_group<owner, members...>;
+};
+
+/** size of the group of bool members is fixed */
+template <typename owner, bool owner::*... members>
+struct is_fixed_size<bool_group<owner, members...>, tcat::other>
+    : public std::true_type {};
+
+/** the count of the members is mixed into the schema hash */
+template <typename owner, bool owner::*... members>
+struct schema_of<bool_group<owner, members...>, tcat::other> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return fnv1a(fnv1a(h, schema_tag::bool_group), sizeof...(members));
+  }
+};
+
+/** template to specify the item is a pointer to bool data member or not
+ * @tparam item type of the item in items<T>::list()
+ */
+template <typename item> struct is_bool_member : public std::false_type {};
+
+/** pointer to bool data member
+ * @tparam owner type of struct or class
+ */
+template <typename owner>
+struct is_bool_member<bool owner::*> : public std::true_type {};
+
+/** length of the run of bool members
+ * @param[in] flags 1 for bool members and 0 for others, terminated by 0
+ * @param[in] ix index of the first member of the run
+ * @return count of the consecutive bool members from ix
+ */
+constexpr size_t bool_run_length(size_t const *flags, size_t ix) {
+  return flags[ix] == 0 ? 0 : 1 + bool_run_length(flags, ix + 1);
+}
+
+/** template to find runs of consecutive bool members in the items. the
+ * types of the items are known at compile time, so the runs are too.
+ * @tparam tuple_type type of items<T>::list()
+ */
+template <typename tuple_type> struct bool_runs;
+
+/** template to find runs of consecutive bool members in the items
+ * @tparam args tuple member types
+ */
+template <typename... args> struct bool_runs<std::tuple<args...>> {
+  /** 1 for bool members and 0 for other items */
+  using flags = value_array<is_bool_member<args>::value...>;
+
+  /** count of the bools packed at the ix-th item. the first member of the
+   * run has the length of the run, and the others have 0.
+   * @param[in] ix index of the item
+   * @return count of the bools
+   */
+  static constexpr size_t length(size_t ix) {
+    return flags::data[ix] != 0 && (ix == 0 || flags::data[ix - 1] == 0)
+               ? bool_run_length(flags::data, ix)
+               : 0;
+  }
+};
+
+/** byte count of the ix-th item of the struct whose bool members are packed
+ * @tparam tuple_type type of items<T>::list()
+ * @tparam ix index of the item
+ * @tparam is_bool true if the item is a pointer to bool data member
+ */
+template <typename tuple_type, size_t ix,
+          bool is_bool = is_bool_member<
+              typename std::tuple_element<ix, tuple_type>::type>::value>
+struct packed_item_size
+    : public std::integral_constant<
+          size_t, (bool_runs<tuple_type>::length(ix) + 7) / 8> {};
+
+/** byte count of the ix-th item which is not a bool member
+ * @tparam tuple_type type of items<T>::list()
+ * @tparam ix index of the item
+ */
+template <typename tuple_type, size_t ix>
+struct packed_item_size<tuple_type, ix, false>
+    : public std::integral_constant<
+          size_t, serializer<typename item_codec<typename std::tuple_element<
+                      ix, tuple_type>::type>::codec_type>::size> {};
+
+/** byte count of the struct whose bool members are packed
+ * @tparam tuple_type type of items<T>::list()
+ * @tparam indices index_sequence of the items
+ */
+template <typename tuple_type, typename indices> struct packed_items_size;
+
+/** byte count of the struct whose bool members are packed
+ * @tparam tuple_type type of items<T>::list()
+ * @tparam ix indices of the items
+ */
+template <typename tuple_type, size_t... ix>
+struct packed_items_size<tuple_type, index_sequence<ix...>> {
+  enum {
+    value = value_array<packed_item_size<tuple_type, ix>::value...>::sum
+  };
+};
+
+/** template to serialize and deserialize the value as bits
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, byte_order order,
+          int typecat = type_category<value_type>::value>
+struct packed_codec {
+  static_assert(typecat == tcat::std_array || typecat == tcat::array ||
+                    typecat == tcat::other,
+                "packed encoding supports arrays of bools and structs only");
+};
+
+/** template to serialize and deserialize array of bools as bits
+ * @tparam value_type std::array or traditional array of bools
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ */
+template <typename value_type, typename element_type, size_t count>
+struct packed_array_codec : public bit_codec<count> {
+  static_assert(std::is_same<element_type, bool>::value,
+                "packed encoding supports arrays of bools only");
+
+  /** type to serialize and deserialize the bits */
+  using bits = bit_codec<count>;
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static constexpr size_t serialized_size(value_type const *obj) {
+    return bits::size;
+  }
+
+  /** serialize obj to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *obj) {
+    return bits::serialize(begin, end, &(*obj)[0]);
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj) {
+    return bits::deserialize(begin, end, &(*obj)[0]);
+  }
+};
+
+/** template to serialize and deserialize std::array of bools as bits
+ * @tparam value_type std::array of bools
+ * @tparam order byte order of serialized data ( not used )
+ */
+template <typename value_type, byte_order order>
+struct packed_codec<value_type, order, tcat::std_array>
+    : public packed_array_codec<value_type, typename value_type::value_type,
+                                std::tuple_size<value_type>::value> {};
+
+/** template to serialize and deserialize traditional array of bools as bits
+ * @tparam value_type traditional array of bools
+ * @tparam order byte order of serialized data ( not used )
+ */
+template <typename value_type, byte_order order>
+struct packed_codec<value_type, order, tcat::array>
+    : public packed_array_codec<
+          value_type, typename element_type_of_array<value_type>::type,
+          std::extent<value_type>::value> {};
+
+/** template to serialize and deserialize struct or class whose runs of
+ * consecutive bool members are packed into bits. each run takes
+ * ( length + 7 ) / 8 bytes at the place of its first member, and the other
+ * items are serialized as usual.
+ * @tparam value_type struct or class
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, byte_order order>
+struct packed_codec<value_type, order, tcat::other>
+    : public fixed_size_base<
+          is_fixed_size<value_type>::value,
+          packed_items_size<
+              item_list_type<value_type>,
+              make_index_sequence<
+                  std::tuple_size<item_list_type<value_type>>::value>>> {
+  /** type of the list of items */
+  using list_type = item_list_type<value_type>;
+
+  /** runs of bool members in the items */
+  using runs = bool_runs<list_type>;
+
+  /** indices of the items */
+  using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+
+  /** byte count of the serialized ix-th item which is not a bool member
+   * @tparam ix index of the item
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return byte count
+   */
+  template <size_t ix>
+  static size_t item_size(value_type const *obj, list_type const &list,
+                          std::false_type) {
+    auto m = std::get<ix>(list);
+    using item_type = typename item_codec<decltype(m)>::codec_type;
+    return serializer<item_type, order>::serialized_size(&(obj->*m));
+  }
+
+  /** byte count of the run of bools packed at the ix-th item
+   * @tparam ix index of the item
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return byte count
+   */
+  template <size_t ix>
+  static size_t item_size(value_type const *obj, list_type const &list,
+                          std::true_type) {
+    return bit_codec<runs::length(ix)>::size;
+  }
+
+  /** byte count of serialized items
+   * @tparam ix indices of the items
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  template <size_t... ix>
+  static size_t items_size(value_type const *obj, index_sequence<ix...>) {
+    auto const list = items<value_type>::list();
+    size_t const sizes[] = {
+        0, item_size<ix>(obj, list,
+                         is_bool_member<typename std::tuple_element<
+                             ix, list_type>::type>())...};
+    static_cast<void>(list);
+    size_t r = 0;
+    for (size_t s : sizes) {
+      r += s;
+    }
+    return r;
+  }
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(value_type const *obj) {
+    return items_size(obj, indices());
+  }
+
+  /** serialize the ix-th item which is not a bool member
+   * @tparam ix index of the item
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t serialize_item(itor_t begin, itor_t end,
+                               value_type const *obj, list_type const &list,
+                               std::false_type) {
+    auto m = std::get<ix>(list);
+    using item_type = typename item_codec<decltype(m)>::codec_type;
+    return serializer<item_type, order>::serialize(begin, end, &(obj->*m));
+  }
+
+  /** serialize nothing for the bool member which is not the first of the run
+   * @tparam ix index of the item
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return begin
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t serialize_run(itor_t begin, itor_t end, value_type const *obj,
+                              list_type const &list, index_sequence<>) {
+    return begin;
+  }
+
+  /** serialize the run of bools which starts at the ix-th item
+   * @tparam ix index of the item
+   * @tparam itor_t type of the output iterator
+   * @tparam k offsets of the members in the run
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t, size_t... k>
+  static itor_t serialize_run(itor_t begin, itor_t end, value_type const *obj,
+                              list_type const &list, index_sequence<k...>) {
+    bool const values[] = {(obj->*std::get<ix + k>(list))...};
+    return bit_codec<sizeof...(k)>::serialize(begin, end, values);
+  }
+
+  /** serialize the ix-th item which is a bool member
+   * @tparam ix index of the item
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @param[in] list items
+   * @return iterator which points to the begin of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t serialize_item(itor_t begin, itor_t end,
+                               value_type const *obj, list_type const &list,
+                               std::true_type) {
+    return serialize_run<ix>(begin, end, obj, list,
+                             make_index_sequence<runs::length(ix)>());
+  }
+
+  /** serialize items in order
+   * @tparam itor_t type of the output iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t serialize_items(itor_t begin, itor_t end,
+                                value_type const *obj, index_sequence<ix...>) {
+    auto const list = items<value_type>::list();
+    int const expanded[] = {
+        0, (begin = serialize_item<ix>(
+                begin, end, obj, list,
+                is_bool_member<
+                    typename std::tuple_element<ix, list_type>::type>()),
+            0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** serialize obj to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object to serialize
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, value_type const *obj) {
+    return serialize_items(begin, end, obj, indices());
+  }
+
+  /** deserialize the ix-th item which is not a bool member
+   * @tparam ix index of the item
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @param[in] list items
+   * @return iterator pointint to the top of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_item(itor_t begin, itor_t end, value_type *obj,
+                                 list_type const &list, std::false_type) {
+    auto m = std::get<ix>(list);
+    using item_type = typename item_codec<decltype(m)>::codec_type;
+    using check = std::integral_constant<
+        bool, !is_fixed_size<value_type>::value &&
+                  is_fixed_size<item_type>::value>;
+    require_item_size<item_type>(begin, end, check());
+    return deserializer<item_type, order>::deserialize(begin, end,
+                                                       &(obj->*m));
+  }
+
+  /** deserialize nothing for the bool member which is not the first of the
+   * run. the member is written with the first one.
+   * @tparam ix index of the item
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @param[in] list items
+   * @return begin
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_run(itor_t begin, itor_t end, value_type *obj,
+                                list_type const &list, index_sequence<>) {
+    return begin;
+  }
+
+  /** deserialize the run of bools which starts at the ix-th item
+   * @tparam ix index of the item
+   * @tparam itor_t type of the input iterator
+   * @tparam k offsets of the members in the run
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @param[in] list items
+   * @return iterator pointint to the top of the unused area
+   */
+  template <size_t ix, typename itor_t, size_t... k>
+  static itor_t deserialize_run(itor_t begin, itor_t end, value_type *obj,
+                                list_type const &list, index_sequence<k...>) {
+    using bits = bit_codec<sizeof...(k)>;
+    if (!is_fixed_size<value_type>::value) {
+      require_size(begin, end, bits::size);
+    }
+    bool values[sizeof...(k)];
+    auto p = bits::deserialize(begin, end, values);
+    int const expanded[] = {
+        0, ((obj->*std::get<ix + k>(list)) = values[k], 0)...};
+    static_cast<void>(expanded);
+    return p;
+  }
+
+  /** deserialize the ix-th item which is a bool member
+   * @tparam ix index of the item
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @param[in] list items
+   * @return iterator pointint to the top of the unused area
+   */
+  template <size_t ix, typename itor_t>
+  static itor_t deserialize_item(itor_t begin, itor_t end, value_type *obj,
+                                 list_type const &list, std::true_type) {
+    return deserialize_run<ix>(begin, end, obj, list,
+                               make_index_sequence<runs::length(ix)>());
+  }
+
+  /** deserialize items in order
+   * @tparam itor_t type of the input iterator
+   * @tparam ix indices of the items
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t, size_t... ix>
+  static itor_t deserialize_items(itor_t begin, itor_t end, value_type *obj,
+                                  index_sequence<ix...>) {
+    auto const list = items<value_type>::list();
+    int const expanded[] = {
+        0, (begin = deserialize_item<ix>(
+                begin, end, obj, list,
+                is_bool_member<
+                    typename std::tuple_element<ix, list_type>::type>()),
+            0)...};
+    static_cast<void>(expanded);
+    static_cast<void>(list);
+    return begin;
+  }
+
+  /** deserialize obj from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj) {
+    return deserialize_items(begin, end, obj, indices());
+  }
+};
+
+/** template to serialize and deserialize the group of bool members as bits
+ * @tparam owner type of struct or class
+ * @tparam members pointers to the bool data members
+ */
+template <typename owner, bool owner::*... members> struct bool_group_codec {
+  /** type to serialize and deserialize the bits */
+  using bits = bit_codec<sizeof...(members)>;
+
+  /** byte count of serialized size */
+  enum { size = bits::size };
+
+  /** byte count of serialized obj
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static constexpr size_t serialized_size(owner const *obj) {
+    return bits::size;
+  }
+
+  /** serialize the members to output iterator
+   * @tparam itor_t type of the output iterator
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] obj pointer to the object which has the members
+   * @return iterator which points to the begin of the unused area
+   */
+  template <typename itor_t>
+  static itor_t serialize(itor_t begin, itor_t end, owner const *obj) {
+    bool const values[] = {(obj->*members)...};
+    return bits::serialize(begin, end, values);
+  }
+
+  /** deserialize the members from input iterator
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the object which has the members
+   * @return iterator pointint to the top of the unused area
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, owner *obj) {
+    bool values[sizeof...(members)];
+    auto p = bits::deserialize(begin, end, values);
+    bool const *v = values;
+    int done[] = {0, ((obj->*members = *v++), 0)...};
+    (void)done;
+    return p;
+  }
+};
+
+} // namespace loleseri
+
+/** type to serialize array of bools or bool members of struct as bits
+ * @tparam value_type array of bools, or struct or class
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, loleseri::byte_order order>
+struct loleseri::serializer_impl<loleseri::packed_bools<value_type>,
+                                 loleseri::tcat::other, order>
+    : public loleseri::packed_codec<value_type, order> {};
+
+/** type to deserialize array of bools or bool members of struct as bits
+ * @tparam value_type array of bools, or struct or class
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, loleseri::byte_order order>
+struct loleseri::deserializer_impl<loleseri::packed_bools<value_type>,
+                                   loleseri::tcat::other, order>
+    : public loleseri::packed_codec<value_type, order> {};
+
+/** type to serialize the group of bool members as bits
+ * @tparam owner type of struct or class
+ * @tparam members pointers to the bool data members
+ * @tparam order byte order of serialized data
+ */
+template <typename owner, bool owner::*... members, loleseri::byte_order order>
+struct loleseri::serializer_impl<loleseri::bool_group<owner, members...>,
+                                 loleseri::tcat::other, order>
+    : public loleseri::bool_group_codec<owner, members...> {};
+
+/** type to deserialize the group of bool members as bits
+ * @tparam owner type of struct or class
+ * @tparam members pointers to the bool data members
+ * @tparam order byte order of serialized data
+ */
+template <typename owner, bool owner::*... members, loleseri::byte_order order>
+struct loleseri::deserializer_impl<loleseri::bool_group<owner, members...>,
+                                   loleseri::tcat::other, order>
+    : public loleseri::bool_group_codec<owner, members...> {};
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <loleseri/loleseri.hpp>
+#include <thread>
+#include <vector>
+
+namespace loleseri {
+
+/** executor which runs all tasks on the calling thread */
+struct sequential_executor {
+  /** count of tasks to split the work into
+   * @param[in] byte_count byte count of the work
+   * @return always 1
+   */
+  size_t task_count(size_t byte_count) const { return 1; }
+
+  /** run tasks
+   * @tparam task_t type of the task. called as task(index_of_task)
+   * @param[in] count count of the tasks
+   * @param[in] task task to run
+   */
+  template <typename task_t> void run(size_t count, task_t const &task) const {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+  }
+};
+
+/** executor which runs tasks on threads.
+ * works smaller than grain_size bytes per thread are not split.
+ * @tparam thread_type type of the thread. constructed as
+ * thread_type(function, argument) and joined by join() like std::thread.
+ */
+template <typename thread_type = std::thread> class basic_thread_executor {
+public:
+  /** create executor
+   * @param[in] thread_count maximum count of the threads ( 0 means
+   * std::thread::hardware_concurrency() )
+   * @param[in] grain_size minimum byte count of the work of a thread
+   */
+  explicit basic_thread_executor(size_t thread_count = 0,
+                                 size_t grain_size = 256 * 1024)
+      : thread_count_(thread_count != 0
+                          ? thread_count
+                          : std::max<size_t>(
+                                1, std::thread::hardware_concurrency())),
+        grain_size_(std::max<size_t>(1, grain_size)) {}
+
+  /** count of tasks to split the work into
+   * @param[in] byte_count byte count of the work
+   * @return count of tasks
+   */
+  size_t task_count(size_t byte_count) const {
+    return std::max<size_t>(
+        1, std::min<size_t>(thread_count_, byte_count / grain_size_));
+  }
+
+  /** run tasks. the first task runs on the calling thread, the others on new
+   * threads. if a thread cannot be started, the tasks without threads run on
+   * the calling thread. the first exception thrown by the tasks is rethrown
+   * after all tasks finish.
+   * @tparam task_t type of the task. called as task(index_of_task)
+   * @param[in] count count of the tasks
+   * @param[in] task task to run
+   */
+  template <typename task_t> void run(size_t count, task_t const &task) const {
+    if (count == 0) {
+      return;
+    }
+    std::vector<std::exception_ptr> errors(count);
+    auto guarded = [&task, &errors](size_t ix) {
+      try {
+        task(ix);
+      } catch (...) {
+        errors[ix] = std::current_exception();
+      }
+    };
+    std::vector<thread_type> threads;
+    threads.reserve(count - 1);
+    size_t started = 1;
+    try {
+      for (; started < count; ++started) {
+        threads.emplace_back(guarded, started);
+      }
+    } catch (...) {
+      // e.g. std::system_error. the started threads must be joined anyway.
+    }
+    guarded(0);
+    for (size_t i = started; i < count; ++i) {
+      guarded(i);
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+    for (auto const &e : errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
+  }
+
+private:
+  /** maximum count of the threads */
+  size_t thread_count_;
+
+  /** minimum byte count of the work of a thread */
+  size_t grain_size_;
+};
+
+/** executor which runs tasks on std::thread */
+using thread_executor = basic_thread_executor<>;
+
+/** template to serialize or deserialize many records of fixed size at once.
+ * the i-th record is placed at i * size, so the records are split into
+ * tasks and processed by the executor.
+ * @tparam target type of the record
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order = byte_order::little>
+struct batch {
+  static_assert(is_fixed_size<target>::value,
+                "only fixed size types can be processed in batch");
+
+  /** type to serialize the record */
+  using seri = serializer<target, order>;
+
+  /** type to deserialize the record */
+  using deseri = deserializer<target, order>;
+
+  /** byte count of serialized size of the record */
+  enum { size = seri::size };
+
+  /** split records into tasks and run them
+   * @tparam executor_t type of the executor
+   * @tparam work_t type of the work. called as work(first_index, end_index)
+   * @param[in] count count of the records
+   * @param[in] executor executor to run the tasks
+   * @param[in] work work to run
+   */
+  template <typename executor_t, typename work_t>
+  static void run(size_t count, executor_t const &executor,
+                  work_t const &work) {
+    size_t const tasks = std::max<size_t>(
+        1, std::min(count, executor.task_count(size * count)));
+    if (tasks == 1) {
+      work(0, count);
+      return;
+    }
+    executor.run(tasks, [count, tasks, &work](size_t t) {
+      work(count * t / tasks, count * (t + 1) / tasks);
+    });
+  }
+
+  /** serialize records
+   * @tparam itor_t type of the random access output iterator
+   * @tparam executor_t type of the executor
+   * @param[in] begin top of the output iterator
+   * @param[in] end end of the output iterator
+   * @param[in] first pointer to the first record
+   * @param[in] count count of the records
+   * @param[in] executor executor to run the tasks
+   * @return iterator which points to the begin of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t, typename executor_t>
+  static itor_t serialize(itor_t begin, itor_t end, target const *first,
+                          size_t count, executor_t const &executor) {
+    require_size(begin, end, size * count);
+    run(count, executor, [begin, end, first](size_t b, size_t e) {
+      auto p = begin + size * b;
+      for (size_t i = b; i < e; ++i) {
+        p = seri::serialize(p, end, first + i);
+      }
+    });
+    return begin + size * count;
+  }
+
+  /** deserialize records
+   * @tparam itor_t type of the random access input iterator
+   * @tparam executor_t type of the executor
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] first pointer to the first record to write
+   * @param[in] count count of the records
+   * @param[in] executor executor to run the tasks
+   * @return iterator pointint to the top of the unused area
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename itor_t, typename executor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target *first,
+                            size_t count, executor_t const &executor) {
+    require_size(begin, end, size * count);
+    run(count, executor, [begin, end, first](size_t b, size_t e) {
+      auto p = begin + size * b;
+      for (size_t i = b; i < e; ++i) {
+        p = deseri::deserialize(p, end, first + i);
+      }
+    });
+    return begin + size * count;
+  }
+};
+
+/** serialize records on threads
+ * @tparam target type of the record
+ * @tparam itor random access output iterator type
+ * @tparam executor_t type of the executor
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor,
+          typename executor_t = thread_executor>
+itor serialize_n(itor begin, itor end, target const *first, size_t count,
+                 executor_t const &executor = executor_t()) {
+  return batch<target>::serialize(begin, end, first, count, executor);
+}
+
+/** serialize records on threads with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the record
+ * @tparam itor random access output iterator type
+ * @tparam executor_t type of the executor
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename itor,
+          typename executor_t = thread_executor>
+itor serialize_n(itor begin, itor end, target const *first, size_t count,
+                 executor_t const &executor = executor_t()) {
+  return batch<target, order>::serialize(begin, end, first, count, executor);
+}
+
+/** deserialize records on threads
+ * @tparam target type of the record
+ * @tparam itor random access input iterator type
+ * @tparam executor_t type of the executor
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename itor,
+          typename executor_t = thread_executor>
+itor deserialize_n(itor begin, itor end, target *first, size_t count,
+                   executor_t const &executor = executor_t()) {
+  return batch<target>::deserialize(begin, end, first, count, executor);
+}
+
+/** deserialize records on threads with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the record
+ * @tparam itor random access input iterator type
+ * @tparam executor_t type of the executor
+ * @return top of iterator pointing to the top of unused area
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename itor,
+          typename executor_t = thread_executor>
+itor deserialize_n(itor begin, itor end, target *first, size_t count,
+                   executor_t const &executor = executor_t()) {
+  return batch<target, order>::deserialize(begin, end, first, count,
+                                           executor);
+}
+
+} // namespace loleseri
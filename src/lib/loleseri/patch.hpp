@@ -0,0 +1,484 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/projection.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+namespace loleseri {
+
+/** exception thrown if the member is not in items<T>::list() or the index
+ * is out of range */
+class invalid_path : public std::invalid_argument {
+public:
+  /** create exception */
+  invalid_path() : std::invalid_argument("loleseri: invalid path to patch") {}
+};
+
+/** template to calculate the offset of the value in serialized data of
+ * fixed size at compile time
+ * @tparam value_type type of the serialized value
+ * @tparam path field<...> to the value
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, typename path,
+          int typecat = type_category<
+              typename std::remove_cv<value_type>::type>::value>
+struct field_offset;
+
+/** template to calculate the offset of the value itself */
+template <typename value_type, int typecat>
+struct field_offset<value_type, field<>, typecat> {
+  /** type of the value */
+  using type = value_type;
+
+  enum { value = 0 };
+};
+
+/** template to calculate the offset of the value in struct or class
+ * @tparam value_type type of struct or class
+ * @tparam ix index of the item
+ * @tparam rest rest of the path
+ */
+template <typename value_type, size_t ix, size_t... rest>
+struct field_offset<value_type, field<ix, rest...>, tcat::other> {
+  /** type of the list of items */
+  using list_type = item_list_type<value_type>;
+
+  static_assert(ix < std::tuple_size<list_type>::value, "ix is too big");
+
+  /** type of the item */
+  using item = typename std::tuple_element<ix, list_type>::type;
+
+  static_assert(std::is_same<typename item_codec<item>::codec_type,
+                             typename item_codec<item>::value_type>::value,
+                "items in their own encoding cannot be patched");
+
+  /** result of the rest of the path */
+  using next =
+      field_offset<typename item_codec<item>::value_type, field<rest...>>;
+
+  /** type of the value */
+  using type = typename next::type;
+
+  enum { value = offset_of_item<list_type, ix>::value + next::value };
+};
+
+/** template to calculate the offset of the value in array
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ * @tparam ix index of the element
+ * @tparam rest rest of the path
+ */
+template <typename element_type, size_t count, size_t ix, size_t... rest>
+struct field_offset_of_array {
+  static_assert(ix < count, "ix is too big");
+
+  /** result of the rest of the path */
+  using next = field_offset<element_type, field<rest...>>;
+
+  /** type of the value */
+  using type = typename next::type;
+
+  enum { value = serializer<element_type>::size * ix + next::value };
+};
+
+/** template to calculate the offset of the value in std::array */
+template <typename value_type, size_t ix, size_t... rest>
+struct field_offset<value_type, field<ix, rest...>, tcat::std_array>
+    : public field_offset_of_array<typename value_type::value_type,
+                                   std::tuple_size<value_type>::value, ix,
+                                   rest...> {};
+
+/** template to calculate the offset of the value in traditional array */
+template <typename value_type, size_t ix, size_t... rest>
+struct field_offset<value_type, field<ix, rest...>, tcat::array>
+    : public field_offset_of_array<
+          typename element_type_of_array<value_type>::type,
+          std::extent<value_type>::value, ix, rest...> {};
+
+/** template to find the offset of the item pointed to by the member pointer
+ * at runtime. only the items of the same type are compared, and their
+ * offsets are constants.
+ * @tparam owner type of struct or class
+ * @tparam member_type type of the member
+ */
+template <typename owner, typename member_type> struct member_locator {
+  /** type of the list of items */
+  using list_type = item_list_type<owner>;
+
+  /** indices of the items */
+  using indices = make_index_sequence<std::tuple_size<list_type>::value>;
+
+  /** true if the ix-th item has the type of the member
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using same = std::is_same<typename std::tuple_element<ix, list_type>::type,
+                            member_type owner::*>;
+
+  /** check the ix-th item which has the same type
+   * @tparam ix index of the item
+   * @param[in] list items
+   * @param[in] m pointer to the member
+   * @return true if the ix-th item is m
+   */
+  template <size_t ix>
+  static bool matches(list_type const &list, member_type owner::*m,
+                      std::true_type) {
+    return std::get<ix>(list) == m;
+  }
+
+  /** skip the ix-th item which has another type
+   * @tparam ix index of the item
+   * @return false
+   */
+  template <size_t ix>
+  static bool matches(list_type const &, member_type owner::*,
+                      std::false_type) {
+    return false;
+  }
+
+  /** find the offset of the item
+   * @tparam ix indices of the items
+   * @param[in] list items
+   * @param[in] m pointer to the member
+   * @return offset of the item
+   * @throw invalid_path if m is not in the items
+   */
+  template <size_t... ix>
+  static size_t find(list_type const &list, member_type owner::*m,
+                     index_sequence<ix...>) {
+    bool const found[] = {false, matches<ix>(list, m, same<ix>())...};
+    size_t const offsets[] = {0, offset_of_item<list_type, ix>::value...};
+    for (size_t i = 1; i < sizeof...(ix) + 1; ++i) {
+      if (found[i]) {
+        return offsets[i];
+      }
+    }
+    throw invalid_path();
+  }
+
+  /** find the offset of the item
+   * @param[in] list items
+   * @param[in] m pointer to the member
+   * @return offset of the item
+   * @throw invalid_path if m is not in the items
+   */
+  static size_t find(list_type const &list, member_type owner::*m) {
+    return find(list, m, indices());
+  }
+};
+
+/** template to get the offset of the step of the path at runtime
+ * @tparam value_type type of the serialized value
+ * @tparam step type of the step ( member pointer or index )
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, typename step,
+          int typecat = type_category<
+              typename std::remove_cv<value_type>::type>::value>
+struct patch_step;
+
+/** template to get the offset of the member of struct or class
+ * @tparam owner type of struct or class
+ * @tparam member_type type of the member
+ */
+template <typename owner, typename member_type>
+struct patch_step<owner, member_type owner::*, tcat::other> {
+  /** type of the member */
+  using type = member_type;
+
+  /** offset of the member
+   * @param[in] m pointer to the member
+   * @return offset
+   * @throw invalid_path if m is not in items<owner>::list()
+   */
+  static size_t offset(member_type owner::*m) {
+    using locator = member_locator<owner, member_type>;
+    return locator::find(items<owner>::list(), m);
+  }
+};
+
+/** template to get the offset of the element of array
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ * @tparam step integer type of the index
+ */
+template <typename element_type, size_t count, typename step>
+struct patch_step_of_array {
+  static_assert(std::is_integral<step>::value, "index should be integer");
+
+  /** type of the element */
+  using type = element_type;
+
+  /** offset of the element
+   * @param[in] ix index of the element
+   * @return offset
+   * @throw invalid_path if ix is out of range
+   */
+  static size_t offset(step ix) {
+    using is_signed = std::integral_constant<bool, std::is_signed<step>::value>;
+    if (negative(ix, is_signed()) || count <= static_cast<std::uint64_t>(ix)) {
+      throw invalid_path();
+    }
+    return serializer<element_type>::size * static_cast<size_t>(ix);
+  }
+
+private:
+  static bool negative(step ix, std::true_type) { return ix < 0; }
+  static bool negative(step, std::false_type) { return false; }
+};
+
+/** template to get the offset of the element of std::array */
+template <typename value_type, typename step>
+struct patch_step<value_type, step, tcat::std_array>
+    : public patch_step_of_array<typename value_type::value_type,
+                                 std::tuple_size<value_type>::value, step> {};
+
+/** template to get the offset of the element of traditional array */
+template <typename value_type, typename step>
+struct patch_step<value_type, step, tcat::array>
+    : public patch_step_of_array<
+          typename element_type_of_array<value_type>::type,
+          std::extent<value_type>::value, step> {};
+
+/** template to get the offset of the value at the path at runtime
+ * @tparam value_type type of the serialized value
+ * @tparam steps types of the steps ( member pointers or indices )
+ */
+template <typename value_type, typename... steps> struct patch_path;
+
+/** template to get the offset of the value itself */
+template <typename value_type> struct patch_path<value_type> {
+  /** type of the value */
+  using type = value_type;
+
+  /** returns 0
+   * @return offset
+   */
+  static size_t offset() { return 0; }
+};
+
+/** template to get the offset of the value at the path at runtime
+ * @tparam value_type type of the serialized value
+ * @tparam step0 type of the first step
+ * @tparam steps types of the rest of the steps
+ */
+template <typename value_type, typename step0, typename... steps>
+struct patch_path<value_type, step0, steps...> {
+  /** type to get the offset of the first step */
+  using first = patch_step<value_type, step0>;
+
+  /** type to get the offset of the rest of the steps */
+  using next = patch_path<typename first::type, steps...>;
+
+  /** type of the value */
+  using type = typename next::type;
+
+  /** offset of the value
+   * @param[in] s0 first step
+   * @param[in] s rest of the steps
+   * @return offset
+   */
+  static size_t offset(step0 s0, steps... s) {
+    return first::offset(s0) + next::offset(s...);
+  }
+};
+
+/** template to overwrite the value in the serialized data of fixed size
+ * @tparam target type of the serialized value
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct patcher {
+  static_assert(is_fixed_size<target>::value,
+                "serialized value to patch must have fixed size");
+
+  /** overwrite the value at the offset
+   * @tparam value_type type of the value
+   * @tparam itor_t type of the random access iterator
+   * @param[in] begin top of the serialized value
+   * @param[in] end end of the range
+   * @param[in] offset offset of the value
+   * @param[in] value new value
+   * @return iterator pointing to the next of the written value
+   * @throw buffer_overrun if the range is too short
+   */
+  template <typename value_type, typename itor_t>
+  static itor_t write(itor_t begin, itor_t end, size_t offset,
+                      value_type const &value) {
+    require_size(begin, end, serializer<target>::size);
+    auto const p = std::next(begin, static_cast<std::ptrdiff_t>(offset));
+    return serializer<value_type, order>::serialize(p, end, &value);
+  }
+};
+
+/** overwrite the value at the path in the serialized data of fixed size,
+ * like patch<foo, field<1, 3>>(begin, end, value). the offset is calculated
+ * at compile time.
+ * @tparam target type of the serialized value
+ * @tparam path field<...> to the value
+ * @tparam itor random access iterator type
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ */
+template <typename target, typename path, typename itor>
+itor patch(itor begin, itor end,
+           typename field_offset<target, path>::type const &value) {
+  using offset = field_offset<target, path>;
+  return patcher<target, byte_order::little>::write(begin, end, offset::value,
+                                                    value);
+}
+
+/** overwrite the value at the path with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the serialized value
+ * @tparam path field<...> to the value
+ * @tparam itor random access iterator type
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ */
+template <byte_order order, typename target, typename path, typename itor>
+itor patch(itor begin, itor end,
+           typename field_offset<target, path>::type const &value) {
+  using offset = field_offset<target, path>;
+  return patcher<target, order>::write(begin, end, offset::value, value);
+}
+
+/** overwrite the member in the serialized data of fixed size, like
+ * patch<foo>(begin, end, &foo::bar, value)
+ * @tparam target type of the serialized value
+ * @tparam itor random access iterator type
+ * @tparam step0 type of the member pointer
+ * @param[in] s0 pointer to the member
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ * @throw invalid_path if the member is not in items<target>::list()
+ */
+template <typename target, typename itor, typename step0>
+itor patch(itor begin, itor end, step0 s0,
+           typename patch_path<target, step0>::type const &value) {
+  using path = patch_path<target, step0>;
+  return patcher<target, byte_order::little>::write(begin, end,
+                                                    path::offset(s0), value);
+}
+
+/** overwrite the value in the serialized data of fixed size, like
+ * patch<foo>(begin, end, &foo::bar, &bar::baz, value) or
+ * patch<foo>(begin, end, &foo::values, 3, value)
+ * @tparam target type of the serialized value
+ * @tparam itor random access iterator type
+ * @tparam step0 type of the member pointer
+ * @tparam step1 type of the member pointer or the index
+ * @param[in] s0 pointer to the member
+ * @param[in] s1 pointer to the member or the index
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ * @throw invalid_path if the path is invalid
+ */
+template <typename target, typename itor, typename step0, typename step1>
+itor patch(itor begin, itor end, step0 s0, step1 s1,
+           typename patch_path<target, step0, step1>::type const &value) {
+  using path = patch_path<target, step0, step1>;
+  return patcher<target, byte_order::little>::write(
+      begin, end, path::offset(s0, s1), value);
+}
+
+/** overwrite the value in the serialized data of fixed size, like
+ * patch<foo>(begin, end, &foo::bars, 3, &bar::baz, value)
+ * @tparam target type of the serialized value
+ * @tparam itor random access iterator type
+ * @tparam step0 type of the member pointer
+ * @tparam step1 type of the member pointer or the index
+ * @tparam step2 type of the member pointer or the index
+ * @param[in] s0 pointer to the member
+ * @param[in] s1 pointer to the member or the index
+ * @param[in] s2 pointer to the member or the index
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ * @throw invalid_path if the path is invalid
+ */
+template <typename target, typename itor, typename step0, typename step1,
+          typename step2>
+itor patch(
+    itor begin, itor end, step0 s0, step1 s1, step2 s2,
+    typename patch_path<target, step0, step1, step2>::type const &value) {
+  using path = patch_path<target, step0, step1, step2>;
+  return patcher<target, byte_order::little>::write(
+      begin, end, path::offset(s0, s1, s2), value);
+}
+
+/** overwrite the member with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the serialized value
+ * @tparam itor random access iterator type
+ * @tparam step0 type of the member pointer
+ * @param[in] s0 pointer to the member
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ * @throw invalid_path if the member is not in items<target>::list()
+ */
+template <byte_order order, typename target, typename itor, typename step0>
+itor patch(itor begin, itor end, step0 s0,
+           typename patch_path<target, step0>::type const &value) {
+  using path = patch_path<target, step0>;
+  return patcher<target, order>::write(begin, end, path::offset(s0), value);
+}
+
+/** overwrite the value with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the serialized value
+ * @tparam itor random access iterator type
+ * @tparam step0 type of the member pointer
+ * @tparam step1 type of the member pointer or the index
+ * @param[in] s0 pointer to the member
+ * @param[in] s1 pointer to the member or the index
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ * @throw invalid_path if the path is invalid
+ */
+template <byte_order order, typename target, typename itor, typename step0,
+          typename step1>
+itor patch(itor begin, itor end, step0 s0, step1 s1,
+           typename patch_path<target, step0, step1>::type const &value) {
+  using path = patch_path<target, step0, step1>;
+  return patcher<target, order>::write(begin, end, path::offset(s0, s1),
+                                       value);
+}
+
+/** overwrite the value with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the serialized value
+ * @tparam itor random access iterator type
+ * @tparam step0 type of the member pointer
+ * @tparam step1 type of the member pointer or the index
+ * @tparam step2 type of the member pointer or the index
+ * @param[in] s0 pointer to the member
+ * @param[in] s1 pointer to the member or the index
+ * @param[in] s2 pointer to the member or the index
+ * @param[in] value new value
+ * @return iterator pointing to the next of the written value
+ * @throw buffer_overrun if the range is too short
+ * @throw invalid_path if the path is invalid
+ */
+template <byte_order order, typename target, typename itor, typename step0,
+          typename step1, typename step2>
+itor patch(
+    itor begin, itor end, step0 s0, step1 s1, step2 s2,
+    typename patch_path<target, step0, step1, step2>::type const &value) {
+  using path = patch_path<target, step0, step1, step2>;
+  return patcher<target, order>::write(begin, end, path::offset(s0, s1, s2),
+                                       value);
+}
+
+} // namespace loleseri
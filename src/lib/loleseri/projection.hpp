@@ -0,0 +1,746 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <loleseri/loleseri.hpp>
+#include <tuple>
+#include <type_traits>
+
+namespace loleseri {
+
+/** path to the value to deserialize. field<1> is the item 1 of the struct,
+ * and field<1, 2> is the item 2 ( or the element 2 ) of the item 1.
+ * @tparam ix indices of the items or the elements
+ */
+template <size_t... ix> struct field {};
+
+/** list of paths
+ * @tparam fields paths in ascending order
+ */
+template <typename... fields> struct field_list {};
+
+/** template to add the path to the top of the list
+ * @tparam path path to add
+ * @tparam list list of paths
+ */
+template <typename path, typename list> struct prepend_field;
+
+/** template to add the path to the top of the list
+ * @tparam path path to add
+ * @tparam fields paths in the list
+ */
+template <typename path, typename... fields>
+struct prepend_field<path, field_list<fields...>> {
+  /** list with the path */
+  using type = field_list<path, fields...>;
+};
+
+/** template to select the paths which start with ix
+ * @tparam ix index of the item or the element
+ * @tparam list list of paths
+ */
+template <size_t ix, typename list> struct select_fields;
+
+/** template to select the paths which start with ix from empty list */
+template <size_t ix> struct select_fields<ix, field_list<>> {
+  /** rest of the selected paths */
+  using type = field_list<>;
+
+  /** paths which do not start with ix */
+  using rest = field_list<>;
+
+  enum {
+    /** true if the whole value is selected */
+    whole = false
+  };
+};
+
+/** template to select the paths which start with ix
+ * @tparam ix index of the item or the element
+ * @tparam head first index of the first path
+ * @tparam tail rest of the indices of the first path
+ * @tparam fields rest of the paths
+ */
+template <size_t ix, size_t head, size_t... tail, typename... fields>
+struct select_fields<ix, field_list<field<head, tail...>, fields...>> {
+  /** result of the rest of the paths */
+  using next = select_fields<ix, field_list<fields...>>;
+
+  /** rest of the selected paths */
+  using type = typename std::conditional<
+      ix == head,
+      typename prepend_field<field<tail...>, typename next::type>::type,
+      typename next::type>::type;
+
+  /** paths which do not start with ix */
+  using rest = typename std::conditional<
+      ix == head, typename next::rest,
+      typename prepend_field<field<head, tail...>,
+                             typename next::rest>::type>::type;
+
+  enum {
+    /** true if the whole value is selected */
+    whole = (ix == head && sizeof...(tail) == 0) || next::whole
+  };
+};
+
+/** template to get the first index of the first path
+ * @tparam list list of paths
+ */
+template <typename list> struct first_field;
+
+/** template to get the first index of the first path
+ * @tparam head first index of the first path
+ * @tparam tail rest of the indices of the first path
+ * @tparam fields rest of the paths
+ */
+template <size_t head, size_t... tail, typename... fields>
+struct first_field<field_list<field<head, tail...>, fields...>> {
+  enum { value = head };
+};
+
+/** template to check the first indices of the paths are in ascending order
+ * @tparam list list of paths
+ */
+template <typename list> struct fields_sorted : public std::true_type {};
+
+/** template to check the first indices of the paths are in ascending order
+ * @tparam a first path
+ * @tparam b second path
+ * @tparam fields rest of the paths
+ */
+template <typename a, typename b, typename... fields>
+struct fields_sorted<field_list<a, b, fields...>>
+    : public std::integral_constant<
+          bool, (first_field<field_list<a>>::value <=
+                 first_field<field_list<b>>::value) &&
+                    fields_sorted<field_list<b, fields...>>::value> {};
+
+/** check that the range is long enough ( do nothing because the range was
+ * checked )
+ * @tparam itor_t type of the iterator
+ */
+template <typename itor_t>
+void require_size_if(itor_t, itor_t, size_t, std::false_type) {}
+
+/** check that the range is long enough
+ * @tparam itor_t type of the iterator
+ * @param[in] begin top of the range
+ * @param[in] end end of the range
+ * @param[in] size required byte count
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <typename itor_t>
+void require_size_if(itor_t begin, itor_t end, size_t size, std::true_type) {
+  require_size(begin, end, size);
+}
+
+/** template to skip serialized values
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of value_type
+ * @tparam fixed true if the size of value_type is fixed
+ */
+template <typename value_type, byte_order order,
+          int typecat = type_category<
+              typename std::remove_cv<value_type>::type>::value,
+          bool fixed = is_fixed_size<value_type>::value>
+struct skipper;
+
+/** template to skip serialized values of fixed size by single jump */
+template <typename value_type, byte_order order, int typecat>
+struct skipper<value_type, order, typecat, true> {
+  /** skip the values
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the values
+   * @return iterator pointint to the next of the values
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, size_t count, check_t check) {
+    size_t const size = serializer<value_type>::size * count;
+    require_size_if(begin, end, size, check);
+    return std::next(begin, static_cast<std::ptrdiff_t>(size));
+  }
+};
+
+/** template to skip std::vector and std::basic_string
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ */
+template <typename value_type, byte_order order> struct skipper_of_vector {
+  /** type of the element */
+  using element_type = typename value_type::value_type;
+
+  /** skip the values
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the values
+   * @return iterator pointint to the next of the values
+   * @throw buffer_overrun if the random access range is too short
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, size_t count, check_t) {
+    using length_deserializer = deserializer<length_type, order>;
+    for (size_t i = 0; i < count; ++i) {
+      require_size(begin, end, length_deserializer::size);
+      length_type length;
+      begin = length_deserializer::deserialize(begin, end, &length);
+      begin = skipper<element_type, order>::skip(begin, end, length,
+                                                 std::true_type());
+    }
+    return begin;
+  }
+};
+
+/** template to skip std::vector */
+template <typename value_type, byte_order order>
+struct skipper<value_type, order, tcat::vector, false>
+    : public skipper_of_vector<value_type, order> {};
+
+/** template to skip std::basic_string */
+template <typename value_type, byte_order order>
+struct skipper<value_type, order, tcat::string, false>
+    : public skipper_of_vector<value_type, order> {};
+
+/** template to skip std::array of variable size */
+template <typename value_type, byte_order order>
+struct skipper<value_type, order, tcat::std_array, false> {
+  /** skip the values
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the values
+   * @return iterator pointint to the next of the values
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, size_t count, check_t check) {
+    using element_skipper = skipper<typename value_type::value_type, order>;
+    size_t const length = std::tuple_size<value_type>::value;
+    return element_skipper::skip(begin, end, count * length, check);
+  }
+};
+
+/** template to skip traditional array of variable size */
+template <typename value_type, byte_order order>
+struct skipper<value_type, order, tcat::array, false> {
+  /** skip the values
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the values
+   * @return iterator pointint to the next of the values
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, size_t count, check_t check) {
+    using element_skipper =
+        skipper<typename element_type_of_array<value_type>::type, order>;
+    size_t const length = std::extent<value_type>::value;
+    return element_skipper::skip(begin, end, count * length, check);
+  }
+};
+
+/** template to get the serialized size of the type ( 0 if not fixed )
+ * @tparam type target type
+ * @tparam fixed true if the size of the type is fixed
+ */
+template <typename type, bool fixed = is_fixed_size<type>::value>
+struct fixed_size_of {
+  enum { value = serializer<type>::size };
+};
+
+/** template to get the serialized size of the type of variable size */
+template <typename type> struct fixed_size_of<type, false> {
+  enum { value = 0 };
+};
+
+/** template to calculate the byte count of the items if all of them have
+ * fixed size
+ * @tparam list_type type of the list of items
+ * @tparam from index of the first item
+ * @tparam to index of the next of the last item
+ */
+template <typename list_type, size_t from, size_t to> struct item_run {
+  /** type to select serializer of the first item */
+  using codec_type = typename item_codec<
+      typename std::tuple_element<from, list_type>::type>::codec_type;
+
+  /** result of the rest of the items */
+  using next = item_run<list_type, from + 1, to>;
+
+  enum {
+    /** true if all items have fixed size */
+    fixed = is_fixed_size<codec_type>::value && next::fixed,
+
+    /** byte count of the items ( 0 if not fixed ) */
+    size = fixed ? fixed_size_of<codec_type>::value + next::size : 0
+  };
+};
+
+/** template to calculate the byte count of no items */
+template <typename list_type, size_t to> struct item_run<list_type, to, to> {
+  enum { fixed = true, size = 0 };
+};
+
+/** template to skip the items of struct or class
+ * @tparam list_type type of the list of items
+ * @tparam order byte order of serialized data
+ * @tparam from index of the first item
+ * @tparam to index of the next of the last item
+ * @tparam fixed true if all items have fixed size
+ */
+template <typename list_type, byte_order order, size_t from, size_t to,
+          bool fixed = item_run<list_type, from, to>::fixed>
+struct skip_items {
+  /** skip the items of fixed size by single jump
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the next of the items
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, check_t check) {
+    size_t const size = item_run<list_type, from, to>::size;
+    require_size_if(begin, end, size, check);
+    return std::next(begin, static_cast<std::ptrdiff_t>(size));
+  }
+};
+
+/** template to skip the items of struct or class one by one */
+template <typename list_type, byte_order order, size_t from, size_t to>
+struct skip_items<list_type, order, from, to, false> {
+  /** type of the first item */
+  using item = typename std::tuple_element<from, list_type>::type;
+
+  /** type to select serializer and deserializer of the item */
+  using codec_type = typename item_codec<item>::codec_type;
+
+  /** data type of the item */
+  using value_type = typename item_codec<item>::value_type;
+
+  /** skip the item in its own encoding by deserializing it
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the next of the item
+   */
+  template <typename itor_t>
+  static itor_t skip_first(itor_t begin, itor_t end, std::false_type) {
+    value_type discarded;
+    return deserializer<codec_type, order>::deserialize(begin, end,
+                                                        &discarded);
+  }
+
+  /** skip the item
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the next of the item
+   */
+  template <typename itor_t>
+  static itor_t skip_first(itor_t begin, itor_t end, std::true_type) {
+    return skipper<value_type, order>::skip(begin, end, 1, std::true_type());
+  }
+
+  /** skip the items
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the next of the items
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, check_t check) {
+    using plain = std::integral_constant<
+        bool, std::is_same<codec_type, value_type>::value>;
+    auto p = skip_first(begin, end, plain());
+    return skip_items<list_type, order, from + 1, to>::skip(p, end, check);
+  }
+};
+
+/** template to skip struct or class of variable size */
+template <typename value_type, byte_order order>
+struct skipper<value_type, order, tcat::other, false> {
+  /** type of the list of items */
+  using list_type = item_list_type<value_type>;
+
+  /** skip the values
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] count count of the values
+   * @return iterator pointint to the next of the values
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t skip(itor_t begin, itor_t end, size_t count, check_t check) {
+    using all = skip_items<list_type, order, 0,
+                           std::tuple_size<list_type>::value>;
+    for (size_t i = 0; i < count; ++i) {
+      begin = all::skip(begin, end, check);
+    }
+    return begin;
+  }
+};
+
+/** template to deserialize the selected values only
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam list paths to the values to deserialize
+ * @tparam typecat integer to specity category of value_type
+ */
+template <typename value_type, byte_order order, typename list,
+          int typecat = type_category<
+              typename std::remove_cv<value_type>::type>::value>
+struct projection {
+  static_assert(typecat == tcat::other || typecat == tcat::std_array ||
+                    typecat == tcat::array,
+                "only struct, class and array have the items");
+};
+
+/** template to deserialize the value which is selected or has the selected
+ * values
+ * @tparam codec_type type to select deserializer
+ * @tparam value_type type of the value
+ * @tparam order byte order of serialized data
+ * @tparam whole true if the whole value is selected
+ * @tparam list paths to the values in the value to deserialize
+ */
+template <typename codec_type, typename value_type, byte_order order,
+          bool whole, typename list>
+struct project_into {
+  static_assert(std::is_same<codec_type, value_type>::value,
+                "items in their own encoding cannot be projected");
+
+  /** deserialize the selected values in the value
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj,
+                            check_t check) {
+    return projection<value_type, order, list>::deserialize(begin, end, obj,
+                                                            check);
+  }
+};
+
+/** template to deserialize the selected value */
+template <typename codec_type, typename value_type, byte_order order,
+          typename list>
+struct project_into<codec_type, value_type, order, true, list> {
+  /** deserialize the value
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj,
+                            check_t) {
+    using check = std::integral_constant<
+        bool, check_t::value && is_fixed_size<codec_type>::value>;
+    require_item_size<codec_type>(begin, end, check());
+    return deserializer<codec_type, order>::deserialize(begin, end, obj);
+  }
+};
+
+/** template to deserialize the selected items of struct or class
+ * @tparam value_type type of struct or class
+ * @tparam order byte order of serialized data
+ * @tparam list paths to the values to deserialize
+ * @tparam from index of the first item which is not processed
+ */
+template <typename value_type, byte_order order, typename list, size_t from>
+struct projection_items {
+  /** type of the list of items */
+  using list_type = item_list_type<value_type>;
+
+  /** index of the next selected item */
+  enum { ix = first_field<list>::value };
+
+  static_assert(ix < std::tuple_size<list_type>::value, "ix is too big");
+
+  /** paths which start with ix */
+  using selected = select_fields<ix, list>;
+
+  /** type of the item */
+  using item = typename std::tuple_element<ix, list_type>::type;
+
+  /** type to deserialize the item */
+  using project =
+      project_into<typename item_codec<item>::codec_type,
+                   typename item_codec<item>::value_type, order,
+                   selected::whole, typename selected::type>;
+
+  /** skip the items before ix, deserialize the item ix, and the rest
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[in] items list of items
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, list_type const &items,
+                            value_type *obj, check_t check) {
+    auto p = skip_items<list_type, order, from, ix>::skip(begin, end, check);
+    p = project::deserialize(p, end, &(obj->*std::get<ix>(items)), check);
+    using next = projection_items<value_type, order,
+                                  typename selected::rest, ix + 1>;
+    return next::deserialize(p, end, items, obj, check);
+  }
+};
+
+/** template to skip the rest of the items of struct or class */
+template <typename value_type, byte_order order, size_t from>
+struct projection_items<value_type, order, field_list<>, from> {
+  /** type of the list of items */
+  using list_type = item_list_type<value_type>;
+
+  /** skip the rest of the items
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, list_type const &,
+                            value_type *, check_t check) {
+    using rest =
+        skip_items<list_type, order, from, std::tuple_size<list_type>::value>;
+    return rest::skip(begin, end, check);
+  }
+};
+
+/** template to deserialize the selected items of struct or class */
+template <typename value_type, byte_order order, typename list>
+struct projection<value_type, order, list, tcat::other> {
+  static_assert(fields_sorted<list>::value,
+                "fields should be in ascending order");
+
+  /** deserialize the selected items
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj,
+                            check_t check) {
+    return projection_items<value_type, order, list, 0>::deserialize(
+        begin, end, items<value_type>::list(), obj, check);
+  }
+};
+
+/** template to deserialize the selected elements of array
+ * @tparam value_type type of the array
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ * @tparam order byte order of serialized data
+ * @tparam list paths to the values to deserialize
+ * @tparam from index of the first element which is not processed
+ */
+template <typename value_type, typename element_type, size_t count,
+          byte_order order, typename list, size_t from>
+struct projection_elements {
+  /** index of the next selected element */
+  enum { ix = first_field<list>::value };
+
+  static_assert(ix < count, "ix is too big");
+
+  /** paths which start with ix */
+  using selected = select_fields<ix, list>;
+
+  /** type to deserialize the element */
+  using project = project_into<element_type, element_type, order,
+                               selected::whole, typename selected::type>;
+
+  /** skip the elements before ix, deserialize the element ix, and the rest
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the array
+   * @return iterator pointint to the next of the array
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *obj,
+                            check_t check) {
+    using element_skipper = skipper<element_type, order>;
+    auto p = element_skipper::skip(begin, end, ix - from, check);
+    p = project::deserialize(p, end, &(*obj)[ix], check);
+    using next = projection_elements<value_type, element_type, count, order,
+                                     typename selected::rest, ix + 1>;
+    return next::deserialize(p, end, obj, check);
+  }
+};
+
+/** template to skip the rest of the elements of array */
+template <typename value_type, typename element_type, size_t count,
+          byte_order order, size_t from>
+struct projection_elements<value_type, element_type, count, order,
+                           field_list<>, from> {
+  /** skip the rest of the elements
+   * @tparam itor_t type of the input iterator
+   * @tparam check_t std::true_type to check the range
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @return iterator pointint to the next of the array
+   */
+  template <typename itor_t, typename check_t>
+  static itor_t deserialize(itor_t begin, itor_t end, value_type *,
+                            check_t check) {
+    return skipper<element_type, order>::skip(begin, end, count - from, check);
+  }
+};
+
+/** template to deserialize the selected elements of std::array */
+template <typename value_type, byte_order order, typename list>
+struct projection<value_type, order, list, tcat::std_array>
+    : public projection_elements<value_type, typename value_type::value_type,
+                                 std::tuple_size<value_type>::value, order,
+                                 list, 0> {
+  static_assert(fields_sorted<list>::value,
+                "fields should be in ascending order");
+};
+
+/** template to deserialize the selected elements of traditional array */
+template <typename value_type, byte_order order, typename list>
+struct projection<value_type, order, list, tcat::array>
+    : public projection_elements<
+          value_type, typename element_type_of_array<value_type>::type,
+          std::extent<value_type>::value, order, list, 0> {
+  static_assert(fields_sorted<list>::value,
+                "fields should be in ascending order");
+};
+
+/** template to deserialize the selected values only. the range of the value
+ * of fixed size is checked at once, and the offsets of the selected values
+ * are calculated at compile time.
+ * @tparam target target type
+ * @tparam order byte order of serialized data
+ * @tparam list paths to the values to deserialize
+ */
+template <typename target, byte_order order, typename list> struct projector {
+  /** type to deserialize the selected values */
+  using project = projection<target, order, list>;
+
+  /** deserialize the selected values of the value of fixed size
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target *obj,
+                            std::true_type) {
+    require_size(begin, end, serializer<target>::size);
+    return project::deserialize(begin, end, obj, std::false_type());
+  }
+
+  /** deserialize the selected values of the value of variable size
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target *obj,
+                            std::false_type) {
+    return project::deserialize(begin, end, obj, std::true_type());
+  }
+
+  /** deserialize the selected values. other values keep their values.
+   * @tparam itor_t type of the input iterator
+   * @param[in] begin top of the input iterator
+   * @param[in] end end of the input iterator
+   * @param[out] obj pointer to the value
+   * @return iterator pointint to the next of the value
+   * @throw buffer_overrun if the random access range is too short
+   */
+  template <typename itor_t>
+  static itor_t deserialize(itor_t begin, itor_t end, target *obj) {
+    return deserialize(begin, end, obj, is_fixed_size<target>());
+  }
+};
+
+/** deserialize the selected values only, like
+ * deserialize_fields<foo, field<0>, field<2, 1>>(begin, end, &obj).
+ * other values keep their values.
+ * @tparam target target type
+ * @tparam fields paths to the values in ascending order
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the next of the value
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <typename target, typename... fields, typename itor>
+itor deserialize_fields(itor begin, itor end, target *obj) {
+  using list = field_list<fields...>;
+  return projector<target, byte_order::little, list>::deserialize(begin, end,
+                                                                  obj);
+}
+
+/** deserialize the selected items only, like
+ * deserialize_fields<foo, 0, 2>(begin, end, &obj)
+ * @tparam target target type
+ * @tparam ix indices of the items in ascending order
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the next of the value
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <typename target, size_t... ix, typename itor>
+itor deserialize_fields(itor begin, itor end, target *obj) {
+  using list = field_list<field<ix>...>;
+  return projector<target, byte_order::little, list>::deserialize(begin, end,
+                                                                  obj);
+}
+
+/** deserialize the selected values only with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam fields paths to the values in ascending order
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the next of the value
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <byte_order order, typename target, typename... fields,
+          typename itor>
+itor deserialize_fields(itor begin, itor end, target *obj) {
+  using list = field_list<fields...>;
+  return projector<target, order, list>::deserialize(begin, end, obj);
+}
+
+/** deserialize the selected items only with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam ix indices of the items in ascending order
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the next of the value
+ * @throw buffer_overrun if the random access range is too short
+ */
+template <byte_order order, typename target, size_t... ix, typename itor>
+itor deserialize_fields(itor begin, itor end, target *obj) {
+  using list = field_list<field<ix>...>;
+  return projector<target, order, list>::deserialize(begin, end, obj);
+}
+
+} // namespace loleseri
@@ -0,0 +1,498 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <iterator>
+#include <loleseri/loleseri.hpp>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace loleseri {
+
+/** header of the record file. always serialized in little endian. */
+struct record_file_header {
+  /** "LLSR" */
+  std::array<std::uint8_t, 4> magic;
+
+  /** byte count of serialized size of the record */
+  std::uint32_t record_size;
+
+  /** count of the records */
+  std::uint64_t count;
+};
+
+/** items of the header of the record file */
+template <> struct items<record_file_header> {
+  using list_type =
+      std::tuple<std::array<std::uint8_t, 4> record_file_header::*,
+                 std::uint32_t record_file_header::*,
+                 std::uint64_t record_file_header::*>;
+  static inline list_type list() {
+    return {&record_file_header::magic, &record_file_header::record_size,
+            &record_file_header::count};
+  }
+};
+
+/** exception thrown if the file is not a record file of the type */
+class invalid_record_file : public std::runtime_error {
+public:
+  /** create exception
+   * @param[in] what description of the error
+   */
+  explicit invalid_record_file(char const *what)
+      : std::runtime_error(std::string("loleseri: ") + what) {}
+};
+
+/** file mapped to the memory */
+class mapped_file {
+public:
+  /** open and map the file
+   * @param[in] path path of the file
+   * @param[in] writable open for writing. the file is created if not exists.
+   * @throw std::system_error if failed to open or to map
+   */
+  mapped_file(std::string const &path, bool writable)
+      : fd_(::open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY,
+                   0644)),
+        writable_(writable), data_(nullptr), size_(0) {
+    if (fd_ < 0) {
+      throw_system_error("open");
+    }
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+      int const e = errno;
+      ::close(fd_);
+      throw std::system_error(e, std::generic_category(), "fstat");
+    }
+    try {
+      map(static_cast<size_t>(st.st_size));
+    } catch (...) {
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  mapped_file(mapped_file const &) = delete;
+  mapped_file &operator=(mapped_file const &) = delete;
+
+  /** move the mapping
+   * @param[in,out] that source of the mapping
+   */
+  mapped_file(mapped_file &&that)
+      : fd_(that.fd_), writable_(that.writable_), data_(that.data_),
+        size_(that.size_) {
+    that.fd_ = -1;
+    that.data_ = nullptr;
+    that.size_ = 0;
+  }
+
+  /** unmap and close the file */
+  ~mapped_file() {
+    unmap();
+    if (0 <= fd_) {
+      ::close(fd_);
+    }
+  }
+
+  /** top of the mapped memory
+   * @return address of the top of the file
+   */
+  std::uint8_t *data() const { return data_; }
+
+  /** byte count of the file
+   * @return byte count of the file
+   */
+  size_t size() const { return size_; }
+
+  /** change size of the file and map it again
+   * @param[in] size new byte count of the file
+   * @throw std::system_error if failed to resize or to map
+   */
+  void resize(size_t size) {
+    unmap();
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+      throw_system_error("ftruncate");
+    }
+    map(size);
+  }
+
+  /** write the modified pages to the file
+   * @throw std::system_error if failed
+   */
+  void sync() {
+    if (data_ != nullptr && ::msync(data_, size_, MS_SYNC) != 0) {
+      throw_system_error("msync");
+    }
+  }
+
+private:
+  /** throw std::system_error of errno
+   * @param[in] what name of the failed function
+   */
+  static void throw_system_error(char const *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  /** map the file
+   * @param[in] size byte count to map
+   */
+  void map(size_t size) {
+    if (size == 0) {
+      return;
+    }
+    int const prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *p = ::mmap(nullptr, size, prot, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+      throw_system_error("mmap");
+    }
+    data_ = static_cast<std::uint8_t *>(p);
+    size_ = size;
+  }
+
+  /** unmap the file */
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  /** file descriptor */
+  int fd_;
+
+  /** opened for writing */
+  bool writable_;
+
+  /** top of the mapped memory */
+  std::uint8_t *data_;
+
+  /** byte count of the mapped memory */
+  size_t size_;
+};
+
+/** constants and helpers of the record file
+ * @tparam target type of the record
+ * @tparam order byte order of the records
+ */
+template <typename target, byte_order order> struct record_file_format {
+  static_assert(is_fixed_size<target>::value,
+                "record file supports fixed size types only");
+
+  enum {
+    /** byte count of the header */
+    header_size = serializer<record_file_header>::size,
+
+    /** byte count of the record */
+    record_size = serializer<target, order>::size
+  };
+
+  /** read and check the header
+   * @param[in] file mapped file
+   * @return count of the records
+   * @throw invalid_record_file if the header is broken or does not match
+   */
+  static size_t read_header(mapped_file const &file) {
+    if (file.size() < header_size) {
+      throw invalid_record_file("file is too short");
+    }
+    auto const header = deserialize<record_file_header>(
+        file.data(), file.data() + header_size);
+    if (header.magic != magic()) {
+      throw invalid_record_file("not a record file");
+    }
+    if (header.record_size != record_size) {
+      throw invalid_record_file("record size does not match");
+    }
+    if ((file.size() - header_size) / record_size < header.count) {
+      throw invalid_record_file("file is too short");
+    }
+    return static_cast<size_t>(header.count);
+  }
+
+  /** write the header
+   * @param[in] file mapped file
+   * @param[in] count count of the records
+   */
+  static void write_header(mapped_file const &file, size_t count) {
+    record_file_header const header = {magic(), record_size, count};
+    serialize(file.data(), file.data() + header_size, &header);
+  }
+
+  /** magic number of the record file
+   * @return "LLSR"
+   */
+  static std::array<std::uint8_t, 4> magic() {
+    return {{'L', 'L', 'S', 'R'}};
+  }
+};
+
+/** read only record file. the file is mapped to the memory and the i-th
+ * record is deserialized from the offset i * record_size on access.
+ * @tparam target type of the record
+ * @tparam order byte order of the records
+ */
+template <typename target, byte_order order = byte_order::little>
+class record_file {
+  /** format of the file */
+  using format = record_file_format<target, order>;
+
+public:
+  /** type of the record */
+  using value_type = target;
+
+  /** type to deserialize the record */
+  using deseri = deserializer<target, order>;
+
+  enum {
+    /** byte count of the record */
+    record_size = format::record_size
+  };
+
+  /** input iterator to read the records */
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = target;
+    using difference_type = std::ptrdiff_t;
+    using pointer = target const *;
+    using reference = target;
+
+    /** create iterator
+     * @param[in] p top of the serialized record
+     */
+    explicit iterator(std::uint8_t const *p) : p_(p) {}
+
+    /** deserialize the record
+     * @return deserialized record
+     */
+    target operator*() const {
+      return deseri::deserialize(p_, p_ + record_size);
+    }
+
+    /** go to the next record
+     * @return this iterator
+     */
+    iterator &operator++() {
+      p_ += record_size;
+      return *this;
+    }
+
+    /** go to the next record
+     * @return copy of the iterator before increment
+     */
+    iterator operator++(int) {
+      iterator r = *this;
+      ++*this;
+      return r;
+    }
+
+    /** compare iterators
+     * @param[in] that iterator to compare
+     * @return true if both point to the same record
+     */
+    bool operator==(iterator const &that) const { return p_ == that.p_; }
+
+    /** compare iterators
+     * @param[in] that iterator to compare
+     * @return true if they point to different records
+     */
+    bool operator!=(iterator const &that) const { return p_ != that.p_; }
+
+  private:
+    /** top of the serialized record */
+    std::uint8_t const *p_;
+  };
+
+  /** open the file
+   * @param[in] path path of the file
+   * @throw std::system_error if failed to open or to map
+   * @throw invalid_record_file if the file is not a record file of target
+   */
+  explicit record_file(std::string const &path)
+      : file_(path, false), count_(format::read_header(file_)) {}
+
+  /** count of the records
+   * @return count of the records
+   */
+  size_t size() const { return count_; }
+
+  /** top of the serialized records
+   * @return address of the first record
+   */
+  std::uint8_t const *data() const {
+    return file_.data() + format::header_size;
+  }
+
+  /** deserialize the ix-th record without bounds check
+   * @param[in] ix index of the record
+   * @return deserialized record
+   */
+  target operator[](size_t ix) const {
+    auto p = data() + ix * record_size;
+    return deseri::deserialize(p, p + record_size);
+  }
+
+  /** deserialize the ix-th record
+   * @param[in] ix index of the record
+   * @return deserialized record
+   * @throw std::out_of_range if ix is not less than size()
+   */
+  target at(size_t ix) const {
+    if (count_ <= ix) {
+      throw std::out_of_range("loleseri: index of the record is too big");
+    }
+    return (*this)[ix];
+  }
+
+  /** iterator pointing to the first record
+   * @return iterator
+   */
+  iterator begin() const { return iterator(data()); }
+
+  /** iterator pointing to the next of the last record
+   * @return iterator
+   */
+  iterator end() const { return iterator(data() + count_ * record_size); }
+
+private:
+  /** mapped file */
+  mapped_file file_;
+
+  /** count of the records */
+  size_t count_;
+};
+
+/** writer to append records to the record file. the mapping grows
+ * geometrically, and the file is truncated to the used size on close.
+ * @tparam target type of the record
+ * @tparam order byte order of the records
+ */
+template <typename target, byte_order order = byte_order::little>
+class record_file_writer {
+  /** format of the file */
+  using format = record_file_format<target, order>;
+
+public:
+  /** type of the record */
+  using value_type = target;
+
+  /** type to serialize the record */
+  using seri = serializer<target, order>;
+
+  enum {
+    /** byte count of the record */
+    record_size = format::record_size
+  };
+
+  /** open the file. the records are appended to the existing records.
+   * @param[in] path path of the file. the file is created if not exists.
+   * @throw std::system_error if failed to open or to map
+   * @throw invalid_record_file if the file is not a record file of target
+   */
+  explicit record_file_writer(std::string const &path)
+      : file_(path, true), count_(0) {
+    if (file_.size() == 0) {
+      file_.resize(format::header_size);
+      format::write_header(file_, 0);
+    } else {
+      count_ = format::read_header(file_);
+    }
+  }
+
+  record_file_writer(record_file_writer const &) = delete;
+  record_file_writer &operator=(record_file_writer const &) = delete;
+
+  /** close the file. errors are ignored. call close() to catch them. */
+  ~record_file_writer() {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  /** count of the records
+   * @return count of the records
+   */
+  size_t size() const { return count_; }
+
+  /** append a record
+   * @param[in] obj record to append
+   * @throw std::system_error if failed to grow the file
+   */
+  void append(target const &obj) {
+    reserve(count_ + 1);
+    auto p = record(count_);
+    seri::serialize(p, p + record_size, &obj);
+    ++count_;
+  }
+
+  /** append records
+   * @param[in] first pointer to the first record
+   * @param[in] count count of the records
+   * @throw std::system_error if failed to grow the file
+   */
+  void append(target const *first, size_t count) {
+    reserve(count_ + count);
+    auto p = record(count_);
+    for (size_t i = 0; i < count; ++i) {
+      p = seri::serialize(p, p + record_size, first + i);
+    }
+    count_ += count;
+  }
+
+  /** write the header and the records to the file
+   * @throw std::system_error if failed
+   */
+  void flush() {
+    format::write_header(file_, count_);
+    file_.sync();
+  }
+
+  /** write the header and truncate the file to the used size
+   * @throw std::system_error if failed
+   */
+  void close() {
+    if (file_.data() == nullptr) {
+      return;
+    }
+    format::write_header(file_, count_);
+    file_.resize(format::header_size + count_ * record_size);
+    file_.sync();
+  }
+
+private:
+  /** address of the ix-th record
+   * @param[in] ix index of the record
+   * @return address of the record
+   */
+  std::uint8_t *record(size_t ix) const {
+    return file_.data() + format::header_size + ix * record_size;
+  }
+
+  /** grow the file to hold count records at least
+   * @param[in] count count of the records
+   */
+  void reserve(size_t count) {
+    size_t const capacity = (file_.size() - format::header_size) / record_size;
+    if (count <= capacity) {
+      return;
+    }
+    size_t const grown =
+        std::max<size_t>(count, std::max<size_t>(64, capacity * 2));
+    file_.resize(format::header_size + grown * record_size);
+  }
+
+  /** mapped file */
+  mapped_file file_;
+
+  /** count of the records */
+  size_t count_;
+};
+
+} // namespace loleseri
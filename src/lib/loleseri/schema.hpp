@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cstdint>
+#include <loleseri/loleseri.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+namespace loleseri {
+
+/** values to distinguish kinds of types in the schema hash */
+namespace schema_tag {
+
+/** bool */
+constexpr std::uint64_t boolean = 1;
+
+/** integer or floating point value */
+constexpr std::uint64_t arithmetic = 2;
+
+/** std::array or traditional array */
+constexpr std::uint64_t array = 3;
+
+/** std::vector */
+constexpr std::uint64_t vector = 4;
+
+/** std::basic_string */
+constexpr std::uint64_t string = 5;
+
+/** beginning of struct or class */
+constexpr std::uint64_t structure = 6;
+
+/** end of struct or class */
+constexpr std::uint64_t end_of_structure = 7;
+
+/** value in compact encoding ( compact.hpp ) */
+constexpr std::uint64_t compact = 8;
+
+/** array of bools packed into bits ( packed.hpp ) */
+constexpr std::uint64_t packed = 9;
+
+/** group of bool members packed into bits ( packed.hpp ) */
+constexpr std::uint64_t bool_group = 10;
+
+/** array of struct in columnar layout ( columnar.hpp ) */
+constexpr std::uint64_t columnar = 11;
+
+} // namespace schema_tag
+
+/** offset basis of 64bit FNV-1a */
+constexpr std::uint64_t fnv1a_offset = 0xcbf29ce484222325u;
+
+/** prime of 64bit FNV-1a */
+constexpr std::uint64_t fnv1a_prime = 0x100000001b3u;
+
+/** mix the bytes of the value into 64bit FNV-1a hash in little endian
+ * @param[in] h hash so far
+ * @param[in] v value to mix
+ * @param[in] bytes byte count of the value to mix
+ * @return hash
+ */
+constexpr std::uint64_t fnv1a(std::uint64_t h, std::uint64_t v,
+                              int bytes = 8) {
+  return bytes == 0 ? h
+                    : fnv1a((h ^ (v & 0xffu)) * fnv1a_prime, v >> 8,
+                            bytes - 1);
+}
+
+/** template to mix the layout of the type into the schema hash.
+ * specialize this for the types which have their own serializers.
+ * @tparam target_type type of the value
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename target_type,
+          int typecat = type_category<
+              typename std::remove_cv<target_type>::type>::value>
+struct schema_of;
+
+/** template to mix the layout of bool into the schema hash */
+template <typename target_type>
+struct schema_of<target_type, tcat::boolean> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return fnv1a(h, schema_tag::boolean);
+  }
+};
+
+/** template to mix the layout of integer or floating point value into the
+ * schema hash. the size, signedness and floating point or not are mixed.
+ */
+template <typename target_type>
+struct schema_of<target_type, tcat::arithmetic> {
+  /** kind of the value */
+  enum {
+    kind = std::is_floating_point<target_type>::value ? 2
+           : std::is_signed<target_type>::value       ? 1
+                                                      : 0
+  };
+
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return fnv1a(fnv1a(fnv1a(h, schema_tag::arithmetic), sizeof(target_type)),
+                 kind);
+  }
+};
+
+/** template to mix the layout of the array into the schema hash.
+ * std::array and traditional array of the same elements are the same.
+ * @tparam element_type type of the element
+ * @tparam count count of the elements
+ */
+template <typename element_type, size_t count> struct schema_of_array {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return schema_of<element_type>::hash(
+        fnv1a(fnv1a(h, schema_tag::array), count));
+  }
+};
+
+/** template to mix the layout of std::array into the schema hash */
+template <typename target_type>
+struct schema_of<target_type, tcat::std_array>
+    : public schema_of_array<typename target_type::value_type,
+                             std::tuple_size<target_type>::value> {};
+
+/** template to mix the layout of traditional array into the schema hash */
+template <typename target_type>
+struct schema_of<target_type, tcat::array>
+    : public schema_of_array<
+          typename element_type_of_array<target_type>::type,
+          std::extent<target_type>::value> {};
+
+/** template to mix the layout of std::vector into the schema hash */
+template <typename target_type>
+struct schema_of<target_type, tcat::vector> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return schema_of<typename target_type::value_type>::hash(
+        fnv1a(h, schema_tag::vector));
+  }
+};
+
+/** template to mix the layout of std::basic_string into the schema hash */
+template <typename target_type>
+struct schema_of<target_type, tcat::string> {
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return fnv1a(fnv1a(h, schema_tag::string),
+                 sizeof(typename target_type::value_type));
+  }
+};
+
+/** array of the hashes. the last element is a terminator to allow no
+ * hashes.
+ * @tparam values hashes
+ */
+template <std::uint64_t... values> struct hash_array {
+  /** hashes and the terminator */
+  static constexpr std::uint64_t data[sizeof...(values) + 1] = {values..., 0};
+};
+
+/** hashes and the terminator */
+template <std::uint64_t... values>
+constexpr std::uint64_t hash_array<values...>::data[sizeof...(values) + 1];
+
+/** mix the range of the hashes into the schema hash in order. the range is
+ * split into two halves, so the depth of the recursion is log2(e - b) while
+ * the result is the same as mixing them one by one.
+ * @param[in] values top of the hashes
+ * @param[in] b index of the first hash
+ * @param[in] e index of the next of the last hash
+ * @param[in] h hash so far
+ * @return hash
+ */
+constexpr std::uint64_t mix_range(std::uint64_t const *values, size_t b,
+                                  size_t e, std::uint64_t h) {
+  return e - b == 0   ? h
+         : e - b == 1 ? fnv1a(h, values[b])
+                      : mix_range(values, b + (e - b) / 2, e,
+                                  mix_range(values, b, b + (e - b) / 2, h));
+}
+
+/** template to mix the layouts of the items into the schema hash in order
+ * @tparam tuple_type type of the list of items
+ */
+template <typename tuple_type> struct schema_of_items;
+
+/** template to mix the layouts of the items into the schema hash in order.
+ * each item is hashed on its own, so the hashes of the items are separate
+ * constant expressions and are not nested in each other.
+ * @tparam args item types
+ */
+template <typename... args> struct schema_of_items<std::tuple<args...>> {
+  /** hashes of the layouts of the items */
+  using hashes = hash_array<
+      schema_of<typename item_codec<args>::codec_type>::hash(fnv1a_offset)...>;
+
+  /** mix the layouts
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return mix_range(hashes::data, 0, sizeof...(args), h);
+  }
+};
+
+/** template to mix the layout of struct or class into the schema hash. the
+ * count of the items and the layouts of them are mixed in order.
+ */
+template <typename target_type>
+struct schema_of<target_type, tcat::other> {
+  /** type of the list of items to serialize */
+  using list_type = item_list_type<target_type>;
+
+  /** mix the layout
+   * @param[in] h hash so far
+   * @return hash
+   */
+  static constexpr std::uint64_t hash(std::uint64_t h) {
+    return fnv1a(schema_of_items<list_type>::hash(fnv1a(
+                     fnv1a(h, schema_tag::structure),
+                     std::tuple_size<list_type>::value)),
+                 schema_tag::end_of_structure);
+  }
+};
+
+/** 64bit fingerprint of the serialized layout of the type. types, order,
+ * sizes and categories of the items are mixed recursively, but the names
+ * are not. types of the same layout have the same hash.
+ * @tparam target type of the value
+ * @tparam order byte order of serialized data
+ * @return hash
+ */
+template <typename target, byte_order order = byte_order::little>
+constexpr std::uint64_t schema_hash() {
+  return fnv1a(schema_of<target>::hash(fnv1a_offset),
+               static_cast<std::uint64_t>(order));
+}
+
+/** exception thrown if the schema hash in the serialized data is different
+ * from the expected one */
+class schema_mismatch : public std::runtime_error {
+public:
+  /** create exception */
+  schema_mismatch() : std::runtime_error("loleseri: schema mismatch") {}
+};
+
+/** template to serialize and deserialize with the schema hash header.
+ * 8 bytes of schema_hash<target, order>() precede the value.
+ * @tparam target target type
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order> struct schema_checked {
+  /** type to serialize the header */
+  using header_serializer = serializer<std::uint64_t, order>;
+
+  /** type to deserialize the header */
+  using header_deserializer = deserializer<std::uint64_t, order>;
+
+  /** type to serialize the value */
+  using seri = serializer<target, order>;
+
+  /** type to deserialize the value */
+  using deseri = deserializer<target, order>;
+
+  /** byte count of serialized obj with the header
+   * @param[in] obj pointer to the object to serialize
+   * @return byte count
+   */
+  static size_t serialized_size(target const *obj) {
+    return header_serializer::size + seri::serialized_size(obj);
+  }
+
+  /** serialize the header and obj
+   * @tparam itor output iterator type
+   * @return top of iterator pointing to the top of unused area
+   */
+  template <typename itor>
+  static itor serialize(itor begin, itor end, target const *obj) {
+    std::uint64_t const hash = schema_hash<target, order>();
+    auto p = header_serializer::serialize(begin, end, &hash);
+    return seri::serialize(p, end, obj);
+  }
+
+  /** check the header and deserialize obj
+   * @tparam itor input iterator type
+   * @return top of iterator pointing to the top of unused area
+   * @throw buffer_overrun if the range is too short for the header
+   * @throw schema_mismatch if the header is different
+   */
+  template <typename itor>
+  static itor deserialize(itor begin, itor end, target *obj) {
+    require_size(begin, end, header_deserializer::size);
+    std::uint64_t hash;
+    auto p = header_deserializer::deserialize(begin, end, &hash);
+    if (hash != schema_hash<target, order>()) {
+      throw schema_mismatch();
+    }
+    return deseri::deserialize(p, end, obj);
+  }
+};
+
+/** serialize with the schema hash header
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <typename target, typename itor>
+itor serialize_with_schema(itor begin, itor end, target const *obj) {
+  return schema_checked<target, byte_order::little>::serialize(begin, end,
+                                                               obj);
+}
+
+/** serialize with the schema hash header with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor output iterator type
+ * @return top of iterator pointing to the top of unused area
+ */
+template <byte_order order, typename target, typename itor>
+itor serialize_with_schema(itor begin, itor end, target const *obj) {
+  return schema_checked<target, order>::serialize(begin, end, obj);
+}
+
+/** deserialize with checking the schema hash header
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw schema_mismatch if the header is different
+ */
+template <typename target, typename itor>
+itor deserialize_with_schema(itor begin, itor end, target *obj) {
+  return schema_checked<target, byte_order::little>::deserialize(begin, end,
+                                                                 obj);
+}
+
+/** deserialize with checking the schema hash header with specified byte
+ * order
+ * @tparam order byte order of serialized data
+ * @tparam target target type
+ * @tparam itor input iterator type
+ * @return top of iterator pointing to the top of unused area
+ * @throw schema_mismatch if the header is different
+ */
+template <byte_order order, typename target, typename itor>
+itor deserialize_with_schema(itor begin, itor end, target *obj) {
+  return schema_checked<target, order>::deserialize(begin, end, obj);
+}
+
+} // namespace loleseri
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <loleseri/loleseri.hpp>
+#include <ostream>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace loleseri {
+
+/** sink to write bytes to the file descriptor */
+class fd_sink {
+public:
+  /** create sink
+   * @param[in] fd file descriptor to write. not closed by the sink.
+   */
+  explicit fd_sink(int fd) : fd_(fd) {}
+
+  /** write all bytes
+   * @param[in] data top of the bytes
+   * @param[in] size byte count
+   * @throw std::system_error if failed
+   */
+  void write(std::uint8_t const *data, size_t size) {
+    write(data, size, nullptr, 0);
+  }
+
+  /** write all bytes of two areas with writev
+   * @param[in] head top of the first area
+   * @param[in] head_size byte count of the first area
+   * @param[in] body top of the second area
+   * @param[in] body_size byte count of the second area
+   * @throw std::system_error if failed
+   */
+  void write(std::uint8_t const *head, size_t head_size,
+             std::uint8_t const *body, size_t body_size) {
+    iovec iov[2] = {{const_cast<std::uint8_t *>(head), head_size},
+                    {const_cast<std::uint8_t *>(body), body_size}};
+    iovec *v = iov;
+    int n = 2;
+    while (0 < n) {
+      ssize_t const r = ::writev(fd_, v, n);
+      if (r < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "writev");
+      }
+      auto done = static_cast<size_t>(r);
+      while (0 < n && v->iov_len <= done) {
+        done -= v->iov_len;
+        ++v;
+        --n;
+      }
+      if (0 < n) {
+        v->iov_base = static_cast<std::uint8_t *>(v->iov_base) + done;
+        v->iov_len -= done;
+      }
+    }
+  }
+
+private:
+  /** file descriptor */
+  int fd_;
+};
+
+/** sink to write bytes to std::ostream */
+class ostream_sink {
+public:
+  /** create sink
+   * @param[in] os stream to write
+   */
+  explicit ostream_sink(std::ostream &os) : os_(&os) {}
+
+  /** write all bytes
+   * @param[in] data top of the bytes
+   * @param[in] size byte count
+   * @throw std::ios_base::failure if failed
+   */
+  void write(std::uint8_t const *data, size_t size) {
+    if (!os_->write(reinterpret_cast<char const *>(data),
+                    static_cast<std::streamsize>(size))) {
+      throw std::ios_base::failure("loleseri: failed to write");
+    }
+  }
+
+  /** write all bytes of two areas
+   * @param[in] head top of the first area
+   * @param[in] head_size byte count of the first area
+   * @param[in] body top of the second area
+   * @param[in] body_size byte count of the second area
+   * @throw std::ios_base::failure if failed
+   */
+  void write(std::uint8_t const *head, size_t head_size,
+             std::uint8_t const *body, size_t body_size) {
+    write(head, head_size);
+    write(body, body_size);
+  }
+
+private:
+  /** stream to write */
+  std::ostream *os_;
+};
+
+/** source to read bytes from the file descriptor */
+class fd_source {
+public:
+  /** create source
+   * @param[in] fd file descriptor to read. not closed by the source.
+   */
+  explicit fd_source(int fd) : fd_(fd) {}
+
+  /** read bytes
+   * @param[out] data top of the area to write
+   * @param[in] size maximum byte count to read
+   * @return byte count read. 0 means end of file.
+   * @throw std::system_error if failed
+   */
+  size_t read(std::uint8_t *data, size_t size) {
+    for (;;) {
+      ssize_t const r = ::read(fd_, data, size);
+      if (0 <= r) {
+        return static_cast<size_t>(r);
+      }
+      if (errno != EINTR) {
+        throw std::system_error(errno, std::generic_category(), "read");
+      }
+    }
+  }
+
+private:
+  /** file descriptor */
+  int fd_;
+};
+
+/** source to read bytes from std::istream */
+class istream_source {
+public:
+  /** create source
+   * @param[in] is stream to read
+   */
+  explicit istream_source(std::istream &is) : is_(&is) {}
+
+  /** read bytes
+   * @param[out] data top of the area to write
+   * @param[in] size maximum byte count to read
+   * @return byte count read. 0 means end of file.
+   * @throw std::ios_base::failure if failed
+   */
+  size_t read(std::uint8_t *data, size_t size) {
+    is_->read(reinterpret_cast<char *>(data),
+              static_cast<std::streamsize>(size));
+    if (is_->bad()) {
+      throw std::ios_base::failure("loleseri: failed to read");
+    }
+    return static_cast<size_t>(is_->gcount());
+  }
+
+private:
+  /** stream to read */
+  std::istream *is_;
+};
+
+/** template to check that bytes of the objects in memory are equal to the
+ * serialized bytes
+ * @tparam target type of the object
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename target, byte_order order,
+          int typecat = type_category<target>::value>
+struct raw_bytes {
+  /** check the layout
+   * @param[in] obj pointer to the object
+   * @return true if the bytes of obj can be written as is
+   */
+  static bool available(target const *obj) {
+    return has_native_layout<target, order>::value &&
+           sizeof(target) == serializer<target, order>::size;
+  }
+};
+
+/** template to check that bytes of the struct or class in memory are equal
+ * to the serialized bytes
+ * @tparam target type of the object
+ * @tparam order byte order of serialized data
+ */
+template <typename target, byte_order order>
+struct raw_bytes<target, order, tcat::other> {
+  /** check the layout
+   * @param[in] obj pointer to the object
+   * @return true if the bytes of obj can be written as is
+   */
+  static bool available(target const *obj) {
+    return native_layout<target, order>::candidate &&
+           native_layout<target, order>::matches(obj);
+  }
+};
+
+/** writer to serialize records to the sink through the buffer.
+ * the buffer holds whole records only, and is written in large chunks.
+ * @tparam target type of the record
+ * @tparam sink_t type of the sink. fd_sink, ostream_sink or any type which
+ * has write(data, size) and write(head, head_size, body, body_size).
+ * @tparam order byte order of serialized data
+ */
+template <typename target, typename sink_t,
+          byte_order order = byte_order::little>
+class stream_writer {
+  static_assert(is_fixed_size<target>::value,
+                "stream_writer supports fixed size types only");
+
+public:
+  /** type to serialize the record */
+  using seri = serializer<target, order>;
+
+  enum {
+    /** byte count of the record */
+    record_size = seri::size
+  };
+
+  /** create writer
+   * @param[in] sink sink to write
+   * @param[in] buffer_records count of the records in the buffer
+   */
+  explicit stream_writer(sink_t sink, size_t buffer_records = 0)
+      : sink_(sink),
+        buffer_(record_size * (buffer_records != 0
+                                   ? buffer_records
+                                   : std::max<size_t>(
+                                         1, 64 * 1024 / record_size))),
+        used_(0) {}
+
+  stream_writer(stream_writer const &) = delete;
+  stream_writer &operator=(stream_writer const &) = delete;
+
+  /** flush the buffer. errors are ignored. call flush() to catch them. */
+  ~stream_writer() {
+    try {
+      flush();
+    } catch (...) {
+    }
+  }
+
+  /** write a record
+   * @param[in] obj record to write
+   */
+  void write(target const &obj) {
+    if (buffer_.size() < used_ + record_size) {
+      flush();
+    }
+    auto p = buffer_.data() + used_;
+    seri::serialize(p, p + record_size, &obj);
+    used_ += record_size;
+  }
+
+  /** write records. if the records do not fit in the buffer and their bytes
+   * in memory are equal to the serialized bytes, they are written without
+   * copy together with the buffer.
+   * @param[in] first pointer to the first record
+   * @param[in] count count of the records
+   */
+  void write(target const *first, size_t count) {
+    size_t const bytes = record_size * count;
+    if (buffer_.size() < used_ + bytes && 0 < count &&
+        raw_bytes<target, order>::available(first)) {
+      sink_.write(buffer_.data(), used_,
+                  reinterpret_cast<std::uint8_t const *>(first), bytes);
+      used_ = 0;
+      return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      write(first[i]);
+    }
+  }
+
+  /** write the buffered records to the sink */
+  void flush() {
+    if (used_ != 0) {
+      sink_.write(buffer_.data(), used_);
+      used_ = 0;
+    }
+  }
+
+private:
+  /** sink to write */
+  sink_t sink_;
+
+  /** buffer of serialized records */
+  std::vector<std::uint8_t> buffer_;
+
+  /** byte count of the used area of the buffer */
+  size_t used_;
+};
+
+/** reader to deserialize records from the source through the buffer.
+ * the buffer is refilled in large chunks and the records are deserialized
+ * from the buffer in place.
+ * @tparam target type of the record
+ * @tparam source_t type of the source. fd_source, istream_source or any type
+ * which has read(data, size).
+ * @tparam order byte order of serialized data
+ */
+template <typename target, typename source_t,
+          byte_order order = byte_order::little>
+class stream_reader {
+  static_assert(is_fixed_size<target>::value,
+                "stream_reader supports fixed size types only");
+
+public:
+  /** type to deserialize the record */
+  using deseri = deserializer<target, order>;
+
+  enum {
+    /** byte count of the record */
+    record_size = deseri::size
+  };
+
+  /** create reader
+   * @param[in] source source to read
+   * @param[in] buffer_records count of the records in the buffer
+   */
+  explicit stream_reader(source_t source, size_t buffer_records = 0)
+      : source_(source),
+        buffer_(record_size * (buffer_records != 0
+                                   ? buffer_records
+                                   : std::max<size_t>(
+                                         1, 64 * 1024 / record_size))),
+        pos_(0), filled_(0) {}
+
+  /** read a record
+   * @param[out] obj address to write the record
+   * @return false if there are no more records
+   * @throw buffer_overrun if the stream ends in the middle of a record
+   */
+  bool read(target *obj) {
+    if (filled_ - pos_ < record_size && !refill()) {
+      return false;
+    }
+    auto p = buffer_.data() + pos_;
+    deseri::deserialize(p, p + record_size, obj);
+    pos_ += record_size;
+    return true;
+  }
+
+  /** read records
+   * @param[out] first address to write the first record
+   * @param[in] count maximum count of the records
+   * @return count of the records read
+   * @throw buffer_overrun if the stream ends in the middle of a record
+   */
+  size_t read(target *first, size_t count) {
+    size_t done = 0;
+    while (done < count) {
+      if (filled_ - pos_ < record_size && !refill()) {
+        break;
+      }
+      size_t const n =
+          std::min(count - done, (filled_ - pos_) / record_size);
+      auto p = buffer_.data() + pos_;
+      auto const end = p + n * record_size;
+      for (size_t i = 0; i < n; ++i) {
+        p = deseri::deserialize(p, end, first + done + i);
+      }
+      pos_ += n * record_size;
+      done += n;
+    }
+    return done;
+  }
+
+private:
+  /** move the rest to the top of the buffer and read until the buffer holds
+   * a record at least
+   * @return false if there are no more records
+   */
+  bool refill() {
+    size_t const rest = filled_ - pos_;
+    std::memmove(buffer_.data(), buffer_.data() + pos_, rest);
+    pos_ = 0;
+    filled_ = rest;
+    do {
+      size_t const r =
+          source_.read(buffer_.data() + filled_, buffer_.size() - filled_);
+      if (r == 0) {
+        break;
+      }
+      filled_ += r;
+    } while (filled_ < record_size);
+    if (filled_ == 0) {
+      return false;
+    }
+    if (filled_ < record_size) {
+      throw buffer_overrun();
+    }
+    return true;
+  }
+
+  /** source to read */
+  source_t source_;
+
+  /** buffer of serialized records */
+  std::vector<std::uint8_t> buffer_;
+
+  /** byte offset of the next record in the buffer */
+  size_t pos_;
+
+  /** byte count of the filled area of the buffer */
+  size_t filled_;
+};
+
+} // namespace loleseri
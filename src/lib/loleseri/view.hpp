@@ -0,0 +1,309 @@
+#pragma once
+
+#include <loleseri/loleseri.hpp>
+
+namespace loleseri {
+
+/** template to access serialized value without deserializing whole of it
+ * @tparam target_type type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename target_type, typename itor_t, byte_order order, int typecat>
+class view_impl;
+
+/** type to access serialized value without deserializing whole of it
+ * @tparam target_type type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type, typename itor_t = std::uint8_t const *,
+          byte_order order = byte_order::little>
+using view = view_impl<typename std::remove_cv<target_type>::type, itor_t,
+                       order, type_category<target_type>::value>;
+
+/** base of the views. holds the range of the serialized value.
+ * @tparam target_type_ type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, typename itor_t, byte_order order>
+class view_base {
+public:
+  /** type of the serialized value */
+  using target_type = target_type_;
+
+  /** type to deserialize target type */
+  using deserializer = loleseri::deserializer<target_type, order>;
+
+  /** byte count of serialized size */
+  enum { size = serializer<target_type>::size };
+
+  /** create view
+   * @param[in] begin top of the serialized value
+   * @param[in] end end of the input iterator
+   */
+  view_base(itor_t begin, itor_t end) : begin_(begin), end_(end) {}
+
+  /** top of the serialized value
+   * @return iterator pointing to the top of the serialized value
+   */
+  itor_t begin() const { return begin_; }
+
+  /** end of the serialized value
+   * @return iterator pointing to the next of the serialized value
+   */
+  itor_t end() const { return begin_ + size; }
+
+  /** deserialize whole value
+   * @param[out] obj address to write the result of deserialize
+   * @return iterator pointing to the next of the serialized value
+   */
+  itor_t deserialize(target_type *obj) const {
+    return deserializer::deserialize(begin_, end_, obj);
+  }
+
+protected:
+  /** create view of the value at offset
+   * @tparam sub_type type of the value
+   * @param[in] offset byte offset of the value
+   * @return view of the value
+   */
+  template <typename sub_type>
+  view<sub_type, itor_t, order> sub_view(size_t offset) const {
+    return view<sub_type, itor_t, order>(begin_ + offset, end_);
+  }
+
+  /** top of the serialized value */
+  itor_t begin_;
+
+  /** end of the input iterator */
+  itor_t end_;
+};
+
+/** view of bool, integer or floating point value
+ * @tparam target_type_ type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ * @tparam typecat integer to specity category of target type
+ */
+template <typename target_type_, typename itor_t, byte_order order,
+          int typecat>
+class view_impl : public view_base<target_type_, itor_t, order> {
+  /** base class */
+  using base = view_base<target_type_, itor_t, order>;
+
+public:
+  using base::base;
+
+  /** deserialize the value
+   * @return deserialized value
+   */
+  target_type_ get() const {
+    return base::deserializer::deserialize(base::begin_, base::end_);
+  }
+};
+
+/** view of struct or class
+ * @tparam target_type_ type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, typename itor_t, byte_order order>
+class view_impl<target_type_, itor_t, order, tcat::other>
+    : public view_base<target_type_, itor_t, order> {
+  /** base class */
+  using base = view_base<target_type_, itor_t, order>;
+
+public:
+  using base::base;
+
+  /** type to get list of items to serialize */
+  using items = loleseri::items<target_type_>;
+
+  /** type of the list of items to serialize */
+  using list_type = typename std::remove_cv<decltype(items::list())>::type;
+
+  /** type of the ix-th item
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using item_type = typename item_codec<
+      typename std::tuple_element<ix, list_type>::type>::value_type;
+
+  /** true if the ix-th item is serialized as its data type
+   * @tparam ix index of the item
+   */
+  template <size_t ix>
+  using plain_item = std::is_same<
+      typename item_codec<
+          typename std::tuple_element<ix, list_type>::type>::codec_type,
+      item_type<ix>>;
+
+  /** type of the view of the ix-th item
+   * @tparam ix index of the item
+   */
+  template <size_t ix> using item_view = view<item_type<ix>, itor_t, order>;
+
+  enum {
+    /** count of the items */
+    item_count = std::tuple_size<list_type>::value
+  };
+
+  /** byte offset of the ix-th item in serialized value
+   * @tparam ix index of the item
+   * @return byte offset
+   */
+  template <size_t ix> static constexpr size_t offset() {
+    return offset_of_item<list_type, ix>::value;
+  }
+
+  /** view of the ix-th item
+   * @tparam ix index of the item
+   * @return view of the item
+   */
+  template <size_t ix> item_view<ix> at() const {
+    static_assert(ix < item_count, "ix is too big");
+    static_assert(plain_item<ix>::value,
+                  "items in their own encoding cannot be viewed");
+    return base::template sub_view<item_type<ix>>(offset<ix>());
+  }
+
+  /** deserialize the ix-th item only
+   * @tparam ix index of the item
+   * @return deserialized item
+   */
+  template <size_t ix> item_type<ix> get() const { return at<ix>().get(); }
+
+  /** deserialize whole value
+   * @return deserialized value
+   */
+  target_type_ get() const {
+    return base::deserializer::deserialize(base::begin_, base::end_);
+  }
+};
+
+/** view of array
+ * @tparam target_type_ type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ * @tparam element_type_ type of the element
+ * @tparam element_count_ count of the elements
+ */
+template <typename target_type_, typename itor_t, byte_order order,
+          typename element_type_, size_t element_count_>
+class array_view_base : public view_base<target_type_, itor_t, order> {
+  /** base class */
+  using base = view_base<target_type_, itor_t, order>;
+
+public:
+  using base::base;
+
+  /** type of the element */
+  using element_type = element_type_;
+
+  /** type of the view of the element */
+  using element_view = view<element_type, itor_t, order>;
+
+  enum {
+    /** count of the elements */
+    element_count = element_count_,
+
+    /** byte count of serialized size of the element */
+    element_size = serializer<element_type>::size
+  };
+
+  /** view of the element
+   * @param[in] ix index of the element
+   * @return view of the element
+   */
+  element_view operator[](size_t ix) const {
+    return base::template sub_view<element_type>(ix * element_size);
+  }
+
+  /** deserialize the element only
+   * @tparam element type of the element
+   * @param[in] ix index of the element
+   * @return deserialized element
+   */
+  template <typename element = element_type> element get(size_t ix) const {
+    return (*this)[ix].get();
+  }
+};
+
+/** view of std::array
+ * @tparam target_type_ type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, typename itor_t, byte_order order>
+class view_impl<target_type_, itor_t, order, tcat::std_array>
+    : public array_view_base<target_type_, itor_t, order,
+                             typename target_type_::value_type,
+                             std::tuple_size<target_type_>::value> {
+  /** base class */
+  using base =
+      array_view_base<target_type_, itor_t, order,
+                      typename target_type_::value_type,
+                      std::tuple_size<target_type_>::value>;
+
+public:
+  using base::base;
+  using base::get;
+
+  /** deserialize whole value
+   * @return deserialized value
+   */
+  target_type_ get() const {
+    return base::deserializer::deserialize(base::begin_, base::end_);
+  }
+};
+
+/** view of traditional array
+ * @tparam target_type_ type of the serialized value
+ * @tparam itor_t type of the input iterator
+ * @tparam order byte order of serialized data
+ */
+template <typename target_type_, typename itor_t, byte_order order>
+class view_impl<target_type_, itor_t, order, tcat::array>
+    : public array_view_base<
+          target_type_, itor_t, order,
+          typename element_type_of_array<target_type_>::type,
+          std::extent<target_type_>::value> {
+  /** base class */
+  using base =
+      array_view_base<target_type_, itor_t, order,
+                      typename element_type_of_array<target_type_>::type,
+                      std::extent<target_type_>::value>;
+
+public:
+  using base::base;
+};
+
+/** create view of serialized value
+ * @tparam target type of the serialized value
+ * @tparam itor type of the input iterator
+ * @param[in] begin top of the serialized value
+ * @param[in] end end of the input iterator
+ * @return view of the value
+ */
+template <typename target, typename itor>
+view<target, itor> make_view(itor begin, itor end) {
+  return view<target, itor>(begin, end);
+}
+
+/** create view of serialized value with specified byte order
+ * @tparam order byte order of serialized data
+ * @tparam target type of the serialized value
+ * @tparam itor type of the input iterator
+ * @param[in] begin top of the serialized value
+ * @param[in] end end of the input iterator
+ * @return view of the value
+ */
+template <byte_order order, typename target, typename itor>
+view<target, itor, order> make_view(itor begin, itor end) {
+  return view<target, itor, order>(begin, end);
+}
+
+} // namespace loleseri
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <loleseri/loleseri.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint8_t hoge;
+  std::uint32_t fuga;
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.hoge == b.hoge && a.fuga == b.fuga;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint8_t Foo::*, std::uint32_t Foo::*>;
+  static inline list_type list() { return {&Foo::hoge, &Foo::fuga}; }
+};
+} // namespace loleseri
+
+TEST(Append, Single) {
+  std::vector<std::uint8_t> out = {0xaa};
+  Foo foo = {1, 0x12345678};
+  ASSERT_EQ(5, loleseri::append(out, foo));
+  std::vector<std::uint8_t> expected = {0xaa, 1, 0x78, 0x56, 0x34, 0x12};
+  ASSERT_EQ(expected, out);
+
+  ASSERT_EQ(5, loleseri::append<loleseri::byte_order::big>(out, foo));
+  ASSERT_EQ(11, out.size());
+  ASSERT_EQ(0x12, out[7]);
+  auto restored = loleseri::deserialize<loleseri::byte_order::big, Foo>(
+      out.cbegin() + 6, out.cend());
+  ASSERT_EQ(foo, restored);
+}
+
+TEST(Append, Batch) {
+  std::vector<Foo> foos;
+  for (std::uint32_t i = 0; i < 30; ++i) {
+    foos.push_back({static_cast<std::uint8_t>(i), i * 0x01010101u});
+  }
+  std::vector<char> out;
+  ASSERT_EQ(150, loleseri::append(out, foos.data(), foos.size()));
+  ASSERT_EQ(150, out.size());
+  for (size_t i = 0; i < foos.size(); ++i) {
+    auto p = out.data() + i * 5;
+    ASSERT_EQ(foos[i], loleseri::deserialize<Foo>(p, p + 5));
+  }
+}
+
+TEST(Append, VariableSize) {
+  std::vector<std::string> names = {"apple", "", "banana"};
+  std::vector<std::uint8_t> out;
+  ASSERT_EQ(4 + 5 + 4 + 4 + 6,
+            loleseri::append(out, names.data(), names.size()));
+  auto p = out.data();
+  for (auto const &name : names) {
+    std::string restored;
+    p = loleseri::deserialize(p, out.data() + out.size(), &restored);
+    ASSERT_EQ(name, restored);
+  }
+  ASSERT_EQ(out.data() + out.size(), p);
+}
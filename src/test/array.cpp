@@ -1,6 +1,8 @@
+#include <deque>
 #include <gtest/gtest.h>
 #include <loleseri/loleseri.hpp>
 #include <tuple>
+#include <vector>
 
 namespace {
 struct Foo {
@@ -119,3 +121,51 @@ TEST(Array, Uint16) {
     ASSERT_EQ(value[i], v1[i]);
   }
 }
+
+TEST(StdArray, FloatBulk) {
+  using array_t = std::array<float, 4096>;
+  static_assert(loleseri::has_native_layout<array_t>::value,
+                "array of float has native layout");
+  static_assert(!loleseri::has_native_layout<std::array<bool, 3>>::value,
+                "array of bool does not have native layout");
+  array_t value;
+  for (size_t i = 0; i < value.size(); ++i) {
+    value[i] = static_cast<float>(i) * 0.5f;
+  }
+  constexpr size_t size = loleseri::serialized_size<array_t>();
+  std::vector<std::uint8_t> fast(size);
+  auto last = loleseri::serialize(fast.begin(), fast.end(), &value);
+  ASSERT_EQ(fast.end(), last);
+  std::deque<std::uint8_t> slow(size);
+  loleseri::serialize(slow.begin(), slow.end(), &value);
+  ASSERT_TRUE(std::equal(fast.begin(), fast.end(), slow.begin()));
+
+  array_t v0;
+  auto p = loleseri::deserialize(fast.cbegin(), fast.cend(), &v0);
+  ASSERT_EQ(fast.cend(), p);
+  ASSERT_EQ(value, v0);
+  auto v1 = loleseri::deserialize<array_t>(slow.begin(), slow.end());
+  ASSERT_EQ(value, v1);
+}
+
+TEST(Array, Int16Bulk) {
+  using array_t = std::int16_t[2][3];
+  static_assert(loleseri::has_native_layout<array_t>::value,
+                "array of int16_t has native layout");
+  array_t value = {{1, -2, 3}, {-4, 5, -0x1234}};
+  std::array<std::uint8_t, loleseri::serialized_size<array_t>()> buffer;
+  auto last = loleseri::serialize(buffer.data(),
+                                  buffer.data() + buffer.size(), &value);
+  ASSERT_EQ(buffer.data() + buffer.size(), last);
+  ASSERT_EQ(0xcc, buffer[10]);
+  ASSERT_EQ(0xed, buffer[11]);
+
+  array_t restored;
+  loleseri::deserialize(buffer.data(), buffer.data() + buffer.size(),
+                        &restored);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ASSERT_EQ(value[i][j], restored[i][j]);
+    }
+  }
+}
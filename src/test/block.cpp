@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <loleseri/block.hpp>
+#include <loleseri/lz4_block.hpp>
+#include <loleseri/stream.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Quote {
+  std::uint32_t id;
+  std::int64_t price;
+  std::uint16_t qty[3];
+  std::uint8_t pad[9];
+};
+
+bool operator==(Quote const &a, Quote const &b) {
+  return a.id == b.id && a.price == b.price && a.qty[0] == b.qty[0] &&
+         a.qty[1] == b.qty[1] && a.qty[2] == b.qty[2];
+}
+
+Quote make_quote(size_t i) {
+  Quote r{};
+  r.id = static_cast<std::uint32_t>(i);
+  r.price = 10000 + static_cast<std::int64_t>(i % 7);
+  r.qty[0] = static_cast<std::uint16_t>(i % 3);
+  return r;
+}
+
+/** メモリに書くシンク */
+struct vector_sink {
+  std::vector<std::uint8_t> *bytes;
+  void write(std::uint8_t const *head, size_t head_size,
+             std::uint8_t const *body, size_t body_size) {
+    bytes->insert(bytes->end(), head, head + head_size);
+    bytes->insert(bytes->end(), body, body + body_size);
+  }
+};
+
+/** 少しずつ読めるソース */
+struct vector_source {
+  std::vector<std::uint8_t> const *bytes;
+  size_t pos;
+  size_t chunk;
+  size_t read(std::uint8_t *data, size_t size) {
+    size_t const n = std::min(std::min(size, chunk), bytes->size() - pos);
+    std::copy(bytes->begin() + static_cast<std::ptrdiff_t>(pos),
+              bytes->begin() + static_cast<std::ptrdiff_t>(pos + n), data);
+    pos += n;
+    return n;
+  }
+};
+
+std::vector<std::uint8_t> round_trip(std::vector<std::uint8_t> const &src) {
+  loleseri::lz4_block_codec codec;
+  std::vector<std::uint8_t> c(
+      loleseri::lz4_block_codec::max_compressed_size(src.size()));
+  c.resize(codec.compress(src.data(), src.size(), c.data()));
+  std::vector<std::uint8_t> r(src.size());
+  EXPECT_TRUE(loleseri::lz4_block_codec::decompress(c.data(), c.size(),
+                                                    r.data(), r.size()));
+  return r;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Quote> {
+  using list_type =
+      std::tuple<std::uint32_t Quote::*, std::int64_t Quote::*,
+                 std::uint16_t(Quote::*)[3], std::uint8_t(Quote::*)[9]>;
+  static inline list_type list() {
+    return {&Quote::id, &Quote::price, &Quote::qty, &Quote::pad};
+  }
+};
+} // namespace loleseri
+
+TEST(Block, Lz4Format) {
+  // リテラル 3 + オフセット 3 で 9 バイトのマッチ + 最後のリテラル 5
+  std::vector<std::uint8_t> const block = {0x35, 'a', 'b', 'c', 0x03, 0x00,
+                                           0x50, 'x', 'x', 'x', 'x', 'x'};
+  std::vector<std::uint8_t> r(17);
+  ASSERT_TRUE(loleseri::lz4_block_codec::decompress(block.data(), block.size(),
+                                                    r.data(), r.size()));
+  ASSERT_EQ("abcabcabcabcxxxxx", std::string(r.begin(), r.end()));
+
+  // 壊れたデータ
+  std::vector<std::uint8_t> small(16);
+  ASSERT_FALSE(loleseri::lz4_block_codec::decompress(
+      block.data(), block.size(), small.data(), small.size()));
+  ASSERT_FALSE(loleseri::lz4_block_codec::decompress(
+      block.data(), block.size() - 1, r.data(), r.size()));
+  auto far = block;
+  far[4] = 0x04;
+  ASSERT_FALSE(loleseri::lz4_block_codec::decompress(far.data(), far.size(),
+                                                     r.data(), r.size()));
+}
+
+TEST(Block, Lz4RoundTrip) {
+  std::vector<std::vector<std::uint8_t>> inputs;
+  inputs.emplace_back();
+  inputs.emplace_back(12, 7);
+  inputs.emplace_back(13, 0);
+  inputs.emplace_back(100000, 0);
+  std::vector<std::uint8_t> noise(5000);
+  std::uint32_t x = 1;
+  for (auto &b : noise) {
+    x = x * 1103515245u + 12345u;
+    b = static_cast<std::uint8_t>(x >> 24);
+  }
+  inputs.push_back(noise);
+  std::vector<std::uint8_t> text;
+  for (int i = 0; i < 3000; ++i) {
+    text.push_back(static_cast<std::uint8_t>("lorem ipsum "[i % 12]));
+    text.push_back(static_cast<std::uint8_t>(i % 251));
+  }
+  inputs.push_back(text);
+  for (auto const &src : inputs) {
+    ASSERT_EQ(src, round_trip(src)) << src.size();
+  }
+
+  loleseri::lz4_block_codec codec;
+  std::vector<std::uint8_t> c(
+      loleseri::lz4_block_codec::max_compressed_size(100000));
+  // 0 が続くデータはよく縮む
+  ASSERT_GT(1000, codec.compress(inputs[3].data(), 100000, c.data()));
+}
+
+TEST(Block, WriteAndRead) {
+  using format = loleseri::block_format<Quote, loleseri::byte_order::little>;
+  std::vector<std::uint8_t> bytes;
+  {
+    loleseri::block_writer<Quote, vector_sink> writer(vector_sink{&bytes},
+                                                      100);
+    for (size_t i = 0; i < 250; ++i) {
+      writer.write(make_quote(i));
+    }
+  }
+  // 250 件は 100 + 100 + 50 件のブロックになる
+  ASSERT_GT(250 * format::record_size / 2, bytes.size());
+  auto const first = format::read_header(bytes.data());
+  ASSERT_EQ(100, first.count);
+  ASSERT_EQ(27, first.record_size);
+
+  loleseri::block_reader<Quote, vector_source> reader(
+      vector_source{&bytes, 0, 7});
+  Quote q;
+  for (size_t i = 0; i < 30; ++i) {
+    ASSERT_TRUE(reader.read(&q));
+    ASSERT_EQ(make_quote(i), q);
+  }
+  std::vector<Quote> rest(300);
+  ASSERT_EQ(220, reader.read(rest.data(), rest.size()));
+  ASSERT_EQ(make_quote(30), rest[0]);
+  ASSERT_EQ(make_quote(249), rest[219]);
+  ASSERT_FALSE(reader.read(&q));
+}
+
+TEST(Block, Skip) {
+  std::vector<std::uint8_t> bytes;
+  {
+    loleseri::block_writer<Quote, vector_sink> writer(vector_sink{&bytes},
+                                                      64);
+    std::vector<Quote> quotes;
+    for (size_t i = 0; i < 200; ++i) {
+      quotes.push_back(make_quote(i));
+    }
+    writer.write(quotes.data(), quotes.size());
+  }
+  loleseri::block_reader<Quote, vector_source> reader(
+      vector_source{&bytes, 0, 1000});
+  ASSERT_EQ(64, reader.skip_block());
+  Quote q;
+  ASSERT_TRUE(reader.read(&q));
+  ASSERT_EQ(make_quote(64), q);
+  // 読みかけのブロックの残り
+  ASSERT_EQ(63, reader.skip_block());
+  ASSERT_EQ(64, reader.skip_block());
+  ASSERT_TRUE(reader.read(&q));
+  ASSERT_EQ(make_quote(192), q);
+  ASSERT_EQ(7, reader.skip_block());
+  ASSERT_EQ(0, reader.skip_block());
+  ASSERT_FALSE(reader.read(&q));
+}
+
+TEST(Block, Stored) {
+  // 縮まないレコードはそのまま書く
+  std::vector<std::uint8_t> bytes;
+  std::uint32_t x = 7;
+  std::vector<Quote> quotes(10);
+  for (auto &q : quotes) {
+    x = x * 1103515245u + 12345u;
+    q.id = x;
+    x = x * 1103515245u + 12345u;
+    q.price = static_cast<std::int64_t>(x) << 20;
+    x = x * 1103515245u + 12345u;
+    q.qty[0] = static_cast<std::uint16_t>(x >> 16);
+    for (auto &p : q.pad) {
+      x = x * 1103515245u + 12345u;
+      p = static_cast<std::uint8_t>(x >> 24);
+    }
+  }
+  std::stringstream ss;
+  {
+    loleseri::block_writer<Quote, loleseri::ostream_sink> writer(
+        loleseri::ostream_sink{ss});
+    writer.write(quotes.data(), 1);
+    writer.flush();
+    writer.write(quotes.data() + 1, 9);
+  }
+  auto const s = ss.str();
+  std::vector<std::uint8_t> raw(s.begin(), s.end());
+  using format = loleseri::block_format<Quote, loleseri::byte_order::little>;
+  auto const header = format::read_header(raw.data());
+  ASSERT_EQ(1, header.count);
+  ASSERT_EQ(27, header.body_size);
+
+  loleseri::block_reader<Quote, loleseri::istream_source> reader(
+      loleseri::istream_source{ss});
+  std::vector<Quote> r(10);
+  ASSERT_EQ(10, reader.read(r.data(), r.size()));
+  ASSERT_EQ(quotes[9], r[9]);
+}
+
+TEST(Block, Invalid) {
+  std::vector<std::uint8_t> bytes;
+  {
+    loleseri::block_writer<Quote, vector_sink> writer(vector_sink{&bytes});
+    for (size_t i = 0; i < 100; ++i) {
+      writer.write(make_quote(i));
+    }
+  }
+  Quote q;
+  auto truncated = bytes;
+  truncated.pop_back();
+  loleseri::block_reader<Quote, vector_source> r1(
+      vector_source{&truncated, 0, 1000});
+  ASSERT_THROW(r1.read(&q), loleseri::buffer_overrun);
+
+  auto broken = bytes;
+  broken[0] = 'X';
+  loleseri::block_reader<Quote, vector_source> r2(
+      vector_source{&broken, 0, 1000});
+  ASSERT_THROW(r2.read(&q), loleseri::invalid_block);
+
+  // レコードの型が違う
+  loleseri::block_reader<std::uint64_t, vector_source> r3(
+      vector_source{&bytes, 0, 1000});
+  std::uint64_t v;
+  ASSERT_THROW(r3.read(&v), loleseri::invalid_block);
+
+  // 圧縮されたデータが壊れている
+  auto body = bytes;
+  body[16] = 0xff;
+  body[17] = 0xff;
+  loleseri::block_reader<Quote, vector_source> r4(
+      vector_source{&body, 0, 1000});
+  ASSERT_THROW(r4.read(&q), loleseri::invalid_block);
+}
+
+TEST(Block, TooManyRecords) {
+  // ヘッダの 32 ビットに収まらないブロックは作らない
+  using writer = loleseri::block_writer<Quote, vector_sink>;
+  std::vector<std::uint8_t> bytes;
+  size_t const limit = std::numeric_limits<std::uint32_t>::max() / 27;
+  ASSERT_THROW(writer(vector_sink{&bytes}, limit + 1), std::length_error);
+  using format = loleseri::block_format<Quote, loleseri::byte_order::little>;
+  ASSERT_EQ(limit * 27, format::block_size(limit));
+}
+
+TEST(Block, BrokenHeader) {
+  using format = loleseri::block_format<Quote, loleseri::byte_order::little>;
+  Quote q;
+  // 圧縮しても届かない数のレコードがある
+  auto const head = format::make_header(0xffffffffu, 10);
+  std::vector<std::uint8_t> many(head.begin(), head.end());
+  many.resize(many.size() + 10);
+  loleseri::block_reader<Quote, vector_source> r1(
+      vector_source{&many, 0, 1000});
+  ASSERT_THROW(r1.read(&q), loleseri::invalid_block);
+  loleseri::block_reader<Quote, vector_source> r2(
+      vector_source{&many, 0, 1000});
+  ASSERT_THROW(r2.skip_block(), loleseri::invalid_block);
+
+  // 本体の長さが壊れていても、届いた分しか領域を確保しない
+  auto const huge = format::make_header(0x10000000u, 0xf0000000u);
+  std::vector<std::uint8_t> short_body(huge.begin(), huge.end());
+  short_body.resize(short_body.size() + 100);
+  loleseri::block_reader<Quote, vector_source> r3(
+      vector_source{&short_body, 0, 1000});
+  ASSERT_THROW(r3.read(&q), loleseri::buffer_overrun);
+  loleseri::block_reader<Quote, vector_source> r4(
+      vector_source{&short_body, 0, 1000});
+  ASSERT_THROW(r4.skip_block(), loleseri::buffer_overrun);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <loleseri/loleseri.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint16_t hoge;
+  std::array<float, 3> fuga;
+};
+
+struct Bar {
+  std::uint32_t id;
+  std::string name;
+  std::vector<Foo> foos;
+};
+
+} // namespace
+
+namespace loleseri {
+
+template <> struct items<Foo> {
+  using list_type =
+      std::tuple<std::uint16_t Foo::*, std::array<float, 3> Foo::*>;
+  static inline list_type list() { return {&Foo::hoge, &Foo::fuga}; }
+};
+
+template <> struct items<Bar> {
+  using list_type = std::tuple<std::uint32_t Bar::*, std::string Bar::*,
+                               std::vector<Foo> Bar::*>;
+  static inline list_type list() { return {&Bar::id, &Bar::name, &Bar::foos}; }
+};
+} // namespace loleseri
+
+TEST(Bounded, FixedSize) {
+  Foo value = {0x1234, {{1.0f, 2.0f, 3.0f}}};
+  std::array<std::uint8_t, 14> buffer;
+  auto last = loleseri::serialize_bounded(buffer.begin(), buffer.end(), &value);
+  ASSERT_EQ(buffer.end(), last);
+  ASSERT_THROW(loleseri::serialize_bounded(buffer.begin(), buffer.end() - 1,
+                                           &value),
+               loleseri::buffer_overrun);
+
+  Foo restored;
+  ASSERT_EQ(buffer.cend(), loleseri::deserialize_bounded(
+                               buffer.cbegin(), buffer.cend(), &restored));
+  ASSERT_EQ(value.fuga, restored.fuga);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    ASSERT_THROW(loleseri::deserialize_bounded<Foo>(buffer.cbegin(),
+                                                    buffer.cbegin() + i),
+                 loleseri::buffer_overrun);
+  }
+  ASSERT_THROW(
+      (loleseri::deserialize_bounded<loleseri::byte_order::big, Foo>(
+          buffer.data(), buffer.data() + 3)),
+      std::out_of_range);
+}
+
+TEST(Bounded, BackInserter) {
+  Foo value = {0x1234, {{1.0f, 2.0f, 3.0f}}};
+  std::vector<std::uint8_t> buffer;
+  auto out = std::back_inserter(buffer);
+  loleseri::serialize_bounded(out, out, &value);
+  ASSERT_EQ(14, buffer.size());
+}
+
+TEST(Bounded, ForwardIterator) {
+  // ランダムアクセスできない範囲も、たどって長さを確認する
+  Foo value = {0x1234, {{1.0f, 2.0f, 3.0f}}};
+  std::list<std::uint8_t> buffer(14);
+  loleseri::serialize_bounded(buffer.begin(), buffer.end(), &value);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    std::list<std::uint8_t> shorter(buffer.begin(),
+                                    std::next(buffer.begin(), i));
+    ASSERT_THROW(
+        loleseri::serialize_bounded(shorter.begin(), shorter.end(), &value),
+        loleseri::buffer_overrun);
+    ASSERT_THROW(
+        loleseri::deserialize_bounded<Foo>(shorter.cbegin(), shorter.cend()),
+        loleseri::buffer_overrun);
+  }
+  auto restored =
+      loleseri::deserialize_bounded<Foo>(buffer.cbegin(), buffer.cend());
+  ASSERT_EQ(value.fuga, restored.fuga);
+
+  Bar bar = {1, "bar", {{1, {{1.0f, 2.0f, 3.0f}}}}};
+  std::list<std::uint8_t> bytes(loleseri::serialized_size(bar));
+  loleseri::serialize_bounded(bytes.begin(), bytes.end(), &bar);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    std::list<std::uint8_t> shorter(bytes.begin(), std::next(bytes.begin(), i));
+    ASSERT_THROW(
+        loleseri::deserialize_bounded<Bar>(shorter.cbegin(), shorter.cend()),
+        loleseri::buffer_overrun);
+  }
+  ASSERT_EQ("bar",
+            loleseri::deserialize_bounded<Bar>(bytes.cbegin(), bytes.cend())
+                .name);
+}
+
+TEST(Bounded, VariableSize) {
+  Bar value = {
+      1, "bar", {{1, {{1.0f, 2.0f, 3.0f}}}, {2, {{4.0f, 5.0f, 6.0f}}}}};
+  std::vector<std::uint8_t> buffer(loleseri::serialized_size(value));
+  ASSERT_THROW(loleseri::serialize_bounded(buffer.begin(), buffer.end() - 1,
+                                           &value),
+               loleseri::buffer_overrun);
+  loleseri::serialize_bounded(buffer.begin(), buffer.end(), &value);
+
+  auto restored =
+      loleseri::deserialize_bounded<Bar>(buffer.cbegin(), buffer.cend());
+  ASSERT_EQ(value.name, restored.name);
+  ASSERT_EQ(2, restored.foos.size());
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    ASSERT_THROW(loleseri::deserialize_bounded<Bar>(buffer.cbegin(),
+                                                    buffer.cbegin() + i),
+                 loleseri::buffer_overrun);
+    // 可変長の値は、通常の deserialize でも長さを確認する
+    ASSERT_THROW(
+        loleseri::deserialize<Bar>(buffer.cbegin(), buffer.cbegin() + i),
+        loleseri::buffer_overrun);
+  }
+}
+
+TEST(Bounded, BrokenLength) {
+  // 長さが壊れている場合、メモリを確保する前に例外を投げる
+  std::array<std::uint8_t, 8> buffer = {{0xff, 0xff, 0xff, 0xff, 1, 2, 3, 4}};
+  ASSERT_THROW(loleseri::deserialize<std::vector<std::uint64_t>>(
+                   buffer.cbegin(), buffer.cend()),
+               loleseri::buffer_overrun);
+  ASSERT_THROW(
+      loleseri::deserialize<std::string>(buffer.cbegin(), buffer.cend()),
+      loleseri::buffer_overrun);
+  // 可変長の要素でも、要素ごとの最小のバイト数で長さを確認する
+  std::array<std::uint8_t, 4> too_long = {{0, 0, 0, 0x10}};
+  ASSERT_THROW(loleseri::deserialize_bounded<std::vector<std::string>>(
+                   too_long.cbegin(), too_long.cend()),
+               loleseri::buffer_overrun);
+  ASSERT_THROW(loleseri::deserialize<std::vector<std::vector<std::uint8_t>>>(
+                   too_long.cbegin(), too_long.cend()),
+               loleseri::buffer_overrun);
+}
@@ -0,0 +1,130 @@
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/loleseri.hpp>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint8_t hoge;
+  float fuga;
+  std::uint16_t piyo[2];
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.hoge == b.hoge && a.fuga == b.fuga && a.piyo[0] == b.piyo[0] &&
+         a.piyo[1] == b.piyo[1];
+}
+
+using big = std::integral_constant<loleseri::byte_order, //
+                                   loleseri::byte_order::big>;
+using little = std::integral_constant<loleseri::byte_order, //
+                                      loleseri::byte_order::little>;
+
+/** 要素ごとのシリアライズと一括コピーの結果が一致することを確認する */
+template <typename order_type, typename array_t>
+void check_array(array_t const &value) {
+  constexpr auto order = order_type::value;
+  constexpr size_t size = loleseri::serialized_size<array_t>();
+  std::vector<std::uint8_t> fast(size);
+  auto last =
+      loleseri::serialize<order>(fast.data(), fast.data() + size, &value);
+  ASSERT_EQ(fast.data() + size, last);
+  std::deque<std::uint8_t> slow(size);
+  loleseri::serialize<order>(slow.begin(), slow.end(), &value);
+  ASSERT_TRUE(std::equal(fast.begin(), fast.end(), slow.begin()));
+
+  array_t v0;
+  loleseri::deserialize<order>(fast.cbegin(), fast.cend(), &v0);
+  ASSERT_EQ(value, v0);
+  auto v1 = loleseri::deserialize<order, array_t>(slow.begin(), slow.end());
+  ASSERT_EQ(value, v1);
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint8_t Foo::*, float Foo::*,
+                               std::uint16_t(Foo::*)[2]>;
+  static inline list_type list() {
+    return {&Foo::hoge, &Foo::fuga, &Foo::piyo};
+  }
+};
+} // namespace loleseri
+
+TEST(ByteOrder, Uint32) {
+  using seri = loleseri::serializer<std::uint32_t, loleseri::byte_order::big>;
+  seri::buffer buffer;
+  std::uint32_t value = 0x1234abcd;
+  auto last = seri::serialize(buffer.begin(), buffer.end(), &value);
+  ASSERT_EQ(buffer.end(), last);
+  ASSERT_EQ(0x12, buffer[0]);
+  ASSERT_EQ(0x34, buffer[1]);
+  ASSERT_EQ(0xab, buffer[2]);
+  ASSERT_EQ(0xcd, buffer[3]);
+
+  using deseri =
+      loleseri::deserializer<std::uint32_t, loleseri::byte_order::big>;
+  ASSERT_EQ(value, deseri::deserialize(buffer.cbegin(), buffer.cend()));
+}
+
+TEST(ByteOrder, Native) {
+  std::uint16_t value = 0x1234;
+  std::array<std::uint8_t, 2> buffer;
+  loleseri::serialize<loleseri::byte_order::native>(buffer.begin(),
+                                                    buffer.end(), &value);
+  ASSERT_EQ(0, std::memcmp(buffer.data(), &value, 2));
+}
+
+TEST(ByteOrder, Struct) {
+  Foo value = {0x7b, 987.654f, {0xa1b2, 0xc3d4}};
+  std::array<std::uint8_t, 9> buffer;
+  loleseri::serialize<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                 &value);
+  // 987.654f は、ビッグエンディアンで"44,76,e9,db"
+  std::array<std::uint8_t, 9> expected = {
+      {0x7b, 0x44, 0x76, 0xe9, 0xdb, 0xa1, 0xb2, 0xc3, 0xd4}};
+  ASSERT_EQ(expected, buffer);
+  auto restored = loleseri::deserialize<loleseri::byte_order::big, Foo>(
+      buffer.cbegin(), buffer.cend());
+  ASSERT_EQ(value, restored);
+
+  static_assert(loleseri::native_layout<Foo>::candidate == false,
+                "Foo has padding");
+}
+
+TEST(ByteOrder, Arrays) {
+  std::array<std::uint16_t, 37> u16;
+  std::array<std::int32_t, 37> i32;
+  std::array<std::uint64_t, 37> u64;
+  std::array<double, 37> f64;
+  std::array<bool, 37> b;
+  for (size_t i = 0; i < 37; ++i) {
+    u16[i] = static_cast<std::uint16_t>(i * 0x0123 + 1);
+    i32[i] = static_cast<std::int32_t>(i * 0x01234567 + 1);
+    u64[i] = i * 0x0123456789abcdefull + 1;
+    f64[i] = static_cast<double>(i) * 1.25;
+    b[i] = i % 3 == 0;
+  }
+  check_array<big>(u16);
+  check_array<big>(i32);
+  check_array<big>(u64);
+  check_array<big>(f64);
+  check_array<big>(b);
+  check_array<little>(u64);
+}
+
+TEST(ByteOrder, BigEndianBytes) {
+  std::array<std::uint16_t, 20> value;
+  for (size_t i = 0; i < value.size(); ++i) {
+    value[i] = static_cast<std::uint16_t>(0x100 * i + 0xff - i);
+  }
+  std::array<std::uint8_t, 40> buffer;
+  loleseri::serialize<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                 &value);
+  for (size_t i = 0; i < value.size(); ++i) {
+    ASSERT_EQ(i, buffer[i * 2]);
+    ASSERT_EQ(0xff - i, buffer[i * 2 + 1]);
+  }
+}
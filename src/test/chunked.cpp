@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <iterator>
+#include <loleseri/chunked.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint8_t hoge;
+  float fuga;
+  std::int16_t piyo[3];
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.hoge == b.hoge && a.fuga == b.fuga && a.piyo[0] == b.piyo[0] &&
+         a.piyo[1] == b.piyo[1] && a.piyo[2] == b.piyo[2];
+}
+
+struct Message {
+  std::uint16_t id;
+  std::string name;
+  std::vector<Foo> foos;
+};
+
+bool operator==(Message const &a, Message const &b) {
+  return a.id == b.id && a.name == b.name && a.foos == b.foos;
+}
+
+Foo make_foo(int i) {
+  return {static_cast<std::uint8_t>(i), static_cast<float>(i) * 0.5f,
+          {static_cast<std::int16_t>(i), static_cast<std::int16_t>(-i), 3}};
+}
+
+/** バイト列を chunk_size バイトずつ返すコールバックを作る */
+loleseri::chunked_source::refill_type
+make_refill(std::vector<std::uint8_t> const &bytes, size_t chunk_size) {
+  auto pos = std::make_shared<size_t>(0);
+  return [&bytes, chunk_size, pos]() {
+    size_t const n = std::min(chunk_size, bytes.size() - *pos);
+    loleseri::chunked_source::chunk c = {bytes.data() + *pos, n};
+    *pos += n;
+    return c;
+  };
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint8_t Foo::*, float Foo::*,
+                               std::int16_t(Foo::*)[3]>;
+  static inline list_type list() {
+    return {&Foo::hoge, &Foo::fuga, &Foo::piyo};
+  }
+};
+
+template <> struct items<Message> {
+  using list_type = std::tuple<std::uint16_t Message::*,
+                               std::string Message::*,
+                               std::vector<Foo> Message::*>;
+  static inline list_type list() {
+    return {&Message::id, &Message::name, &Message::foos};
+  }
+};
+} // namespace loleseri
+
+TEST(Chunked, InputIterator) {
+  Foo foo = make_foo(7);
+  std::array<std::uint8_t, 11> buffer;
+  loleseri::serialize<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                 &foo);
+  std::istringstream is(std::string(buffer.begin(), buffer.end()));
+  std::istreambuf_iterator<char> begin(is), end;
+  Foo restored;
+  loleseri::deserialize<loleseri::byte_order::big>(begin, end, &restored);
+  ASSERT_EQ(foo, restored);
+  ASSERT_EQ(std::char_traits<char>::eof(), is.peek());
+}
+
+TEST(Chunked, TruncatedStream) {
+  // 途中で終わるストリームは末尾を越えて読まずに例外になる
+  std::istringstream is(std::string("\x01\x02", 2));
+  std::istreambuf_iterator<char> begin(is), end;
+  std::uint32_t value;
+  ASSERT_THROW(loleseri::deserialize(begin, end, &value),
+               loleseri::buffer_overrun);
+  std::istringstream bounded(std::string("\x01\x02", 2));
+  ASSERT_THROW((loleseri::deserialize_bounded<std::uint32_t>(
+                   std::istreambuf_iterator<char>(bounded),
+                   std::istreambuf_iterator<char>())),
+               loleseri::buffer_overrun);
+  std::istringstream message(std::string("\x00\x01\x00\x00\x00", 5));
+  ASSERT_THROW((loleseri::deserialize<Message>(
+                   std::istreambuf_iterator<char>(message),
+                   std::istreambuf_iterator<char>())),
+               loleseri::buffer_overrun);
+}
+
+TEST(Chunked, FixedSize) {
+  std::vector<std::uint8_t> bytes;
+  for (int i = 0; i < 20; ++i) {
+    loleseri::append(bytes, make_foo(i));
+  }
+  // 11 バイトのレコードを 4 バイトずつに分けて届ける
+  loleseri::chunked_source source(make_refill(bytes, 4));
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_FALSE(source.empty());
+    ASSERT_EQ(make_foo(i), source.read<Foo>());
+  }
+  ASSERT_TRUE(source.empty());
+  ASSERT_THROW(source.read<Foo>(), loleseri::buffer_overrun);
+}
+
+TEST(Chunked, VariableSize) {
+  Message message = {0x1234, "chunked", {make_foo(1), make_foo(2)}};
+  std::vector<std::uint8_t> bytes;
+  loleseri::append<loleseri::byte_order::big>(bytes, message);
+  loleseri::append<loleseri::byte_order::big>(bytes, std::uint32_t(99));
+  loleseri::chunked_source source(make_refill(bytes, 5));
+  Message restored;
+  source.read<loleseri::byte_order::big>(&restored);
+  ASSERT_EQ(message, restored);
+  ASSERT_EQ(99, (source.read<loleseri::byte_order::big, std::uint32_t>()));
+  ASSERT_TRUE(source.begin() == source.end());
+
+  bytes.resize(bytes.size() - 6);
+  loleseri::chunked_source truncated(make_refill(bytes, 3));
+  ASSERT_THROW(truncated.read<loleseri::byte_order::big>(&restored),
+               loleseri::buffer_overrun);
+}
+
+TEST(Chunked, VariableSizeInChunk) {
+  // チャンク内に収まる値はチャンクから直接、またがる値はバイトごとに読む
+  std::vector<std::uint8_t> bytes;
+  std::vector<Message> messages;
+  for (int i = 0; i < 10; ++i) {
+    messages.push_back({static_cast<std::uint16_t>(i), std::string(i, 'x'),
+                        std::vector<Foo>(i % 3, make_foo(i))});
+    loleseri::append(bytes, messages.back());
+  }
+  loleseri::chunked_source source(make_refill(bytes, 64));
+  for (auto const &message : messages) {
+    ASSERT_EQ(message, source.read<Message>());
+  }
+  ASSERT_TRUE(source.empty());
+}
+
+TEST(Chunked, BrokenLength) {
+  // 長さを測れないイテレータでは、読んだ分だけ領域を広げる
+  std::vector<std::uint8_t> bytes = {0, 0, 0, 0x10, 1, 0, 0, 0, 'a'};
+  loleseri::chunked_source source(make_refill(bytes, 4));
+  ASSERT_THROW(source.read<std::vector<std::string>>(),
+               loleseri::buffer_overrun);
+  loleseri::chunked_source strings(make_refill(bytes, 4));
+  ASSERT_THROW(strings.read<std::string>(), loleseri::buffer_overrun);
+}
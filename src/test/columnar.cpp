@@ -0,0 +1,149 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/columnar.hpp>
+#include <tuple>
+#include <vector>
+
+namespace {
+template <typename element> struct point { element x, y, z; };
+
+template <typename element>
+bool operator==(point<element> const &a, point<element> const &b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+struct Tick {
+  std::uint64_t time;
+  double price;
+  point<std::int16_t> pos;
+  bool buy;
+};
+
+bool operator==(Tick const &a, Tick const &b) {
+  return a.time == b.time && a.price == b.price && a.pos == b.pos &&
+         a.buy == b.buy;
+}
+
+struct Shape {
+  std::uint32_t id;
+  std::array<point<int>, 3> corners;
+  point<std::int16_t> marks[2];
+};
+
+} // namespace
+
+namespace loleseri {
+template <typename element> struct items<point<element>> {
+  using pt = point<element>;
+  using list_type = std::tuple<element pt::*, element pt::*, element pt::*>;
+  static list_type list() { return list_type(&pt::x, &pt::y, &pt::z); }
+};
+
+template <> struct items<Tick> {
+  using list_type =
+      std::tuple<std::uint64_t Tick::*, double Tick::*,
+                 point<std::int16_t> Tick::*, bool Tick::*>;
+  static list_type list() {
+    return list_type(&Tick::time, &Tick::price, &Tick::pos, &Tick::buy);
+  }
+};
+
+template <> struct items<Shape> {
+  using list_type =
+      std::tuple<std::uint32_t Shape::*,
+                 columnar_item<std::array<point<int>, 3>, Shape>,
+                 columnar_item<point<std::int16_t>[2], Shape>>;
+  static list_type list() {
+    return list_type(&Shape::id, columnar(&Shape::corners),
+                     columnar(&Shape::marks));
+  }
+};
+} // namespace loleseri
+
+TEST(Columnar, Layout) {
+  std::array<point<int>, 3> points = {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
+  std::vector<std::uint8_t> buffer(
+      loleseri::columnar_layout<point<int>>::serialized_size(3));
+  auto last = loleseri::serialize_columnar(buffer.begin(), buffer.end(),
+                                           points.data(), points.size());
+  ASSERT_EQ(buffer.end(), last);
+  // x, x, x, y, y, y, z, z, z の順に並ぶ
+  for (int i = 0; i < 9; ++i) {
+    auto p = buffer.data() + i * 4;
+    ASSERT_EQ(i % 3 * 3 + i / 3 + 1, loleseri::deserialize<int>(p, p + 4));
+  }
+
+  std::array<point<int>, 3> restored;
+  loleseri::deserialize_columnar(buffer.cbegin(), buffer.cend(),
+                                 restored.data(), restored.size());
+  ASSERT_EQ(points, restored);
+}
+
+TEST(Columnar, SingleColumn) {
+  using columnar = loleseri::columnar_layout<Tick, loleseri::byte_order::big>;
+  static_assert(columnar::column_offset<1>(10) == 80,
+                "price column starts at 80");
+  static_assert(columnar::column_offset<3>(10) == 220,
+                "buy column starts at 220");
+  std::vector<Tick> ticks;
+  for (std::uint64_t i = 0; i < 10; ++i) {
+    auto s = static_cast<std::int16_t>(i);
+    ticks.push_back({1000 + i, 0.5 * static_cast<double>(i), {s, s, s},
+                     i % 2 == 0});
+  }
+  std::deque<std::uint8_t> buffer(columnar::serialized_size(ticks.size()));
+  columnar::serialize(buffer.begin(), buffer.end(), ticks.data(),
+                      ticks.size());
+
+  std::vector<double> prices(ticks.size());
+  columnar::deserialize_column<1>(buffer.begin(), buffer.end(), ticks.size(),
+                                  prices.data());
+  for (size_t i = 0; i < ticks.size(); ++i) {
+    ASSERT_EQ(ticks[i].price, prices[i]);
+  }
+
+  std::vector<std::uint8_t> contiguous(buffer.begin(), buffer.end());
+  std::vector<std::uint64_t> times(ticks.size());
+  columnar::deserialize_column<0>(contiguous.data(),
+                                  contiguous.data() + contiguous.size(),
+                                  ticks.size(), times.data());
+  ASSERT_EQ(1009, times[9]);
+  ASSERT_THROW(columnar::deserialize_column<0>(contiguous.data(),
+                                               contiguous.data() + 10,
+                                               ticks.size(), times.data()),
+               loleseri::buffer_overrun);
+
+  std::vector<Tick> restored(ticks.size());
+  loleseri::deserialize_columnar<loleseri::byte_order::big>(
+      contiguous.data(), contiguous.data() + contiguous.size(),
+      restored.data(), restored.size());
+  ASSERT_EQ(ticks, restored);
+}
+
+TEST(Columnar, Item) {
+  // 構造体の配列のメンバを、レコードの中で列ごとに並べる
+  Shape const shape = {7, {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}},
+                       {{10, 11, 12}, {13, 14, 15}}};
+  ASSERT_TRUE(loleseri::is_fixed_size<Shape>::value);
+  ASSERT_EQ(4 + 36 + 12, loleseri::serialized_size<Shape>());
+  loleseri::serializer<Shape, loleseri::byte_order::big>::buffer buffer;
+  loleseri::serialize<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                 &shape);
+  for (int i = 0; i < 9; ++i) {
+    auto p = buffer.data() + 4 + i * 4;
+    ASSERT_EQ(i % 3 * 3 + i / 3 + 1,
+              (loleseri::deserialize<loleseri::byte_order::big, int>(p,
+                                                                     p + 4)));
+  }
+  auto p = buffer.data() + 40;
+  ASSERT_EQ(13, (loleseri::deserialize<loleseri::byte_order::big,
+                                       std::int16_t>(p + 2, p + 4)));
+
+  auto restored = loleseri::deserialize<loleseri::byte_order::big, Shape>(
+      buffer.cbegin(), buffer.cend());
+  ASSERT_EQ(shape.id, restored.id);
+  ASSERT_EQ(shape.corners, restored.corners);
+  ASSERT_EQ(shape.marks[0], restored.marks[0]);
+  ASSERT_EQ(shape.marks[1], restored.marks[1]);
+}
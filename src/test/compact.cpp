@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/compact.hpp>
+#include <loleseri/loleseri.hpp>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+namespace encoding = loleseri::compact_encoding;
+
+struct Counter {
+  std::uint32_t id;
+  std::int64_t hits;
+  std::int32_t delta;
+  std::array<std::uint32_t, 9> samples;
+  std::vector<std::int64_t> offsets;
+  std::int16_t steps[3];
+};
+
+bool operator==(Counter const &a, Counter const &b) {
+  return a.id == b.id && a.hits == b.hits && a.delta == b.delta &&
+         a.samples == b.samples && a.offsets == b.offsets &&
+         std::equal(a.steps, a.steps + 3, b.steps);
+}
+
+Counter create() {
+  return Counter{7,
+                 300,
+                 -2,
+                 {{0, 1, 0x100, 0x10000, 0x1000000, 5, 6, 7, 8}},
+                 {-1, 1, -0x8000, 0x100000000LL, -0x7fffffffffffffffLL},
+                 {-1, 0x7fff, -0x8000}};
+}
+
+template <typename value_type, int e = encoding::varint>
+std::vector<std::uint8_t> compact_bytes(value_type const &v) {
+  using seri = loleseri::serializer<loleseri::compact<value_type, e>>;
+  std::vector<std::uint8_t> r(seri::serialized_size(&v));
+  seri::serialize(r.begin(), r.end(), &v);
+  return r;
+}
+
+struct Tick {
+  std::array<std::uint64_t, 64> timestamps;
+  std::vector<std::uint32_t> sequences;
+  std::int16_t levels[5];
+};
+
+bool operator==(Tick const &a, Tick const &b) {
+  return a.timestamps == b.timestamps && a.sequences == b.sequences &&
+         std::equal(a.levels, a.levels + 5, b.levels);
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Counter> {
+  using list_type = std::tuple<
+      std::uint32_t Counter::*,
+      compact_item<std::int64_t, Counter, compact_encoding::varint>,
+      compact_item<std::int32_t, Counter, compact_encoding::zigzag>,
+      compact_item<std::array<std::uint32_t, 9>, Counter,
+                   compact_encoding::varint>,
+      compact_item<std::vector<std::int64_t>, Counter,
+                   compact_encoding::zigzag>,
+      compact_item<std::int16_t[3], Counter, compact_encoding::zigzag>>;
+  static inline list_type list() {
+    return list_type{&Counter::id,           varint(&Counter::hits),
+                     zigzag(&Counter::delta), varint(&Counter::samples),
+                     zigzag(&Counter::offsets), zigzag(&Counter::steps)};
+  }
+};
+
+template <> struct items<Tick> {
+  using list_type = std::tuple<
+      compact_item<std::array<std::uint64_t, 64>, Tick,
+                   compact_encoding::delta_of_delta>,
+      compact_item<std::vector<std::uint32_t>, Tick, compact_encoding::delta>,
+      compact_item<std::int16_t[5], Tick, compact_encoding::delta>>;
+  static inline list_type list() {
+    return list_type{delta_of_delta(&Tick::timestamps),
+                     delta(&Tick::sequences), delta(&Tick::levels)};
+  }
+};
+} // namespace loleseri
+
+TEST(Compact, Varint) {
+  using bytes = std::vector<std::uint8_t>;
+  ASSERT_EQ(bytes({0}), compact_bytes(std::uint32_t(0)));
+  ASSERT_EQ(bytes({0x7f}), compact_bytes(std::uint32_t(127)));
+  ASSERT_EQ(bytes({0xac, 0x02}), compact_bytes(std::uint64_t(300)));
+  ASSERT_EQ(bytes({0xff, 0xff, 0xff, 0xff, 0x0f}),
+            compact_bytes(std::uint32_t(0xffffffff)));
+  ASSERT_EQ(10, compact_bytes(std::int64_t(-1)).size());
+
+  // zigzag では絶対値が小さい負の値も短くなる
+  constexpr int zz = encoding::zigzag;
+  ASSERT_EQ(bytes({1}), (compact_bytes<std::int32_t, zz>(-1)));
+  ASSERT_EQ(bytes({2}), (compact_bytes<std::int32_t, zz>(1)));
+  ASSERT_EQ(bytes({0x7f}), (compact_bytes<std::int32_t, zz>(-64)));
+  ASSERT_EQ(bytes({0xff, 0x01}), (compact_bytes<std::int8_t, zz>(-128)));
+}
+
+TEST(Compact, StreamVByte) {
+  std::array<std::uint32_t, 5> a = {{1, 0x100, 0x10000, 0x1000000, 2}};
+  // 制御バイト 2 個 ( 4 値ごとに 1 個 ) の後に各値のバイト列が続く
+  std::vector<std::uint8_t> expected = {0xe4, 0x00, 1, 0,    1, 0,    0,
+                                        1,    0,    0, 0,    1, 2};
+  ASSERT_EQ(expected, compact_bytes(a));
+
+  std::array<std::int64_t, 3> b = {{-1, 0x100, -0x80000000LL}};
+  expected = {0x24, 1, 0, 2, 0xff, 0xff, 0xff, 0xff};
+  ASSERT_EQ(expected,
+            (compact_bytes<std::array<std::int64_t, 3>, encoding::zigzag>(b)));
+}
+
+TEST(Compact, Struct) {
+  auto const foo = create();
+  auto const size = loleseri::serialized_size(foo);
+  ASSERT_EQ(4 + 2 + 1 + (3 + 1 + 2 + 3 + 4 + 5) + (4 + 2 + 1 + 1 + 2 + 8 + 8) +
+                (1 + 1 + 2 + 2),
+            size);
+  ASSERT_FALSE(loleseri::is_fixed_size<Counter>::value);
+
+  std::vector<std::uint8_t> buf(size);
+  ASSERT_EQ(buf.end(), loleseri::serialize(buf.begin(), buf.end(), &foo));
+  ASSERT_EQ(7, buf[0]);
+  ASSERT_EQ(0xac, buf[4]);
+  ASSERT_EQ(0x02, buf[5]);
+  ASSERT_EQ(3, buf[6]);
+  ASSERT_EQ(foo, loleseri::deserialize<Counter>(buf.begin(), buf.end()));
+
+  std::deque<char> deq(buf.begin(), buf.end());
+  ASSERT_EQ(foo, loleseri::deserialize<Counter>(deq.begin(), deq.end()));
+
+  std::vector<std::uint8_t> big(size);
+  loleseri::serialize<loleseri::byte_order::big>(big.begin(), big.end(), &foo);
+  ASSERT_EQ(7, big[3]);
+  ASSERT_EQ(0xac, big[4]);
+  auto restored = loleseri::deserialize<loleseri::byte_order::big, Counter>(
+      big.begin(), big.end());
+  ASSERT_EQ(foo, restored);
+}
+
+TEST(Compact, LongArray) {
+  std::mt19937_64 rng(1);
+  for (size_t count : {0, 1, 3, 4, 5, 17, 1000}) {
+    Counter foo = create();
+    foo.offsets.clear();
+    for (size_t i = 0; i < count; ++i) {
+      auto const v = static_cast<std::int64_t>(rng());
+      foo.offsets.push_back(v >> (rng() % 64));
+    }
+    std::vector<std::uint8_t> buf;
+    loleseri::serialize(std::back_inserter(buf), std::back_inserter(buf), &foo);
+    ASSERT_EQ(loleseri::serialized_size(foo), buf.size());
+
+    auto const p = buf.data();
+    ASSERT_EQ(foo, loleseri::deserialize<Counter>(p, p + buf.size()));
+    std::deque<std::uint8_t> deq(buf.begin(), buf.end());
+    ASSERT_EQ(foo, loleseri::deserialize<Counter>(deq.begin(), deq.end()));
+  }
+
+  std::vector<std::uint32_t> values(1001);
+  for (auto &v : values) {
+    v = static_cast<std::uint32_t>(rng()) >> (rng() % 32);
+  }
+  using codec = loleseri::compact<decltype(values), encoding::varint>;
+  using seri = loleseri::serializer<codec>;
+  std::vector<std::uint8_t> buf(seri::serialized_size(&values));
+  seri::serialize(buf.begin(), buf.end(), &values);
+  decltype(values) restored;
+  using deseri = loleseri::deserializer<codec>;
+  ASSERT_EQ(buf.end(), deseri::deserialize(buf.begin(), buf.end(), &restored));
+  ASSERT_EQ(values, restored);
+}
+
+TEST(Compact, Errors) {
+  auto const foo = create();
+  std::vector<std::uint8_t> buf(loleseri::serialized_size(foo));
+  loleseri::serialize(buf.begin(), buf.end(), &foo);
+  for (size_t n : {size_t(0), size_t(5), size_t(12), buf.size() - 1}) {
+    ASSERT_THROW(
+        loleseri::deserialize<Counter>(buf.cbegin(), buf.cbegin() + n),
+        loleseri::buffer_overrun);
+  }
+  ASSERT_THROW(loleseri::serialize(buf.begin(), buf.end() - 1, &foo),
+               loleseri::buffer_overrun);
+
+  using deseri = loleseri::deserializer<
+      loleseri::compact<std::uint32_t, encoding::varint>>;
+  std::uint32_t v;
+  std::vector<std::uint8_t> too_large = {0xff, 0xff, 0xff, 0xff, 0x1f};
+  ASSERT_THROW(deseri::deserialize(too_large.begin(), too_large.end(), &v),
+               loleseri::invalid_varint);
+  std::vector<std::uint8_t> too_long(11, 0x80);
+  ASSERT_THROW(deseri::deserialize(too_long.begin(), too_long.end(), &v),
+               loleseri::invalid_varint);
+
+  // 16bit 整数の符号 2 ( 3 バイト ) は不正
+  using deseri16 = loleseri::deserializer<
+      loleseri::compact<std::array<std::uint16_t, 1>, encoding::varint>>;
+  std::array<std::uint16_t, 1> a;
+  std::vector<std::uint8_t> bad_code = {2, 0, 0, 0};
+  ASSERT_THROW(deseri16::deserialize(bad_code.begin(), bad_code.end(), &a),
+               loleseri::invalid_varint);
+}
+
+TEST(Compact, Delta) {
+  std::array<std::uint32_t, 4> a = {{100, 101, 103, 103}};
+  // 差分 100, 1, 2, 0 を zigzag で符号化する
+  std::vector<std::uint8_t> expected = {0, 200, 2, 4, 0};
+  ASSERT_EQ(expected, (compact_bytes<decltype(a), encoding::delta>(a)));
+
+  std::array<std::uint64_t, 4> b = {{1000, 1010, 1020, 1030}};
+  // 差分の差分 1000, -990, 0, 0
+  expected = {0x05, 0xd0, 0x07, 0xbb, 0x07, 0, 0};
+  ASSERT_EQ(expected,
+            (compact_bytes<decltype(b), encoding::delta_of_delta>(b)));
+
+  using deseri =
+      loleseri::deserializer<loleseri::compact<decltype(b), encoding::delta>>;
+  decltype(b) restored;
+  auto bytes = compact_bytes<decltype(b), encoding::delta>(b);
+  deseri::deserialize(bytes.begin(), bytes.end(), &restored);
+  ASSERT_EQ(b, restored);
+}
+
+TEST(Compact, DeltaStruct) {
+  std::mt19937_64 rng(2);
+  for (size_t count : {0, 1, 3, 4, 5, 17, 1000}) {
+    Tick tick;
+    std::uint64_t t = 1600000000000000000ULL;
+    for (auto &e : tick.timestamps) {
+      t += 1000000 + rng() % 100;
+      e = t;
+    }
+    std::uint32_t seq = 0xfffffff0u;
+    for (size_t i = 0; i < count; ++i) {
+      seq += static_cast<std::uint32_t>(rng() % 3);
+      tick.sequences.push_back(seq);
+    }
+    std::int16_t const levels[5] = {0, -0x8000, 0x7fff, -1, 1};
+    std::copy(levels, levels + 5, tick.levels);
+
+    auto const size = loleseri::serialized_size(tick);
+    ASSERT_LT(size, 16 + 3 + 64 * 2 + 4 + (count + 3) / 4 + count + 10);
+    std::vector<std::uint8_t> buf(size);
+    ASSERT_EQ(buf.end(), loleseri::serialize(buf.begin(), buf.end(), &tick));
+    ASSERT_EQ(tick, loleseri::deserialize<Tick>(buf.begin(), buf.end()));
+    std::deque<std::uint8_t> deq(buf.begin(), buf.end());
+    ASSERT_EQ(tick, loleseri::deserialize<Tick>(deq.begin(), deq.end()));
+  }
+}
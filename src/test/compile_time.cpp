@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <loleseri/compile_time.hpp>
+#include <tuple>
+
+namespace {
+struct Point {
+  std::int16_t x, y;
+};
+
+struct Handshake {
+  std::uint32_t magic;
+  std::uint8_t version;
+  bool compressed;
+  Point origin;
+  std::array<std::uint16_t, 3> ports;
+  std::int8_t levels[2];
+  double ratio;
+};
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Point> {
+  using list_type = std::tuple<std::int16_t Point::*, std::int16_t Point::*>;
+  static constexpr list_type list() { return list_type(&Point::x, &Point::y); }
+};
+
+template <> struct items<Handshake> {
+  using h = Handshake;
+  using list_type =
+      std::tuple<std::uint32_t h::*, std::uint8_t h::*, bool h::*, Point h::*,
+                 std::array<std::uint16_t, 3> h::*, std::int8_t(h::*)[2],
+                 double h::*>;
+  static constexpr list_type list() {
+    return list_type(&h::magic, &h::version, &h::compressed, &h::origin,
+                     &h::ports, &h::levels, &h::ratio);
+  }
+};
+} // namespace loleseri
+
+namespace {
+constexpr Handshake handshake = {
+    0x4c4f4c45, 3, true, {-2, 300}, {{80, 443, 8080}}, {-1, 1}, 1.5};
+
+// コンパイル時にシリアライズする
+constexpr auto handshake_bytes = loleseri::constexpr_serialize(handshake);
+constexpr auto handshake_big_bytes =
+    loleseri::constexpr_serialize<loleseri::byte_order::big>(handshake);
+
+static_assert(handshake_bytes.size() == 26, "size of Handshake is 26");
+static_assert(handshake_bytes[0] == 0x45 && handshake_bytes[3] == 0x4c,
+              "magic is little endian");
+static_assert(handshake_big_bytes[0] == 0x4c && handshake_big_bytes[3] == 0x45,
+              "magic is big endian");
+static_assert(handshake_bytes[5] == 1, "compressed is true");
+static_assert(handshake_bytes[6] == 0xfe && handshake_bytes[7] == 0xff,
+              "origin.x is -2");
+
+// コンパイル時に復元する
+constexpr auto restored = loleseri::constexpr_deserialize<Handshake>(
+    handshake_bytes);
+static_assert(restored.origin.y == 300, "origin.y is restored");
+static_assert(restored.ports[2] == 8080, "ports are restored");
+static_assert(restored.levels[0] == -1, "levels are restored");
+static_assert(restored.ratio == 1.5, "ratio is restored");
+} // namespace
+
+TEST(CompileTime, SameAsRuntime) {
+  loleseri::serializer<Handshake>::buffer buffer;
+  loleseri::serialize(buffer.begin(), buffer.end(), &handshake);
+  ASSERT_EQ(buffer, handshake_bytes);
+
+  loleseri::serialize<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                 &handshake);
+  ASSERT_EQ(buffer, handshake_big_bytes);
+
+  auto big = loleseri::constexpr_deserialize<loleseri::byte_order::big,
+                                             Handshake>(handshake_big_bytes);
+  ASSERT_EQ(handshake.magic, big.magic);
+  ASSERT_EQ(handshake.ports, big.ports);
+  ASSERT_EQ(handshake.ratio, big.ratio);
+}
+
+TEST(CompileTime, Arithmetic) {
+  constexpr auto f = loleseri::constexpr_serialize(-0.75f);
+  static_assert(f[3] == 0xbf && f[2] == 0x40, "-0.75f is bf400000");
+  constexpr auto i = loleseri::constexpr_serialize<loleseri::byte_order::big>(
+      std::int64_t(-2));
+  static_assert(i[0] == 0xff && i[7] == 0xfe, "-2 is fffffffffffffffe");
+  static_assert(loleseri::constexpr_deserialize<std::int64_t>(
+                    loleseri::constexpr_serialize(std::int64_t(-12345))) ==
+                    -12345,
+                "negative integer is restored");
+  ASSERT_EQ(-0.75f, loleseri::constexpr_deserialize<float>(f));
+}
+
+namespace {
+/** memcpy で得た実行時のビット列 */
+template <typename float_type>
+typename loleseri::ieee754<float_type>::bits_type bits_of(float_type v) {
+  typename loleseri::ieee754<float_type>::bits_type r;
+  std::memcpy(&r, &v, sizeof(r));
+  return r;
+}
+
+template <typename float_type> void check_ieee754() {
+  using codec = loleseri::ieee754<float_type>;
+  using limits = std::numeric_limits<float_type>;
+  float_type const values[] = {0,
+                                1,
+                                -1,
+                                0.1f,
+                                -1234.5f,
+                                3.0e-5f,
+                                limits::min(),
+                                limits::max(),
+                                limits::lowest(),
+                                limits::denorm_min(),
+                                limits::min() / 3,
+                                limits::infinity(),
+                                -limits::infinity()};
+  for (auto v : values) {
+    ASSERT_EQ(bits_of(v), codec::encode(v)) << v;
+    ASSERT_EQ(bits_of(v), bits_of(codec::decode(bits_of(v)))) << v;
+  }
+  ASSERT_EQ(bits_of(limits::quiet_NaN()), codec::encode(limits::quiet_NaN()));
+  auto const nan = codec::decode(bits_of(limits::quiet_NaN()));
+  ASSERT_NE(nan, nan);
+  auto const negative_zero = bits_of(-float_type(0));
+  ASSERT_EQ(negative_zero, bits_of(codec::decode(negative_zero)));
+}
+} // namespace
+
+TEST(CompileTime, IEEE754) {
+  // bit_cast が使えない場合の符号化
+  static_assert(loleseri::ieee754<float>::encode(-0.75f) == 0xbf400000u,
+                "-0.75f is bf400000");
+  static_assert(loleseri::ieee754<double>::decode(0x3ff8000000000000u) == 1.5,
+                "3ff8000000000000 is 1.5");
+  check_ieee754<float>();
+  check_ieee754<double>();
+}
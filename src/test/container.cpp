@@ -0,0 +1,156 @@
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/loleseri.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint8_t hoge;
+  float fuga;
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.hoge == b.hoge && a.fuga == b.fuga;
+}
+
+struct Message {
+  std::uint16_t id;
+  std::string name;
+  std::vector<Foo> foos;
+  std::array<std::vector<std::int32_t>, 2> values;
+};
+
+bool operator==(Message const &a, Message const &b) {
+  return a.id == b.id && a.name == b.name && a.foos == b.foos &&
+         a.values == b.values;
+}
+
+} // namespace
+
+namespace loleseri {
+
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint8_t Foo::*, float Foo::*>;
+  static inline list_type list() { return {&Foo::hoge, &Foo::fuga}; }
+};
+
+template <> struct items<Message> {
+  using list_type =
+      std::tuple<std::uint16_t Message::*, std::string Message::*,
+                 std::vector<Foo> Message::*,
+                 std::array<std::vector<std::int32_t>, 2> Message::*>;
+  static inline list_type list() {
+    return {&Message::id, &Message::name, &Message::foos, &Message::values};
+  }
+};
+} // namespace loleseri
+
+TEST(Container, FixedSize) {
+  static_assert(loleseri::is_fixed_size<Foo>::value, "Foo has fixed size");
+  static_assert(!loleseri::is_fixed_size<Message>::value,
+                "Message has variable size");
+  static_assert(!loleseri::is_fixed_size<std::vector<int>>::value,
+                "std::vector has variable size");
+  static_assert(!loleseri::is_fixed_size<std::string[2]>::value,
+                "array of std::string has variable size");
+  static_assert(loleseri::serialized_size<Foo>() == 5, "size of Foo is 5");
+  Foo foo = {1, 2.0f};
+  ASSERT_EQ(5, loleseri::serialized_size(foo));
+}
+
+TEST(Container, Vector) {
+  std::vector<std::int32_t> value = {1, -2, 0x12345678};
+  ASSERT_EQ(16, loleseri::serialized_size(value));
+  std::vector<std::uint8_t> buffer(loleseri::serialized_size(value));
+  auto last = loleseri::serialize(buffer.begin(), buffer.end(), &value);
+  ASSERT_EQ(buffer.end(), last);
+  std::vector<std::uint8_t> expected = {3,    0,    0,    0,    1,    0,
+                                        0,    0,    0xfe, 0xff, 0xff, 0xff,
+                                        0x78, 0x56, 0x34, 0x12};
+  ASSERT_EQ(expected, buffer);
+
+  auto v0 = loleseri::deserialize<std::vector<std::int32_t>>(buffer.cbegin(),
+                                                             buffer.cend());
+  ASSERT_EQ(value, v0);
+
+  std::deque<std::uint8_t> slow(buffer.size());
+  loleseri::serialize<loleseri::byte_order::big>(slow.begin(), slow.end(),
+                                                 &value);
+  ASSERT_EQ(3, slow[3]);
+  ASSERT_EQ(0x12, slow[12]);
+  std::vector<std::int32_t> v1 = {9, 9, 9, 9, 9};
+  auto p = loleseri::deserialize<loleseri::byte_order::big>(
+      slow.begin(), slow.end(), &v1);
+  ASSERT_EQ(slow.end(), p);
+  ASSERT_EQ(value, v1);
+}
+
+TEST(Container, EmptyVector) {
+  std::vector<double> value;
+  std::vector<std::uint8_t> buffer(loleseri::serialized_size(value));
+  ASSERT_EQ(4, buffer.size());
+  loleseri::serialize(buffer.begin(), buffer.end(), &value);
+  std::vector<double> restored = {1.0};
+  loleseri::deserialize(buffer.cbegin(), buffer.cend(), &restored);
+  ASSERT_TRUE(restored.empty());
+}
+
+TEST(Container, TooLong) {
+  // 長さが length_type に収まらない場合は std::length_error を投げる
+  ASSERT_EQ(0xffffffffu, loleseri::length_of(0xffffffffu));
+  if (sizeof(size_t) <= sizeof(loleseri::length_type)) {
+    return;
+  }
+  size_t const too_many = size_t(0xffffffffu) + 1;
+  ASSERT_THROW(loleseri::length_of(too_many), std::length_error);
+}
+
+TEST(Container, String) {
+  std::string value = "loleseri";
+  ASSERT_EQ(12, loleseri::serialized_size(value));
+  std::vector<char> buffer;
+  auto out = std::back_inserter(buffer);
+  loleseri::serialize(out, out, &value);
+  ASSERT_EQ(12, buffer.size());
+  ASSERT_EQ(8, buffer[0]);
+  ASSERT_EQ('l', buffer[4]);
+  ASSERT_EQ('i', buffer[11]);
+  auto restored =
+      loleseri::deserialize<std::string>(buffer.data(), buffer.data() + 12);
+  ASSERT_EQ(value, restored);
+
+  std::u16string wide = u"abc";
+  std::array<std::uint8_t, 10> wbuffer;
+  loleseri::serialize<loleseri::byte_order::big>(wbuffer.begin(),
+                                                 wbuffer.end(), &wide);
+  ASSERT_EQ(0, wbuffer[4]);
+  ASSERT_EQ('a', wbuffer[5]);
+  auto wrestored =
+      loleseri::deserialize<loleseri::byte_order::big, std::u16string>(
+          wbuffer.cbegin(), wbuffer.cend());
+  ASSERT_EQ(wide, wrestored);
+}
+
+TEST(Container, Struct) {
+  Message value = {
+      0x1234, "hello", {{1, 1.5f}, {2, 2.5f}}, {{{1, 2, 3}, {}}}};
+  size_t const size = loleseri::serialized_size(value);
+  ASSERT_EQ(2 + (4 + 5) + (4 + 5 * 2) + (4 + 4 * 3) + 4, size);
+  std::vector<std::uint8_t> buffer(size);
+  auto last = loleseri::serialize(buffer.data(), buffer.data() + size, &value);
+  ASSERT_EQ(buffer.data() + size, last);
+
+  Message restored;
+  auto p = loleseri::deserialize(buffer.cbegin(), buffer.cend(), &restored);
+  ASSERT_EQ(buffer.cend(), p);
+  ASSERT_EQ(value, restored);
+
+  std::vector<Message> messages = {value, value, Message()};
+  std::vector<std::uint8_t> mbuffer(loleseri::serialized_size(messages));
+  loleseri::serialize(mbuffer.begin(), mbuffer.end(), &messages);
+  auto mrestored = loleseri::deserialize<std::vector<Message>>(
+      mbuffer.cbegin(), mbuffer.cend());
+  ASSERT_EQ(messages, mrestored);
+}
@@ -0,0 +1,176 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/compact.hpp>
+#include <loleseri/crc32c.hpp>
+#include <loleseri/loleseri.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Tick {
+  std::uint64_t stamp;
+  double price;
+  std::int32_t qty[3];
+};
+
+// 可変長
+struct Record {
+  std::uint32_t id;
+  std::string name;
+  std::vector<Tick> ticks;
+  std::uint64_t count;
+};
+
+Record create_record() {
+  Record r{};
+  r.id = 7;
+  r.name = "record";
+  for (std::uint64_t i = 0; i < 50; ++i) {
+    r.ticks.push_back(Tick{i, 0.5 * static_cast<double>(i),
+                           {1, -2, static_cast<std::int32_t>(i)}});
+  }
+  r.count = 123456;
+  return r;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Tick> {
+  using list_type = std::tuple<std::uint64_t Tick::*, double Tick::*,
+                               std::int32_t(Tick::*)[3]>;
+  static inline list_type list() {
+    return list_type{&Tick::stamp, &Tick::price, &Tick::qty};
+  }
+};
+
+template <> struct items<Record> {
+  using list_type =
+      std::tuple<std::uint32_t Record::*, std::string Record::*,
+                 std::vector<Tick> Record::*,
+                 compact_item<std::uint64_t, Record, compact_encoding::varint>>;
+  static inline list_type list() {
+    return list_type{&Record::id, &Record::name, &Record::ticks,
+                     varint(&Record::count)};
+  }
+};
+} // namespace loleseri
+
+TEST(Crc32c, KnownValues) {
+  std::string const digits = "123456789";
+  ASSERT_EQ(0xe3069283u,
+            loleseri::crc32c::checksum(digits.begin(), digits.end()));
+  std::vector<std::uint8_t> zeros(32, 0);
+  ASSERT_EQ(0x8a9136aau,
+            loleseri::crc32c::checksum(zeros.begin(), zeros.end()));
+  std::deque<std::uint8_t> ones(32, 0xff);
+  ASSERT_EQ(0x62a8ab43u, loleseri::crc32c::checksum(ones.begin(), ones.end()));
+  ASSERT_EQ(0u, loleseri::crc32c::checksum(zeros.begin(), zeros.begin()));
+
+  // テーブルによる計算と命令による計算が一致する
+  std::vector<std::uint8_t> bytes(1000);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<std::uint8_t>(i * 37 + (i >> 3));
+  }
+  for (size_t n : {0, 1, 7, 8, 9, 63, 1000}) {
+    auto const s = loleseri::crc32c::update_table(loleseri::crc32c::initial,
+                                                  bytes.data(), n);
+    std::uint32_t b = loleseri::crc32c::initial;
+    for (size_t i = 0; i < n; ++i) {
+      b = loleseri::crc32c::update_byte(b, bytes[i]);
+    }
+    ASSERT_EQ(b, s) << n;
+    ASSERT_EQ(s, loleseri::crc32c::update(loleseri::crc32c::initial,
+                                          bytes.data(), n))
+        << n;
+  }
+}
+
+TEST(Crc32c, Fixed) {
+  ASSERT_EQ(loleseri::serializer<Tick>::size + 4,
+            (loleseri::crc_checked<Tick, loleseri::byte_order::little>::size));
+  Tick const src{1, 2.5, {3, 4, 5}};
+  loleseri::crc_checked<Tick, loleseri::byte_order::little>::buffer buf;
+  ASSERT_EQ(buf.end(),
+            loleseri::serialize_checked(buf.begin(), buf.end(), &src));
+  // 末尾はシリアライズしたデータの CRC-32C
+  auto const sum = loleseri::crc32c::checksum(buf.begin(), buf.end() - 4);
+  ASSERT_EQ(sum & 0xff, buf[buf.size() - 4]);
+  ASSERT_EQ(sum >> 24, buf[buf.size() - 1]);
+
+  Tick r{};
+  ASSERT_EQ(buf.end(),
+            loleseri::deserialize_checked(buf.begin(), buf.end(), &r));
+  ASSERT_EQ(src.price, r.price);
+  ASSERT_EQ(src.qty[2], r.qty[2]);
+
+  ASSERT_THROW(loleseri::deserialize_checked(buf.begin(), buf.end() - 1, &r),
+               loleseri::buffer_overrun);
+  ASSERT_THROW(loleseri::serialize_checked(buf.begin(), buf.end() - 1, &src),
+               loleseri::buffer_overrun);
+  buf[3] ^= 0x10;
+  ASSERT_THROW(loleseri::deserialize_checked(buf.begin(), buf.end(), &r),
+               loleseri::checksum_mismatch);
+}
+
+TEST(Crc32c, Variable) {
+  auto const src = create_record();
+  using checked = loleseri::crc_checked<Record, loleseri::byte_order::little>;
+  std::vector<std::uint8_t> buf(checked::serialized_size(&src));
+  ASSERT_EQ(loleseri::serializer<Record>::serialized_size(&src) + 4,
+            buf.size());
+  ASSERT_EQ(buf.end(),
+            loleseri::serialize_checked(buf.begin(), buf.end(), &src));
+  // 項目ごとに計算しても全体の CRC-32C と同じ
+  std::vector<std::uint8_t> plain(buf.size() - 4);
+  loleseri::serialize(plain.begin(), plain.end(), &src);
+  ASSERT_TRUE(std::equal(plain.begin(), plain.end(), buf.begin()));
+  auto const sum = loleseri::crc32c::checksum(plain.begin(), plain.end());
+  ASSERT_EQ(sum >> 24, buf.back());
+
+  Record r{};
+  ASSERT_EQ(buf.end(),
+            loleseri::deserialize_checked(buf.begin(), buf.end(), &r));
+  ASSERT_EQ(src.name, r.name);
+  ASSERT_EQ(src.ticks.size(), r.ticks.size());
+  ASSERT_EQ(src.ticks[49].price, r.ticks[49].price);
+  ASSERT_EQ(src.count, r.count);
+
+  std::deque<char> deq(buf.begin(), buf.end());
+  Record d{};
+  ASSERT_EQ(deq.end(),
+            loleseri::deserialize_checked(deq.begin(), deq.end(), &d));
+  ASSERT_EQ(src.count, d.count);
+
+  for (size_t i : {0, 10, 200, 1000}) {
+    auto broken = buf;
+    broken[i] ^= 1;
+    ASSERT_ANY_THROW(
+        loleseri::deserialize_checked(broken.begin(), broken.end(), &r))
+        << i;
+  }
+  auto tail = buf;
+  tail.back() ^= 0x80;
+  ASSERT_THROW(loleseri::deserialize_checked(tail.begin(), tail.end(), &r),
+               loleseri::checksum_mismatch);
+  ASSERT_THROW(loleseri::deserialize_checked(buf.begin(), buf.end() - 1, &r),
+               loleseri::buffer_overrun);
+}
+
+TEST(Crc32c, ByteOrder) {
+  Tick const src{0x0102030405060708u, -1.0, {0, 0, 0}};
+  loleseri::crc_checked<Tick, loleseri::byte_order::big>::buffer buf;
+  loleseri::serialize_checked<loleseri::byte_order::big>(buf.begin(),
+                                                         buf.end(), &src);
+  ASSERT_EQ(0x01, buf[0]);
+  auto const sum = loleseri::crc32c::checksum(buf.begin(), buf.end() - 4);
+  ASSERT_EQ(sum >> 24, buf[buf.size() - 4]);
+  Tick r{};
+  loleseri::deserialize_checked<loleseri::byte_order::big>(buf.begin(),
+                                                           buf.end(), &r);
+  ASSERT_EQ(src.stamp, r.stamp);
+  ASSERT_THROW(loleseri::deserialize_checked(buf.begin(), buf.end(), &r),
+               loleseri::checksum_mismatch);
+}
@@ -0,0 +1,235 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/compact.hpp>
+#include <loleseri/delta.hpp>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/packed.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+bool operator==(Vec3 const &a, Vec3 const &b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// 固定長
+struct Body {
+  std::uint32_t tick;
+  Vec3 pos;
+  Vec3 vel;
+  std::int32_t cells[20];
+  bool awake;
+  bool grounded;
+};
+
+bool operator==(Body const &a, Body const &b) {
+  return a.tick == b.tick && a.pos == b.pos && a.vel == b.vel &&
+         std::equal(a.cells, a.cells + 20, b.cells) && a.awake == b.awake &&
+         a.grounded == b.grounded;
+}
+
+// 可変長
+struct World {
+  std::uint64_t frame;
+  std::array<Body, 3> bodies;
+  std::string name;
+  std::vector<std::uint32_t> ids;
+  std::vector<std::int64_t> scores;
+};
+
+bool operator==(World const &a, World const &b) {
+  return a.frame == b.frame && a.bodies == b.bodies && a.name == b.name &&
+         a.ids == b.ids && a.scores == b.scores;
+}
+
+Body create_body(std::uint32_t seed) {
+  Body r{};
+  r.tick = seed;
+  r.pos = Vec3{static_cast<float>(seed), 2.0f, 3.0f};
+  r.vel = Vec3{0.5f, 0.0f, -0.5f};
+  for (int i = 0; i < 20; ++i) {
+    r.cells[i] = static_cast<std::int32_t>(seed) * 100 + i;
+  }
+  r.awake = true;
+  return r;
+}
+
+World create_world() {
+  World r{};
+  r.frame = 1000;
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    r.bodies[i] = create_body(i);
+  }
+  r.name = "arena";
+  r.ids = {1, 2, 3};
+  r.scores = {-5, 10};
+  return r;
+}
+
+template <typename type>
+std::vector<std::uint8_t> delta_bytes(type const &prev, type const &cur) {
+  std::vector<std::uint8_t> r(loleseri::serialized_delta_size(&prev, &cur));
+  auto p = loleseri::serialize_delta(r.begin(), r.end(), &prev, &cur);
+  EXPECT_EQ(r.end(), p);
+  return r;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Vec3> {
+  using list_type = std::tuple<float Vec3::*, float Vec3::*, float Vec3::*>;
+  static inline list_type list() {
+    return list_type{&Vec3::x, &Vec3::y, &Vec3::z};
+  }
+};
+
+template <> struct items<Body> {
+  using list_type =
+      std::tuple<std::uint32_t Body::*, Vec3 Body::*, Vec3 Body::*,
+                 std::int32_t(Body::*)[20],
+                 bool_group<Body, &Body::awake, &Body::grounded>>;
+  static inline list_type list() {
+    return list_type{&Body::tick, &Body::pos, &Body::vel, &Body::cells, {}};
+  }
+};
+
+template <> struct items<World> {
+  using list_type =
+      std::tuple<std::uint64_t World::*, std::array<Body, 3> World::*,
+                 std::string World::*, std::vector<std::uint32_t> World::*,
+                 compact_item<std::vector<std::int64_t>, World,
+                              compact_encoding::zigzag>>;
+  static inline list_type list() {
+    return list_type{&World::frame, &World::bodies, &World::name, &World::ids,
+                     zigzag(&World::scores)};
+  }
+};
+} // namespace loleseri
+
+TEST(Delta, Unchanged) {
+  auto const w = create_world();
+  auto const d = delta_bytes(w, w);
+  // 変更がなければマスクだけ
+  ASSERT_EQ(1, d.size());
+  ASSERT_EQ(0, d[0]);
+  auto r = w;
+  ASSERT_EQ(d.end(), loleseri::apply_delta(d.begin(), d.end(), &r));
+  ASSERT_EQ(w, r);
+}
+
+TEST(Delta, Nested) {
+  auto const prev = create_world();
+  auto cur = prev;
+  cur.bodies[1].pos.y = 7.0f;
+  cur.bodies[1].cells[19] = -1;
+  cur.bodies[2].grounded = true;
+  auto const d = delta_bytes(prev, cur);
+  // World のマスク 1 + bodies のマスク 1
+  // + bodies[1] のマスク 1 + pos ( マスク 1 + y 4 ) + cells ( マスク 3 + 4 )
+  // + bodies[2] のマスク 1 + bool_group 1
+  ASSERT_EQ(17, d.size());
+  ASSERT_EQ(0x02, d[0]);
+  ASSERT_EQ(0x06, d[1]);
+  ASSERT_EQ(0x0a, d[2]);
+  ASSERT_EQ(0x02, d[3]);
+
+  auto r = prev;
+  ASSERT_EQ(d.end(), loleseri::apply_delta(d.begin(), d.end(), &r));
+  ASSERT_EQ(cur, r);
+
+  std::deque<char> deq(d.begin(), d.end());
+  auto q = prev;
+  loleseri::apply_delta(deq.begin(), deq.end(), &q);
+  ASSERT_EQ(cur, q);
+}
+
+TEST(Delta, Variable) {
+  auto const prev = create_world();
+  auto cur = prev;
+  cur.frame = 1001;
+  cur.name = "arena2";
+  cur.scores.push_back(-100);
+  auto const d = delta_bytes(prev, cur);
+  // マスク 1 + frame 8 + name ( 4 + 6 ) + scores
+  ASSERT_EQ(0x15, d[0]);
+  ASSERT_EQ(1 + 8 + 10 + 4 + 1 + 3, d.size());
+
+  auto r = prev;
+  loleseri::apply_delta(d.begin(), d.end(), &r);
+  ASSERT_EQ(cur, r);
+
+  cur.ids.pop_back();
+  auto const d2 = delta_bytes(prev, cur);
+  ASSERT_EQ(0x1d, d2[0]);
+  r = prev;
+  loleseri::apply_delta(d2.begin(), d2.end(), &r);
+  ASSERT_EQ(cur, r);
+
+  ASSERT_THROW(loleseri::apply_delta(d2.begin(), d2.end() - 1, &r),
+               loleseri::buffer_overrun);
+  ASSERT_THROW(loleseri::apply_delta(d2.begin(), d2.begin(), &r),
+               loleseri::buffer_overrun);
+}
+
+TEST(Delta, ByteOrder) {
+  auto const prev = create_body(1);
+  auto cur = prev;
+  cur.tick = 0x01020304;
+  std::vector<std::uint8_t> d(5);
+  loleseri::serialize_delta<loleseri::byte_order::big>(d.begin(), d.end(),
+                                                       &prev, &cur);
+  ASSERT_EQ(0x01, d[0]);
+  ASSERT_EQ(0x01, d[1]);
+  ASSERT_EQ(0x04, d[4]);
+  auto r = prev;
+  loleseri::apply_delta<loleseri::byte_order::big>(d.cbegin(), d.cend(), &r);
+  ASSERT_EQ(cur, r);
+}
+
+TEST(Delta, Buffer) {
+  auto const prev = create_body(2);
+  auto cur = prev;
+  cur.vel.z = 9.0f;
+  cur.cells[3] = 0;
+  cur.cells[17] = 0;
+  cur.awake = false;
+
+  loleseri::serializer<Body>::buffer base;
+  loleseri::serialize(base.begin(), base.end(), &prev);
+  auto const d = delta_bytes(prev, cur);
+  // 元の値をデシリアライズせずにその場で書き換える
+  ASSERT_EQ(d.end(), loleseri::apply_delta<Body>(d.begin(), d.end(),
+                                                 base.begin(), base.end()));
+  loleseri::serializer<Body>::buffer expected;
+  loleseri::serialize(expected.begin(), expected.end(), &cur);
+  ASSERT_EQ(expected, base);
+
+  ASSERT_THROW(loleseri::apply_delta<Body>(d.begin(), d.end(), base.begin(),
+                                           base.end() - 1),
+               loleseri::buffer_overrun);
+  ASSERT_THROW(loleseri::apply_delta<Body>(d.begin(), d.end() - 1,
+                                           base.begin(), base.end()),
+               loleseri::buffer_overrun);
+}
+
+TEST(Delta, Float) {
+  auto const prev = create_body(3);
+  auto cur = prev;
+  cur.pos.x = -0.0f;
+  auto p = prev;
+  p.pos.x = 0.0f;
+  // 0.0 と -0.0 はバイト列が違うので変更とみなす
+  auto const d = delta_bytes(p, cur);
+  ASSERT_EQ(1 + 1 + 4, d.size());
+  auto const same = delta_bytes(cur, cur);
+  ASSERT_EQ(1, same.size());
+}
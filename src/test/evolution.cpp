@@ -0,0 +1,194 @@
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/evolution.hpp>
+#include <loleseri/loleseri.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+// version 0 のレイアウト
+struct RecordV0 {
+  std::uint16_t id;
+  std::int16_t level;
+  float ratio;
+};
+
+// version 1 のレイアウト ( level を広げて ratio を削除 )
+struct RecordV1 {
+  std::uint16_t id;
+  std::int32_t level;
+};
+
+// 現在のレイアウト ( version 2 )
+struct Record {
+  std::uint16_t id;
+  std::int32_t level;
+  std::string name;
+  bool active;
+};
+
+// version を上げたがレイアウトは変えていない
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+template <typename type> std::vector<std::uint8_t> bytes(type const &v) {
+  std::vector<std::uint8_t> r(loleseri::serializer<type>::serialized_size(&v));
+  loleseri::serialize(r.begin(), r.end(), &v);
+  return r;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<RecordV0> {
+  using list_type = std::tuple<std::uint16_t RecordV0::*,
+                               std::int16_t RecordV0::*, float RecordV0::*>;
+  static inline list_type list() {
+    return list_type{&RecordV0::id, &RecordV0::level, &RecordV0::ratio};
+  }
+};
+
+template <> struct items<RecordV1> {
+  using list_type =
+      std::tuple<std::uint16_t RecordV1::*, std::int32_t RecordV1::*>;
+  static inline list_type list() {
+    return list_type{&RecordV1::id, &RecordV1::level};
+  }
+};
+
+template <> struct items<Record> {
+  using list_type =
+      std::tuple<std::uint16_t Record::*, std::int32_t Record::*,
+                 std::string Record::*, bool Record::*>;
+  static inline list_type list() {
+    return list_type{&Record::id, &Record::level, &Record::name,
+                     &Record::active};
+  }
+};
+
+template <>
+struct schema_version<Record>
+    : public std::integral_constant<std::uint32_t, 2> {};
+
+template <> struct legacy_items<Record, 0> {
+  using list_type =
+      std::tuple<std::uint16_t Record::*,
+                 converted_item<std::int16_t, std::int32_t, Record>,
+                 skip<float>>;
+  static inline list_type list() {
+    return list_type{&Record::id, convert<std::int16_t>(&Record::level), {}};
+  }
+};
+
+template <> struct legacy_items<Record, 1> {
+  using list_type = std::tuple<std::uint16_t Record::*, std::int32_t Record::*>;
+  static inline list_type list() {
+    return list_type{&Record::id, &Record::level};
+  }
+};
+
+template <> struct items<Point> {
+  using list_type = std::tuple<std::int32_t Point::*, std::int32_t Point::*>;
+  static inline list_type list() { return list_type{&Point::x, &Point::y}; }
+};
+
+template <>
+struct schema_version<Point>
+    : public std::integral_constant<std::uint32_t, 1> {};
+} // namespace loleseri
+
+static_assert(!loleseri::is_current_layout<Record, 0>::value, "changed");
+static_assert(!loleseri::is_current_layout<Record, 1>::value, "changed");
+static_assert(loleseri::is_current_layout<Record, 2>::value, "current");
+static_assert(loleseri::is_current_layout<Point, 0>::value, "not changed");
+using legacy_record =
+    loleseri::legacy_deserializer<Record, 0, loleseri::byte_order::little>;
+static_assert(legacy_record::size == 8, "older layout of fixed size");
+
+TEST(Evolution, Version0) {
+  auto const buf = bytes(RecordV0{7, -300, 1.5f});
+  ASSERT_EQ(8, buf.size());
+  Record r{0, 0, "default", true};
+  ASSERT_EQ(buf.end(),
+            loleseri::deserialize_version(0, buf.begin(), buf.end(), &r));
+  ASSERT_EQ(7, r.id);
+  ASSERT_EQ(-300, r.level);
+  // 古いレイアウトにないメンバは元の値のまま
+  ASSERT_EQ("default", r.name);
+  ASSERT_TRUE(r.active);
+
+  std::deque<char> deq(buf.begin(), buf.end());
+  Record d{};
+  loleseri::deserialize_version(0, deq.begin(), deq.end(), &d);
+  ASSERT_EQ(-300, d.level);
+
+  ASSERT_THROW(
+      loleseri::deserialize_version(0, buf.begin(), buf.begin() + 7, &r),
+      loleseri::buffer_overrun);
+}
+
+TEST(Evolution, Version1) {
+  auto const buf = bytes(RecordV1{9, 100000});
+  Record r{};
+  r.name = "none";
+  ASSERT_EQ(buf.end(),
+            loleseri::deserialize_version(1, buf.begin(), buf.end(), &r));
+  ASSERT_EQ(9, r.id);
+  ASSERT_EQ(100000, r.level);
+  ASSERT_EQ("none", r.name);
+}
+
+TEST(Evolution, Versioned) {
+  Record const src{3, -1, "current", true};
+  std::vector<std::uint8_t> buf(
+      loleseri::versioned<Record, loleseri::byte_order::little>::
+          serialized_size(&src));
+  ASSERT_EQ(buf.end(),
+            loleseri::serialize_versioned(buf.begin(), buf.end(), &src));
+  ASSERT_EQ(2, buf[0]);
+  Record r{};
+  ASSERT_EQ(buf.end(),
+            loleseri::deserialize_versioned(buf.begin(), buf.end(), &r));
+  ASSERT_EQ(3, r.id);
+  ASSERT_EQ(-1, r.level);
+  ASSERT_EQ("current", r.name);
+  ASSERT_TRUE(r.active);
+
+  // version 0 のデータにヘッダを付ける
+  std::vector<std::uint8_t> old{0, 0, 0, 0};
+  auto const body = bytes(RecordV0{1, 2, 0.0f});
+  old.insert(old.end(), body.begin(), body.end());
+  loleseri::deserialize_versioned(old.begin(), old.end(), &r);
+  ASSERT_EQ(1, r.id);
+  ASSERT_EQ(2, r.level);
+  ASSERT_EQ("current", r.name);
+
+  old[0] = 3;
+  ASSERT_THROW(loleseri::deserialize_versioned(old.begin(), old.end(), &r),
+               loleseri::unknown_version);
+}
+
+TEST(Evolution, SameLayout) {
+  Point const src{-5, 6};
+  std::vector<std::uint8_t> buf(12);
+  loleseri::serialize_versioned<loleseri::byte_order::big>(buf.begin(),
+                                                           buf.end(), &src);
+  ASSERT_EQ(1, buf[3]);
+  Point r{};
+  loleseri::deserialize_versioned<loleseri::byte_order::big>(buf.cbegin(),
+                                                             buf.cend(), &r);
+  ASSERT_EQ(-5, r.x);
+  ASSERT_EQ(6, r.y);
+
+  // version 0 も同じレイアウトとして読む
+  Point q{};
+  loleseri::deserialize_version<loleseri::byte_order::big>(
+      0, buf.cbegin() + 4, buf.cend(), &q);
+  ASSERT_EQ(-5, q.x);
+  ASSERT_THROW(loleseri::deserialize_version<loleseri::byte_order::big>(
+                   0, buf.cbegin() + 5, buf.cend(), &q),
+               loleseri::buffer_overrun);
+}
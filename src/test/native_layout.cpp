@@ -0,0 +1,183 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/loleseri.hpp>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Packed {
+  float x;
+  std::int32_t y;
+  std::uint16_t z[2];
+};
+
+bool operator==(Packed const &a, Packed const &b) {
+  return a.x == b.x && a.y == b.y && a.z[0] == b.z[0] && a.z[1] == b.z[1];
+}
+
+// std::array のメンバを持つ構造体
+struct WithStdArray {
+  std::uint32_t a;
+  std::array<std::uint16_t, 4> b;
+};
+
+bool operator==(WithStdArray const &a, WithStdArray const &b) {
+  return a.a == b.a && a.b == b.b;
+}
+
+// 宣言順と異なる順でメンバを並べた構造体
+struct Reordered {
+  std::int32_t a;
+  std::int32_t b;
+};
+
+bool operator==(Reordered const &a, Reordered const &b) {
+  return a.a == b.a && a.b == b.b;
+}
+
+// パディングがある構造体
+struct Padded {
+  std::uint8_t a;
+  std::uint32_t b;
+};
+
+bool operator==(Padded const &a, Padded const &b) {
+  return a.a == b.a && a.b == b.b;
+}
+
+} // namespace
+
+namespace loleseri {
+
+template <> struct items<Packed> {
+  using list_type = std::tuple<float Packed::*, std::int32_t Packed::*,
+                               std::uint16_t(Packed::*)[2]>;
+  static inline list_type list() {
+    return {&Packed::x, &Packed::y, &Packed::z};
+  }
+};
+
+template <> struct items<WithStdArray> {
+  using list_type = std::tuple<std::uint32_t WithStdArray::*,
+                               std::array<std::uint16_t, 4> WithStdArray::*>;
+  static inline list_type list() {
+    return {&WithStdArray::a, &WithStdArray::b};
+  }
+};
+
+template <> struct items<Reordered> {
+  using list_type = std::tuple<std::int32_t Reordered::*, //
+                               std::int32_t Reordered::*>;
+  static inline list_type list() { return {&Reordered::b, &Reordered::a}; }
+};
+
+template <> struct items<Padded> {
+  using list_type = std::tuple<std::uint8_t Padded::*, std::uint32_t Padded::*>;
+  static inline list_type list() { return {&Padded::a, &Padded::b}; }
+};
+} // namespace loleseri
+
+TEST(NativeLayout, Candidate) {
+  static_assert(loleseri::native_layout<Packed>::candidate,
+                "Packed can be native");
+  static_assert(loleseri::native_layout<Reordered>::candidate,
+                "Reordered can be native ( checked at runtime )");
+  static_assert(!loleseri::native_layout<Padded>::candidate,
+                "Padded has padding");
+  Packed packed{};
+  Reordered reordered{};
+  ASSERT_TRUE(loleseri::native_layout<Packed>::matches(&packed));
+  ASSERT_FALSE(loleseri::native_layout<Reordered>::matches(&reordered));
+}
+
+TEST(NativeLayout, ContiguousIterator) {
+  static_assert(
+      loleseri::is_contiguous_byte_iterator<std::uint8_t *>::value, "");
+  static_assert(
+      loleseri::is_contiguous_byte_iterator<char const *>::value, "");
+  static_assert(loleseri::is_contiguous_byte_iterator<
+                    std::vector<std::uint8_t>::iterator>::value,
+                "");
+  static_assert(!loleseri::is_contiguous_byte_iterator<
+                    std::deque<std::uint8_t>::iterator>::value,
+                "");
+  static_assert(!loleseri::is_contiguous_byte_iterator<std::uint32_t *>::value,
+                "");
+  static_assert(!loleseri::is_contiguous_byte_iterator<
+                    std::back_insert_iterator<std::vector<char>>>::value,
+                "");
+}
+
+TEST(NativeLayout, Packed) {
+  Packed value = {1.25f, -123456, {0xa1b2, 0xc3d4}};
+  constexpr size_t size = loleseri::serialized_size<Packed>();
+  static_assert(size == 12, "size must be 12");
+
+  std::vector<std::uint8_t> fast(size);
+  auto last = loleseri::serialize(fast.begin(), fast.end(), &value);
+  ASSERT_EQ(fast.end(), last);
+
+  std::deque<std::uint8_t> slow(size);
+  loleseri::serialize(slow.begin(), slow.end(), &value);
+  ASSERT_TRUE(std::equal(fast.begin(), fast.end(), slow.begin()));
+
+  ASSERT_EQ(0xb2, fast[8]);
+  ASSERT_EQ(0xa1, fast[9]);
+
+  Packed v0;
+  auto p = loleseri::deserialize(fast.data(), fast.data() + size, &v0);
+  ASSERT_EQ(fast.data() + size, p);
+  ASSERT_EQ(value, v0);
+  auto v1 = loleseri::deserialize<Packed>(slow.cbegin(), slow.cend());
+  ASSERT_EQ(value, v1);
+}
+
+TEST(NativeLayout, WithStdArray) {
+  static_assert(loleseri::native_layout<WithStdArray>::candidate,
+                "WithStdArray can be native");
+  WithStdArray const value = {0x11223344, {{0xa1b2, 0xc3d4, 0xe5f6, 0x0718}}};
+  ASSERT_TRUE(loleseri::native_layout<WithStdArray>::matches(&value));
+  constexpr size_t size = loleseri::serialized_size<WithStdArray>();
+  static_assert(size == 12, "size must be 12");
+
+  std::vector<std::uint8_t> fast(size);
+  auto last = loleseri::serialize(fast.begin(), fast.end(), &value);
+  ASSERT_EQ(fast.end(), last);
+
+  std::deque<std::uint8_t> slow(size);
+  loleseri::serialize(slow.begin(), slow.end(), &value);
+  ASSERT_TRUE(std::equal(fast.begin(), fast.end(), slow.begin()));
+  ASSERT_EQ(0x44, fast[0]);
+  ASSERT_EQ(0xb2, fast[4]);
+  ASSERT_EQ(0x07, fast[11]);
+
+  auto v0 = loleseri::deserialize<WithStdArray>(fast.data(), //
+                                                fast.data() + size);
+  ASSERT_EQ(value, v0);
+  auto v1 = loleseri::deserialize<WithStdArray>(slow.cbegin(), slow.cend());
+  ASSERT_EQ(value, v1);
+}
+
+TEST(NativeLayout, Reordered) {
+  Reordered value = {0x11223344, 0x55667788};
+  std::array<std::uint8_t, 8> buffer;
+  loleseri::serialize(buffer.data(), buffer.data() + 8, &value);
+  ASSERT_EQ(0x88, buffer[0]);
+  ASSERT_EQ(0x44, buffer[4]);
+  auto restored = loleseri::deserialize<Reordered>(buffer.data(), //
+                                                   buffer.data() + 8);
+  ASSERT_EQ(value, restored);
+}
+
+TEST(NativeLayout, Padded) {
+  Padded value = {0x12, 0x3456789a};
+  std::array<std::uint8_t, 5> buffer;
+  loleseri::serialize(buffer.data(), buffer.data() + 5, &value);
+  ASSERT_EQ(0x12, buffer[0]);
+  ASSERT_EQ(0x9a, buffer[1]);
+  ASSERT_EQ(0x34, buffer[4]);
+  auto restored =
+      loleseri::deserialize<Padded>(buffer.data(), buffer.data() + 5);
+  ASSERT_EQ(value, restored);
+}
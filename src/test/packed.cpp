@@ -0,0 +1,215 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/packed.hpp>
+#include <loleseri/view.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Status {
+  std::uint16_t id;
+  bool ready;
+  bool busy;
+  bool failed;
+  bool flags[64];
+  std::array<bool, 21> lamps;
+};
+
+bool operator==(Status const &a, Status const &b) {
+  return a.id == b.id && a.ready == b.ready && a.busy == b.busy &&
+         a.failed == b.failed && std::equal(a.flags, a.flags + 64, b.flags) &&
+         a.lamps == b.lamps;
+}
+
+Status create() {
+  Status r{};
+  r.id = 0x1234;
+  r.ready = true;
+  r.busy = false;
+  r.failed = true;
+  for (size_t i = 0; i < 64; ++i) {
+    r.flags[i] = i % 3 == 0;
+  }
+  for (size_t i = 0; i < r.lamps.size(); ++i) {
+    r.lamps[i] = i % 5 == 1;
+  }
+  return r;
+}
+
+struct Flags {
+  std::uint8_t kind;
+  bool ready;
+  bool busy;
+  bool failed;
+  std::uint32_t count;
+  bool lamp;
+};
+
+bool operator==(Flags const &a, Flags const &b) {
+  return a.kind == b.kind && a.ready == b.ready && a.busy == b.busy &&
+         a.failed == b.failed && a.count == b.count && a.lamp == b.lamp;
+}
+
+struct Report {
+  std::string name;
+  Flags flags;
+};
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Flags> {
+  using list_type =
+      std::tuple<std::uint8_t Flags::*, bool Flags::*, bool Flags::*,
+                 bool Flags::*, std::uint32_t Flags::*, bool Flags::*>;
+  static inline list_type list() {
+    return list_type{&Flags::kind,   &Flags::ready, &Flags::busy,
+                     &Flags::failed, &Flags::count, &Flags::lamp};
+  }
+};
+
+template <> struct items<Report> {
+  using list_type =
+      std::tuple<std::string Report::*, packed_item<Flags, Report>>;
+  static inline list_type list() {
+    return list_type{&Report::name, packed(&Report::flags)};
+  }
+};
+
+template <> struct items<Status> {
+  using list_type =
+      std::tuple<std::uint16_t Status::*,
+                 bool_group<Status, &Status::ready, &Status::busy,
+                            &Status::failed>,
+                 packed_item<bool[64], Status>,
+                 packed_item<std::array<bool, 21>, Status>>;
+  static inline list_type list() {
+    return list_type{&Status::id, {}, packed(&Status::flags),
+                     packed(&Status::lamps)};
+  }
+};
+} // namespace loleseri
+
+TEST(Packed, Size) {
+  // 2 + 1 ( ready, busy, failed ) + 8 ( flags ) + 3 ( lamps )
+  ASSERT_EQ(14, loleseri::serialized_size<Status>());
+  ASSERT_TRUE(loleseri::is_fixed_size<Status>::value);
+  ASSERT_EQ(14, loleseri::serializer<Status>::buffer().size());
+}
+
+TEST(Packed, Bits) {
+  auto const status = create();
+  loleseri::serializer<Status>::buffer buf;
+  ASSERT_EQ(buf.end(), loleseri::serialize(buf.begin(), buf.end(), &status));
+  ASSERT_EQ(0x34, buf[0]);
+  ASSERT_EQ(0x05, buf[2]);
+  // flags は 0, 3, 6, ... 番目が true
+  ASSERT_EQ(0x49, buf[3]);
+  ASSERT_EQ(0x92, buf[4]);
+  ASSERT_EQ(0x24, buf[5]);
+  // lamps は 1, 6, 11, 16 番目が true
+  ASSERT_EQ(0x42, buf[11]);
+  ASSERT_EQ(0x08, buf[12]);
+  ASSERT_EQ(0x01, buf[13]);
+
+  ASSERT_EQ(status, loleseri::deserialize<Status>(buf.begin(), buf.end()));
+}
+
+TEST(Packed, View) {
+  auto const status = create();
+  loleseri::serializer<Status>::buffer buf;
+  loleseri::serialize(buf.begin(), buf.end(), &status);
+  auto v = loleseri::make_view<Status>(buf.cbegin(), buf.cend());
+  ASSERT_EQ(0x1234, v.get<0>());
+  // 独自の符号化を持つ項目は view で読めない ( at<2>() は static_assert )
+  using view_type = decltype(v);
+  static_assert(view_type::plain_item<0>::value, "id is plain");
+  static_assert(!view_type::plain_item<2>::value, "flags are packed");
+  static_assert(!loleseri::all_have_plain_codec<
+                    loleseri::item_list_type<Status>>::value,
+                "Status has packed items");
+}
+
+TEST(Packed, Iterators) {
+  auto status = create();
+  status.flags[63] = true;
+  status.lamps[20] = true;
+  std::vector<std::uint8_t> out;
+  loleseri::serialize(std::back_inserter(out), std::back_inserter(out),
+                      &status);
+  ASSERT_EQ(14, out.size());
+  ASSERT_EQ(0x11, out[13]);
+
+  std::deque<char> deq(out.begin(), out.end());
+  ASSERT_EQ(status, loleseri::deserialize<Status>(deq.begin(), deq.end()));
+
+  // 未使用のビットは無視する
+  out[13] = static_cast<std::uint8_t>(out[13] | 0xe0);
+  ASSERT_EQ(status, loleseri::deserialize<Status>(out.begin(), out.end()));
+}
+
+TEST(Packed, Kernels) {
+  for (size_t count : {1, 7, 8, 9, 15, 16, 17, 31, 33, 100}) {
+    std::vector<std::uint8_t> src(count);
+    for (size_t i = 0; i < count; ++i) {
+      src[i] = (i * 7 + count) % 3 == 0;
+    }
+    bool bools[100];
+    std::copy(src.begin(), src.end(), bools);
+    std::vector<std::uint8_t> bits((count + 7) / 8, 0xff);
+    loleseri::pack_bools(bools, count, bits.data());
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(src[i], (bits[i / 8] >> (i % 8)) & 1) << count << " " << i;
+    }
+    if (count % 8 != 0) {
+      ASSERT_EQ(0, bits.back() >> (count % 8));
+    }
+    bool restored[100];
+    loleseri::unpack_bools(bits.data(), count, restored);
+    ASSERT_TRUE(std::equal(bools, bools + count, restored));
+  }
+}
+
+TEST(Packed, BoolMembers) {
+  // 連続する bool のメンバは型から見つけてまとめる
+  using seri = loleseri::serializer<loleseri::packed_bools<Flags>>;
+  using deseri = loleseri::deserializer<loleseri::packed_bools<Flags>>;
+  // 1 + 1 ( ready, busy, failed ) + 4 + 1 ( lamp )
+  ASSERT_EQ(7, seri::size);
+  ASSERT_EQ(9, loleseri::serialized_size<Flags>());
+  Flags const flags = {3, true, false, true, 0x12345678, true};
+  seri::buffer buf;
+  ASSERT_EQ(buf.end(), seri::serialize(buf.begin(), buf.end(), &flags));
+  ASSERT_EQ(3, buf[0]);
+  ASSERT_EQ(0x05, buf[1]);
+  ASSERT_EQ(0x78, buf[2]);
+  ASSERT_EQ(0x01, buf[6]);
+  Flags restored{};
+  ASSERT_EQ(buf.end(), deseri::deserialize(buf.begin(), buf.end(), &restored));
+  ASSERT_EQ(flags, restored);
+
+  std::deque<char> deq(buf.begin(), buf.end());
+  restored = Flags{};
+  deseri::deserialize(deq.begin(), deq.end(), &restored);
+  ASSERT_EQ(flags, restored);
+}
+
+TEST(Packed, StructMember) {
+  Report const report = {"report", {3, false, true, true, 7, false}};
+  ASSERT_FALSE(loleseri::is_fixed_size<Report>::value);
+  std::vector<std::uint8_t> buf(loleseri::serialized_size(report));
+  ASSERT_EQ(4 + 6 + 7, buf.size());
+  loleseri::serialize(buf.begin(), buf.end(), &report);
+  ASSERT_EQ(0x06, buf[11]);
+  auto restored = loleseri::deserialize<Report>(buf.cbegin(), buf.cend());
+  ASSERT_EQ(report.name, restored.name);
+  ASSERT_EQ(report.flags, restored.flags);
+  for (size_t i = 0; i < buf.size(); ++i) {
+    ASSERT_THROW(
+        loleseri::deserialize<Report>(buf.cbegin(), buf.cbegin() + i),
+        loleseri::buffer_overrun);
+  }
+}
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/parallel.hpp>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint32_t id;
+  double value;
+  std::int16_t pos[3];
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.id == b.id && a.value == b.value && a.pos[0] == b.pos[0] &&
+         a.pos[1] == b.pos[1] && a.pos[2] == b.pos[2];
+}
+
+std::vector<Foo> make_foos(size_t count) {
+  std::vector<Foo> foos(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto v = static_cast<std::int16_t>(i % 1000);
+    foos[i] = {static_cast<std::uint32_t>(i), static_cast<double>(i) * 0.5,
+               {v, static_cast<std::int16_t>(-v), 7}};
+  }
+  return foos;
+}
+
+/** 実行したタスクの数を数えるエグゼキュータ */
+struct counting_executor {
+  size_t tasks;
+  std::atomic<size_t> *count;
+  size_t task_count(size_t) const { return tasks; }
+  template <typename task_t> void run(size_t n, task_t const &task) const {
+    for (size_t i = 0; i < n; ++i) {
+      ++*count;
+      task(i);
+    }
+  }
+};
+
+/** limit 回目以降の生成で std::system_error を投げるスレッド */
+class limited_thread {
+public:
+  template <typename function_t>
+  limited_thread(function_t const &f, size_t ix) {
+    if (limit <= started) {
+      throw std::system_error(
+          std::make_error_code(std::errc::resource_unavailable_try_again));
+    }
+    ++started;
+    thread_ = std::thread(f, ix);
+  }
+  void join() { thread_.join(); }
+
+  static size_t limit;
+  static size_t started;
+
+private:
+  std::thread thread_;
+};
+
+size_t limited_thread::limit = 0;
+size_t limited_thread::started = 0;
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint32_t Foo::*, double Foo::*,
+                               std::int16_t(Foo::*)[3]>;
+  static inline list_type list() { return {&Foo::id, &Foo::value, &Foo::pos}; }
+};
+} // namespace loleseri
+
+TEST(Parallel, SameAsSequential) {
+  using seri = loleseri::serializer<Foo>;
+  size_t const count = 10007;
+  auto foos = make_foos(count);
+  std::vector<std::uint8_t> expected(seri::size * count);
+  auto p = expected.data();
+  for (auto const &foo : foos) {
+    p = loleseri::serialize(p, expected.data() + expected.size(), &foo);
+  }
+
+  // 小さな粒度を指定して、確実に複数のスレッドに分割させる
+  loleseri::thread_executor executor(4, 1024);
+  ASSERT_EQ(4, executor.task_count(seri::size * count));
+  std::vector<std::uint8_t> buffer(expected.size());
+  auto last = loleseri::serialize_n(buffer.begin(), buffer.end(), foos.data(),
+                                    count, executor);
+  ASSERT_EQ(buffer.end(), last);
+  ASSERT_EQ(expected, buffer);
+
+  std::vector<Foo> restored(count);
+  auto rlast = loleseri::deserialize_n(buffer.cbegin(), buffer.cend(),
+                                       restored.data(), count, executor);
+  ASSERT_EQ(buffer.cend(), rlast);
+  ASSERT_EQ(foos, restored);
+}
+
+TEST(Parallel, DefaultExecutor) {
+  auto foos = make_foos(100);
+  std::deque<std::uint8_t> buffer(loleseri::serializer<Foo>::size * 100);
+  loleseri::serialize_n<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                   foos.data(), foos.size());
+  ASSERT_EQ(0, buffer[0]);
+  ASSERT_EQ(1, buffer[loleseri::serializer<Foo>::size + 3]);
+  std::vector<Foo> restored(100);
+  loleseri::deserialize_n<loleseri::byte_order::big>(
+      buffer.begin(), buffer.end(), restored.data(), restored.size(),
+      loleseri::sequential_executor());
+  ASSERT_EQ(foos, restored);
+}
+
+TEST(Parallel, Executor) {
+  auto foos = make_foos(10);
+  std::vector<std::uint8_t> buffer(loleseri::serializer<Foo>::size * 10);
+  std::atomic<size_t> count(0);
+
+  // 要素数より多くのタスクには分割しない
+  loleseri::serialize_n(buffer.begin(), buffer.end(), foos.data(), 10,
+                        counting_executor{100, &count});
+  ASSERT_EQ(10, count);
+
+  // 1 タスクならエグゼキュータを使わない
+  count = 0;
+  std::vector<Foo> restored(10);
+  loleseri::deserialize_n(buffer.cbegin(), buffer.cend(), restored.data(), 10,
+                          counting_executor{1, &count});
+  ASSERT_EQ(0, count);
+  ASSERT_EQ(foos, restored);
+}
+
+TEST(Parallel, Error) {
+  auto foos = make_foos(10);
+  std::vector<std::uint8_t> buffer(loleseri::serializer<Foo>::size * 10 - 1);
+  ASSERT_THROW(loleseri::serialize_n(buffer.begin(), buffer.end(),
+                                     foos.data(), 10),
+               loleseri::buffer_overrun);
+
+  loleseri::thread_executor executor(3, 1);
+  ASSERT_THROW(executor.run(3,
+                            [](size_t ix) {
+                              if (ix == 2) {
+                                throw std::runtime_error("task failed");
+                              }
+                            }),
+               std::runtime_error);
+}
+
+TEST(Parallel, ThreadError) {
+  // スレッドを作れなくても、作れたスレッドを join して残りのタスクを実行する
+  limited_thread::limit = 2;
+  limited_thread::started = 0;
+  loleseri::basic_thread_executor<limited_thread> executor(6, 1);
+  std::vector<std::atomic<int>> done(6);
+  executor.run(6, [&done](size_t ix) { ++done[ix]; });
+  ASSERT_EQ(2, limited_thread::started);
+  for (auto const &d : done) {
+    ASSERT_EQ(1, d.load());
+  }
+
+  limited_thread::limit = 0;
+  limited_thread::started = 0;
+  ASSERT_THROW(executor.run(3,
+                            [](size_t ix) {
+                              if (ix == 2) {
+                                throw std::runtime_error("task failed");
+                              }
+                            }),
+               std::runtime_error);
+  ASSERT_EQ(0, limited_thread::started);
+}
@@ -0,0 +1,142 @@
+#include <array>
+#include <gtest/gtest.h>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/patch.hpp>
+#include <tuple>
+#include <vector>
+
+namespace {
+using loleseri::field;
+
+struct Level {
+  std::int64_t price;
+  std::uint32_t qty;
+};
+
+// 板のスナップショット
+struct Book {
+  std::uint32_t seq;
+  std::array<Level, 4> bids;
+  Level asks[4];
+  std::uint16_t flags[3];
+  std::uint64_t stamp;
+  std::uint32_t unlisted;
+};
+
+Book create_book() {
+  Book r{};
+  r.seq = 1;
+  for (int i = 0; i < 4; ++i) {
+    r.bids[i] = Level{1000 - i, static_cast<std::uint32_t>(i + 1)};
+    r.asks[i] = Level{1001 + i, static_cast<std::uint32_t>(i + 10)};
+  }
+  r.flags[0] = 1;
+  r.stamp = 0x0102030405060708u;
+  return r;
+}
+
+template <typename type>
+typename loleseri::serializer<type>::buffer bytes(type const &v) {
+  typename loleseri::serializer<type>::buffer r;
+  loleseri::serialize(r.begin(), r.end(), &v);
+  return r;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Level> {
+  using list_type = std::tuple<std::int64_t Level::*, std::uint32_t Level::*>;
+  static inline list_type list() {
+    return list_type{&Level::price, &Level::qty};
+  }
+};
+
+template <> struct items<Book> {
+  using list_type =
+      std::tuple<std::uint32_t Book::*, std::array<Level, 4> Book::*,
+                 Level(Book::*)[4], std::uint16_t(Book::*)[3],
+                 std::uint64_t Book::*>;
+  static inline list_type list() {
+    return list_type{&Book::seq, &Book::bids, &Book::asks, &Book::flags,
+                     &Book::stamp};
+  }
+};
+} // namespace loleseri
+
+TEST(Patch, Field) {
+  auto src = create_book();
+  auto buf = bytes(src);
+  auto p = loleseri::patch<Book, field<1, 2, 1>>(buf.begin(), buf.end(), 77);
+  ASSERT_EQ(buf.begin() + 4 + 12 * 2 + 8 + 4, p);
+  loleseri::patch<Book, field<4>>(buf.begin(), buf.end(), 99);
+  loleseri::patch<Book, field<2, 3>>(buf.begin(), buf.end(), Level{5, 6});
+  src.bids[2].qty = 77;
+  src.stamp = 99;
+  src.asks[3] = Level{5, 6};
+  // 全体をシリアライズし直したものと一致する
+  ASSERT_EQ(bytes(src), buf);
+
+  ASSERT_THROW((loleseri::patch<Book, field<4>>(buf.begin(), buf.end() - 1, 0)),
+               loleseri::buffer_overrun);
+}
+
+TEST(Patch, MemberPointer) {
+  auto src = create_book();
+  auto buf = bytes(src);
+  loleseri::patch<Book>(buf.begin(), buf.end(), &Book::seq, 2);
+  loleseri::patch<Book>(buf.begin(), buf.end(), &Book::bids, 1, &Level::price,
+                        -5);
+  loleseri::patch<Book>(buf.begin(), buf.end(), &Book::asks, 0u, Level{7, 8});
+  loleseri::patch<Book>(buf.begin(), buf.end(), &Book::flags, 2, 0xabcd);
+  src.seq = 2;
+  src.bids[1].price = -5;
+  src.asks[0] = Level{7, 8};
+  src.flags[2] = 0xabcd;
+  ASSERT_EQ(bytes(src), buf);
+
+  Book r{};
+  loleseri::deserialize(buf.begin(), buf.end(), &r);
+  ASSERT_EQ(-5, r.bids[1].price);
+  ASSERT_EQ(0xabcd, r.flags[2]);
+}
+
+TEST(Patch, InvalidPath) {
+  auto const src = create_book();
+  auto buf = bytes(src);
+  auto const before = buf;
+  // items にないメンバ
+  ASSERT_THROW(
+      loleseri::patch<Book>(buf.begin(), buf.end(), &Book::unlisted, 1),
+      loleseri::invalid_path);
+  ASSERT_THROW(
+      loleseri::patch<Book>(buf.begin(), buf.end(), &Book::flags, 3, 1),
+      loleseri::invalid_path);
+  ASSERT_THROW(
+      loleseri::patch<Book>(buf.begin(), buf.end(), &Book::flags, -1, 1),
+      loleseri::invalid_path);
+  ASSERT_EQ(before, buf);
+}
+
+TEST(Patch, ByteOrder) {
+  auto src = create_book();
+  loleseri::serializer<Book>::buffer buf;
+  loleseri::serialize<loleseri::byte_order::big>(buf.begin(), buf.end(), &src);
+  loleseri::patch<loleseri::byte_order::big, Book>(buf.begin(), buf.end(),
+                                                   &Book::seq, 0x01020304);
+  ASSERT_EQ(0x01, buf[0]);
+  ASSERT_EQ(0x04, buf[3]);
+  loleseri::patch<loleseri::byte_order::big, Book, field<4>>(
+      buf.begin(), buf.end(), 0x1122);
+  src.seq = 0x01020304;
+  src.stamp = 0x1122;
+  loleseri::serializer<Book>::buffer expected;
+  loleseri::serialize<loleseri::byte_order::big>(expected.begin(),
+                                                 expected.end(), &src);
+  ASSERT_EQ(expected, buf);
+
+  std::vector<char> vec(buf.begin(), buf.end());
+  loleseri::patch<loleseri::byte_order::big, Book>(
+      vec.begin(), vec.end(), &Book::bids, 3, &Level::qty, 0x55);
+  ASSERT_EQ(0x55, vec[4 + 12 * 3 + 8 + 3]);
+}
@@ -0,0 +1,223 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/compact.hpp>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/projection.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+using loleseri::field;
+
+struct Pos {
+  float x;
+  float y;
+};
+
+// 固定長
+struct Flat {
+  std::uint8_t kind;
+  std::int32_t values[8];
+  Pos pos;
+  std::uint64_t stamp;
+};
+
+struct Inner {
+  std::int16_t a;
+  std::string label;
+  std::uint32_t b;
+};
+
+// 可変長
+struct Row {
+  std::uint32_t id;
+  Pos pos;
+  std::array<Pos, 4> path;
+  std::vector<std::int32_t> samples;
+  Inner inner;
+  std::string tag;
+  double score;
+  std::array<Inner, 2> inners;
+  std::uint64_t count;
+  std::int64_t last;
+};
+
+Flat create_flat() {
+  Flat r{};
+  r.kind = 3;
+  for (int i = 0; i < 8; ++i) {
+    r.values[i] = i * 11 - 30;
+  }
+  r.pos = Pos{1.5f, -2.5f};
+  r.stamp = 0x0102030405060708u;
+  return r;
+}
+
+Row create_row() {
+  Row r{};
+  r.id = 42;
+  r.pos = Pos{0.25f, 0.5f};
+  for (size_t i = 0; i < 4; ++i) {
+    r.path[i] = Pos{static_cast<float>(i), -static_cast<float>(i)};
+  }
+  r.samples = {1, -2, 3, -4, 5};
+  r.inner = Inner{-7, "inner", 70000};
+  r.tag = "tag";
+  r.score = 98.5;
+  r.inners[0] = Inner{1, "zero", 10};
+  r.inners[1] = Inner{2, "one", 20};
+  r.count = 300;
+  r.last = -123456789;
+  return r;
+}
+
+template <typename type> std::vector<std::uint8_t> bytes(type const &v) {
+  std::vector<std::uint8_t> r(loleseri::serializer<type>::serialized_size(&v));
+  loleseri::serialize(r.begin(), r.end(), &v);
+  return r;
+}
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Pos> {
+  using list_type = std::tuple<float Pos::*, float Pos::*>;
+  static inline list_type list() { return list_type{&Pos::x, &Pos::y}; }
+};
+
+template <> struct items<Flat> {
+  using list_type = std::tuple<std::uint8_t Flat::*, std::int32_t(Flat::*)[8],
+                               Pos Flat::*, std::uint64_t Flat::*>;
+  static inline list_type list() {
+    return list_type{&Flat::kind, &Flat::values, &Flat::pos, &Flat::stamp};
+  }
+};
+
+template <> struct items<Inner> {
+  using list_type = std::tuple<std::int16_t Inner::*, std::string Inner::*,
+                               std::uint32_t Inner::*>;
+  static inline list_type list() {
+    return list_type{&Inner::a, &Inner::label, &Inner::b};
+  }
+};
+
+template <> struct items<Row> {
+  using list_type =
+      std::tuple<std::uint32_t Row::*, Pos Row::*, std::array<Pos, 4> Row::*,
+                 std::vector<std::int32_t> Row::*, Inner Row::*,
+                 std::string Row::*, double Row::*,
+                 std::array<Inner, 2> Row::*,
+                 compact_item<std::uint64_t, Row, compact_encoding::varint>,
+                 std::int64_t Row::*>;
+  static inline list_type list() {
+    return list_type{&Row::id,     &Row::pos,    &Row::path,
+                     &Row::samples, &Row::inner, &Row::tag,
+                     &Row::score,  &Row::inners, varint(&Row::count),
+                     &Row::last};
+  }
+};
+} // namespace loleseri
+
+TEST(Projection, Fixed) {
+  auto const src = create_flat();
+  auto const buf = bytes(src);
+  Flat r{};
+  r.values[0] = 99;
+  ASSERT_EQ(buf.end(), (loleseri::deserialize_fields<Flat, 0, 3>(
+                           buf.begin(), buf.end(), &r)));
+  ASSERT_EQ(3, r.kind);
+  ASSERT_EQ(src.stamp, r.stamp);
+  // 選ばれていないメンバは元の値のまま
+  ASSERT_EQ(99, r.values[0]);
+  ASSERT_EQ(0.0f, r.pos.x);
+
+  Flat n{};
+  ASSERT_EQ(buf.end(),
+            (loleseri::deserialize_fields<Flat, field<1, 5>, field<2, 1>>(
+                buf.begin(), buf.end(), &n)));
+  ASSERT_EQ(src.values[5], n.values[5]);
+  ASSERT_EQ(0, n.values[4]);
+  ASSERT_EQ(src.pos.y, n.pos.y);
+  ASSERT_EQ(0.0f, n.pos.x);
+
+  ASSERT_THROW((loleseri::deserialize_fields<Flat, 3>(
+                   buf.begin(), buf.end() - 1, &r)),
+               loleseri::buffer_overrun);
+}
+
+TEST(Projection, Variable) {
+  auto const src = create_row();
+  auto const buf = bytes(src);
+  Row r{};
+  ASSERT_EQ(buf.end(), (loleseri::deserialize_fields<Row, 0, 6, 9>(
+                           buf.begin(), buf.end(), &r)));
+  ASSERT_EQ(42, r.id);
+  ASSERT_EQ(98.5, r.score);
+  ASSERT_EQ(src.last, r.last);
+  ASSERT_TRUE(r.samples.empty());
+  ASSERT_TRUE(r.tag.empty());
+  ASSERT_EQ(0, r.count);
+
+  Row n{};
+  auto const p = loleseri::deserialize_fields<
+      Row, field<2, 3, 0>, field<4, 2>, field<7, 1, 1>, field<8>>(
+      buf.begin(), buf.end(), &n);
+  ASSERT_EQ(buf.end(), p);
+  ASSERT_EQ(3.0f, n.path[3].x);
+  ASSERT_EQ(0.0f, n.path[3].y);
+  ASSERT_EQ(70000, n.inner.b);
+  ASSERT_TRUE(n.inner.label.empty());
+  ASSERT_EQ("one", n.inners[1].label);
+  ASSERT_EQ(0, n.inners[1].b);
+  ASSERT_TRUE(n.inners[0].label.empty());
+  ASSERT_EQ(300, n.count);
+
+  // 同じ項目へのパスと項目全体を同時に指定できる
+  Row w{};
+  loleseri::deserialize_fields<Row, field<4>, field<4, 1>>(buf.begin(),
+                                                          buf.end(), &w);
+  ASSERT_EQ("inner", w.inner.label);
+  ASSERT_EQ(-7, w.inner.a);
+}
+
+TEST(Projection, Iterators) {
+  auto const src = create_row();
+  auto const buf = bytes(src);
+  std::deque<char> deq(buf.begin(), buf.end());
+  Row r{};
+  ASSERT_EQ(deq.end(), (loleseri::deserialize_fields<Row, 5, 9>(
+                           deq.begin(), deq.end(), &r)));
+  ASSERT_EQ("tag", r.tag);
+  ASSERT_EQ(src.last, r.last);
+
+  // 2 件続けて読む
+  std::vector<std::uint8_t> two(buf);
+  two.insert(two.end(), buf.begin(), buf.end());
+  auto p = loleseri::deserialize_fields<Row, 0>(two.cbegin(), two.cend(), &r);
+  ASSERT_EQ(two.cbegin() + static_cast<std::ptrdiff_t>(buf.size()), p);
+  ASSERT_EQ(two.cend(),
+            (loleseri::deserialize_fields<Row, 0>(p, two.cend(), &r)));
+
+  for (size_t len : {3, 20, 60, 100}) {
+    ASSERT_THROW((loleseri::deserialize_fields<Row, 9>(
+                     buf.begin(),
+                     buf.begin() + static_cast<std::ptrdiff_t>(len), &r)),
+                 loleseri::buffer_overrun)
+        << len;
+  }
+}
+
+TEST(Projection, ByteOrder) {
+  auto const src = create_flat();
+  loleseri::serializer<Flat>::buffer buf;
+  loleseri::serialize<loleseri::byte_order::big>(buf.begin(), buf.end(), &src);
+  Flat r{};
+  loleseri::deserialize_fields<loleseri::byte_order::big, Flat, 3>(
+      buf.cbegin(), buf.cend(), &r);
+  ASSERT_EQ(src.stamp, r.stamp);
+  loleseri::deserialize_fields<loleseri::byte_order::big, Flat, field<1, 7>>(
+      buf.cbegin(), buf.cend(), &r);
+  ASSERT_EQ(src.values[7], r.values[7]);
+}
@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <loleseri/record_file.hpp>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint32_t id;
+  double value;
+  std::int16_t pos[2];
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.id == b.id && a.value == b.value && a.pos[0] == b.pos[0] &&
+         a.pos[1] == b.pos[1];
+}
+
+Foo make_foo(size_t i) {
+  auto v = static_cast<std::int16_t>(i % 1000);
+  return {static_cast<std::uint32_t>(i), static_cast<double>(i) * 0.25,
+          {v, static_cast<std::int16_t>(-v)}};
+}
+
+/** テスト用の一時ファイル。デストラクタで削除する。 */
+struct temp_file {
+  std::string path;
+  explicit temp_file(char const *name) : path(testing::TempDir() + name) {
+    std::remove(path.c_str());
+  }
+  ~temp_file() { std::remove(path.c_str()); }
+};
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Foo> {
+  using list_type =
+      std::tuple<std::uint32_t Foo::*, double Foo::*, std::int16_t(Foo::*)[2]>;
+  static inline list_type list() { return {&Foo::id, &Foo::value, &Foo::pos}; }
+};
+} // namespace loleseri
+
+TEST(RecordFile, WriteAndRead) {
+  temp_file file("loleseri_record_file_test.bin");
+  {
+    loleseri::record_file_writer<Foo> writer(file.path);
+    ASSERT_EQ(0, writer.size());
+    for (size_t i = 0; i < 100; ++i) {
+      writer.append(make_foo(i));
+    }
+    ASSERT_EQ(100, writer.size());
+  }
+  {
+    // 既存のファイルには追記する
+    loleseri::record_file_writer<Foo> writer(file.path);
+    ASSERT_EQ(100, writer.size());
+    std::vector<Foo> foos;
+    for (size_t i = 100; i < 1000; ++i) {
+      foos.push_back(make_foo(i));
+    }
+    writer.append(foos.data(), foos.size());
+    writer.close();
+  }
+
+  loleseri::record_file<Foo> records(file.path);
+  ASSERT_EQ(1000, records.size());
+  ASSERT_EQ(make_foo(0), records[0]);
+  ASSERT_EQ(make_foo(567), records[567]);
+  ASSERT_EQ(make_foo(999), records.at(999));
+  ASSERT_THROW(records.at(1000), std::out_of_range);
+  size_t i = 0;
+  for (auto const &foo : records) {
+    ASSERT_EQ(make_foo(i), foo);
+    ++i;
+  }
+  ASSERT_EQ(1000, i);
+
+  // ヘッダ 16 バイトの後ろにレコードが並ぶ
+  std::FILE *fp = std::fopen(file.path.c_str(), "rb");
+  ASSERT_NE(nullptr, fp);
+  std::fseek(fp, 0, SEEK_END);
+  ASSERT_EQ(16 + 1000 * 16, std::ftell(fp));
+  std::fclose(fp);
+}
+
+TEST(RecordFile, Errors) {
+  ASSERT_THROW(loleseri::record_file<Foo>(testing::TempDir() +
+                                          "loleseri_no_such_file.bin"),
+               std::system_error);
+
+  temp_file file("loleseri_record_file_error.bin");
+  { loleseri::record_file_writer<Foo> writer(file.path); }
+  loleseri::record_file<Foo> empty(file.path);
+  ASSERT_EQ(0, empty.size());
+  ASSERT_TRUE(empty.begin() == empty.end());
+  ASSERT_THROW(loleseri::record_file<std::uint32_t>{file.path},
+               loleseri::invalid_record_file);
+}
@@ -0,0 +1,247 @@
+#include <array>
+#include <deque>
+#include <gtest/gtest.h>
+#include <loleseri/compact.hpp>
+#include <loleseri/loleseri.hpp>
+#include <loleseri/packed.hpp>
+#include <loleseri/schema.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+// 同じメンバを何度も並べた、項目の多い構造体
+struct Wide {
+  std::uint8_t m;
+};
+
+template <size_t ix> struct wide_item {
+  using type = std::uint8_t Wide::*;
+};
+
+template <typename indices> struct wide_items;
+
+template <size_t... ix> struct wide_items<loleseri::index_sequence<ix...>> {
+  using list_type = std::tuple<typename wide_item<ix>::type...>;
+  static list_type list() {
+    return list_type((static_cast<void>(ix), &Wide::m)...);
+  }
+};
+
+// Point と同じ並び。名前は違っても同じ hash になる
+struct Size {
+  std::int32_t width;
+  std::int32_t height;
+};
+
+struct Shape {
+  std::uint16_t kind;
+  Point points[4];
+  std::vector<double> weights;
+  std::string name;
+};
+
+// points が std::array になっているだけ
+struct ShapeA {
+  std::uint16_t kind;
+  std::array<Point, 4> points;
+  std::vector<double> weights;
+  std::string name;
+};
+
+// points の要素数が違う
+struct Shape3 {
+  std::uint16_t kind;
+  Point points[3];
+  std::vector<double> weights;
+  std::string name;
+};
+
+struct Flags {
+  bool a;
+  bool b;
+  bool c;
+};
+
+struct Packed {
+  bool a;
+  bool b;
+  bool c;
+};
+
+struct Compact {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Point> {
+  using list_type = std::tuple<std::int32_t Point::*, std::int32_t Point::*>;
+  static inline list_type list() { return list_type{&Point::x, &Point::y}; }
+};
+
+template <> struct items<Size> {
+  using list_type = std::tuple<std::int32_t Size::*, std::int32_t Size::*>;
+  static inline list_type list() {
+    return list_type{&Size::width, &Size::height};
+  }
+};
+
+template <> struct items<Shape> {
+  using list_type = std::tuple<std::uint16_t Shape::*, Point(Shape::*)[4],
+                               std::vector<double> Shape::*,
+                               std::string Shape::*>;
+  static inline list_type list() {
+    return list_type{&Shape::kind, &Shape::points, &Shape::weights,
+                     &Shape::name};
+  }
+};
+
+template <> struct items<ShapeA> {
+  using list_type =
+      std::tuple<std::uint16_t ShapeA::*, std::array<Point, 4> ShapeA::*,
+                 std::vector<double> ShapeA::*, std::string ShapeA::*>;
+  static inline list_type list() {
+    return list_type{&ShapeA::kind, &ShapeA::points, &ShapeA::weights,
+                     &ShapeA::name};
+  }
+};
+
+template <> struct items<Shape3> {
+  using list_type = std::tuple<std::uint16_t Shape3::*, Point(Shape3::*)[3],
+                               std::vector<double> Shape3::*,
+                               std::string Shape3::*>;
+  static inline list_type list() {
+    return list_type{&Shape3::kind, &Shape3::points, &Shape3::weights,
+                     &Shape3::name};
+  }
+};
+
+template <> struct items<Flags> {
+  using list_type = std::tuple<bool Flags::*, bool Flags::*, bool Flags::*>;
+  static inline list_type list() {
+    return list_type{&Flags::a, &Flags::b, &Flags::c};
+  }
+};
+
+template <> struct items<Packed> {
+  using list_type =
+      std::tuple<bool_group<Packed, &Packed::a, &Packed::b, &Packed::c>>;
+  static inline list_type list() { return list_type{}; }
+};
+
+template <> struct items<Compact> {
+  using list_type =
+      std::tuple<compact_item<std::int32_t, Compact, compact_encoding::zigzag>,
+                 std::int32_t Compact::*>;
+  static inline list_type list() {
+    return list_type{zigzag(&Compact::x), &Compact::y};
+  }
+};
+template <>
+struct items<Wide> : public wide_items<make_index_sequence<600>> {};
+} // namespace loleseri
+
+// 項目が多くても constexpr の再帰の深さは項目数に比例しない
+constexpr std::uint64_t wide_hash = loleseri::schema_hash<Wide>();
+static_assert(wide_hash != loleseri::schema_hash<Point>(), "wide is hashed");
+
+// コンパイル時定数として使える
+static_assert(loleseri::schema_hash<Point>() == loleseri::schema_hash<Size>(),
+              "names are not mixed");
+static_assert(loleseri::schema_hash<Point>() !=
+                  loleseri::schema_hash<Point, loleseri::byte_order::big>(),
+              "byte order is mixed");
+
+TEST(Schema, Arithmetic) {
+  using loleseri::schema_hash;
+  ASSERT_NE(schema_hash<std::int32_t>(), schema_hash<std::uint32_t>());
+  ASSERT_NE(schema_hash<std::int32_t>(), schema_hash<std::int64_t>());
+  ASSERT_NE(schema_hash<std::uint32_t>(), schema_hash<float>());
+  ASSERT_NE(schema_hash<std::uint8_t>(), schema_hash<bool>());
+  ASSERT_EQ(schema_hash<std::int32_t>(), schema_hash<std::int32_t const>());
+}
+
+TEST(Schema, Containers) {
+  using loleseri::schema_hash;
+  ASSERT_EQ((schema_hash<std::array<std::int16_t, 3>>()),
+            schema_hash<std::int16_t[3]>());
+  ASSERT_NE((schema_hash<std::array<std::int16_t, 3>>()),
+            (schema_hash<std::array<std::int16_t, 4>>()));
+  ASSERT_NE(schema_hash<std::vector<char>>(), schema_hash<std::string>());
+  ASSERT_NE(schema_hash<std::string>(), schema_hash<std::u16string>());
+  ASSERT_NE(schema_hash<std::vector<std::int16_t>>(),
+            schema_hash<std::vector<std::uint16_t>>());
+}
+
+TEST(Schema, Struct) {
+  using loleseri::schema_hash;
+  ASSERT_EQ(schema_hash<Shape>(), schema_hash<ShapeA>());
+  ASSERT_NE(schema_hash<Shape>(), schema_hash<Shape3>());
+  // 入れ子にした構造体と平たく並べたメンバは区別する
+  ASSERT_NE(schema_hash<Point>(), (schema_hash<std::int32_t[2]>()));
+  ASSERT_NE(schema_hash<Point>(), (schema_hash<std::array<Point, 1>>()));
+  // 符号化の違いも区別する
+  ASSERT_NE(schema_hash<Flags>(), schema_hash<Packed>());
+  ASSERT_NE(schema_hash<Point>(), schema_hash<Compact>());
+}
+
+TEST(Schema, Header) {
+  Point const p{-3, 5};
+  std::vector<std::uint8_t> buf(
+      loleseri::schema_checked<Point, loleseri::byte_order::little>::
+          serialized_size(&p));
+  ASSERT_EQ(16, buf.size());
+  ASSERT_EQ(buf.end(), loleseri::serialize_with_schema(buf.begin(), buf.end(),
+                                                       &p));
+  std::uint64_t const hash = loleseri::schema_hash<Point>();
+  for (size_t i = 0; i < 8; ++i) {
+    ASSERT_EQ((hash >> (i * 8)) & 0xff, buf[i]);
+  }
+
+  Point r{};
+  ASSERT_EQ(buf.end(),
+            loleseri::deserialize_with_schema(buf.begin(), buf.end(), &r));
+  ASSERT_EQ(p.x, r.x);
+  ASSERT_EQ(p.y, r.y);
+
+  // 同じ並びなら読める
+  Size s{};
+  std::deque<char> deq(buf.begin(), buf.end());
+  loleseri::deserialize_with_schema(deq.begin(), deq.end(), &s);
+  ASSERT_EQ(-3, s.width);
+  ASSERT_EQ(5, s.height);
+
+  Compact c{};
+  ASSERT_THROW(loleseri::deserialize_with_schema(buf.begin(), buf.end(), &c),
+               loleseri::schema_mismatch);
+  ASSERT_THROW(loleseri::deserialize_with_schema<loleseri::byte_order::big>(
+                   buf.begin(), buf.end(), &r),
+               loleseri::schema_mismatch);
+  ASSERT_THROW(
+      loleseri::deserialize_with_schema(buf.begin(), buf.begin() + 7, &r),
+      loleseri::buffer_overrun);
+}
+
+TEST(Schema, BigEndianHeader) {
+  Point const p{1, 2};
+  std::vector<std::uint8_t> buf(16);
+  loleseri::serialize_with_schema<loleseri::byte_order::big>(buf.begin(),
+                                                             buf.end(), &p);
+  std::uint64_t const hash =
+      loleseri::schema_hash<Point, loleseri::byte_order::big>();
+  ASSERT_EQ(hash >> 56, buf[0]);
+  ASSERT_EQ(2, buf[15]);
+  Point r{};
+  loleseri::deserialize_with_schema<loleseri::byte_order::big>(
+      buf.cbegin(), buf.cend(), &r);
+  ASSERT_EQ(1, r.x);
+  ASSERT_EQ(2, r.y);
+}
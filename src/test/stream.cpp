@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <loleseri/stream.hpp>
+#include <sstream>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+struct Foo {
+  std::uint32_t id;
+  std::int16_t pos[2];
+  std::uint8_t kind;
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.id == b.id && a.pos[0] == b.pos[0] && a.pos[1] == b.pos[1] &&
+         a.kind == b.kind;
+}
+
+struct Packed {
+  std::uint32_t id;
+  std::int32_t value;
+};
+
+bool operator==(Packed const &a, Packed const &b) {
+  return a.id == b.id && a.value == b.value;
+}
+
+Foo make_foo(size_t i) {
+  auto v = static_cast<std::int16_t>(i % 1000);
+  return {static_cast<std::uint32_t>(i), {v, static_cast<std::int16_t>(-v)},
+          static_cast<std::uint8_t>(i)};
+}
+
+/** 書き込みの回数を数えるシンク */
+struct counting_sink {
+  std::vector<std::uint8_t> *bytes;
+  size_t *calls;
+  void write(std::uint8_t const *data, size_t size) {
+    ++*calls;
+    bytes->insert(bytes->end(), data, data + size);
+  }
+  void write(std::uint8_t const *head, size_t head_size,
+             std::uint8_t const *body, size_t body_size) {
+    ++*calls;
+    bytes->insert(bytes->end(), head, head + head_size);
+    bytes->insert(bytes->end(), body, body + body_size);
+  }
+};
+
+} // namespace
+
+namespace loleseri {
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint32_t Foo::*, std::int16_t(Foo::*)[2],
+                               std::uint8_t Foo::*>;
+  static inline list_type list() { return {&Foo::id, &Foo::pos, &Foo::kind}; }
+};
+
+template <> struct items<Packed> {
+  using list_type = std::tuple<std::uint32_t Packed::*, std::int32_t Packed::*>;
+  static inline list_type list() { return {&Packed::id, &Packed::value}; }
+};
+} // namespace loleseri
+
+TEST(Stream, OStream) {
+  std::stringstream ss;
+  {
+    loleseri::stream_writer<Foo, loleseri::ostream_sink> writer(
+        loleseri::ostream_sink{ss}, 7);
+    for (size_t i = 0; i < 100; ++i) {
+      writer.write(make_foo(i));
+    }
+  }
+  ASSERT_EQ(100 * 9, ss.str().size());
+
+  loleseri::stream_reader<Foo, loleseri::istream_source> reader(
+      loleseri::istream_source{ss}, 16);
+  Foo foo;
+  for (size_t i = 0; i < 30; ++i) {
+    ASSERT_TRUE(reader.read(&foo));
+    ASSERT_EQ(make_foo(i), foo);
+  }
+  std::vector<Foo> rest(100);
+  ASSERT_EQ(70, reader.read(rest.data(), rest.size()));
+  ASSERT_EQ(make_foo(30), rest[0]);
+  ASSERT_EQ(make_foo(99), rest[69]);
+  ASSERT_FALSE(reader.read(&foo));
+}
+
+TEST(Stream, FileDescriptor) {
+  int fds[2];
+  ASSERT_EQ(0, ::pipe(fds));
+  std::vector<Foo> foos;
+  for (size_t i = 0; i < 50; ++i) {
+    foos.push_back(make_foo(i));
+  }
+  {
+    loleseri::stream_writer<Foo, loleseri::fd_sink, loleseri::byte_order::big>
+        writer(loleseri::fd_sink{fds[1]});
+    writer.write(foos.data(), foos.size());
+  }
+  ::close(fds[1]);
+  loleseri::stream_reader<Foo, loleseri::fd_source, loleseri::byte_order::big>
+      reader(loleseri::fd_source{fds[0]});
+  std::vector<Foo> restored(60);
+  ASSERT_EQ(50, reader.read(restored.data(), restored.size()));
+  restored.resize(50);
+  ASSERT_EQ(foos, restored);
+  ::close(fds[0]);
+}
+
+TEST(Stream, GatherWrite) {
+  std::vector<std::uint8_t> bytes;
+  size_t calls = 0;
+  std::vector<Packed> packed(100);
+  for (size_t i = 0; i < packed.size(); ++i) {
+    packed[i] = {static_cast<std::uint32_t>(i), -static_cast<std::int32_t>(i)};
+  }
+  {
+    loleseri::stream_writer<Packed, counting_sink> writer(
+        counting_sink{&bytes, &calls}, 10);
+    writer.write(packed[0]);
+    // バッファに収まらない一括書き込みは、バッファと一緒に一度で書く
+    writer.write(packed.data() + 1, packed.size() - 1);
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(800, bytes.size());
+  }
+  ASSERT_EQ(1, calls);
+  std::stringstream ss(std::string(bytes.begin(), bytes.end()));
+  loleseri::stream_reader<Packed, loleseri::istream_source> reader(
+      loleseri::istream_source{ss});
+  std::vector<Packed> restored(100);
+  ASSERT_EQ(100, reader.read(restored.data(), restored.size()));
+  ASSERT_EQ(packed, restored);
+}
+
+TEST(Stream, Truncated) {
+  std::stringstream ss(std::string(13, '\0'));
+  loleseri::stream_reader<Foo, loleseri::istream_source> reader(
+      loleseri::istream_source{ss});
+  Foo foo;
+  ASSERT_TRUE(reader.read(&foo));
+  ASSERT_THROW(reader.read(&foo), loleseri::buffer_overrun);
+}
@@ -1,3 +1,4 @@
+#include <deque>
 #include <gtest/gtest.h>
 #include <loleseri/loleseri.hpp>
 #include <tuple>
@@ -69,6 +70,20 @@ bool operator==(Baz const &a, Baz const &b) {
 
 const auto bazMembers = std::make_tuple(&Baz::grape, &Baz::kiwi, &Baz::melon);
 
+// メンバの多い構造体
+struct Wide {
+  std::uint8_t m[3];
+  std::uint32_t a0, a1, a2, a3, a4, a5, a6, a7, a8, a9;
+  std::int16_t b0, b1, b2, b3, b4, b5, b6, b7, b8, b9;
+  double c;
+};
+
+const auto wideMembers = std::make_tuple(
+    &Wide::m, &Wide::a0, &Wide::a1, &Wide::a2, &Wide::a3, &Wide::a4,
+    &Wide::a5, &Wide::a6, &Wide::a7, &Wide::a8, &Wide::a9, &Wide::b0,
+    &Wide::b1, &Wide::b2, &Wide::b3, &Wide::b4, &Wide::b5, &Wide::b6,
+    &Wide::b7, &Wide::b8, &Wide::b9, &Wide::c);
+
 } // namespace
 
 namespace loleseri {
@@ -87,6 +102,10 @@ template <> struct items<Baz> {
   static inline decltype(bazMembers) list() { return bazMembers; }
 };
 
+template <> struct items<Wide> {
+  static inline decltype(wideMembers) list() { return wideMembers; }
+};
+
 } // namespace loleseri
 
 TEST(Struct, Simple) {
@@ -154,3 +173,42 @@ TEST(Struct, ArrayInStruct) {
   ASSERT_EQ(value, v0);
   ASSERT_EQ(value, v1);
 }
+
+TEST(Struct, Wide) {
+  using list_type = std::decay<decltype(wideMembers)>::type;
+  static_assert(loleseri::offset_of_item<list_type, 0>::value == 0, "m");
+  static_assert(loleseri::offset_of_item<list_type, 1>::value == 3, "a0");
+  static_assert(loleseri::offset_of_item<list_type, 11>::value == 43, "b0");
+  static_assert(loleseri::offset_of_item<list_type, 21>::value == 63, "c");
+  using seri = loleseri::serializer<Wide>;
+  ASSERT_EQ(71, seri::size);
+
+  Wide value{};
+  value.m[2] = 5;
+  value.a0 = 0x01020304;
+  value.a9 = 99;
+  value.b0 = -2;
+  value.b9 = 1234;
+  value.c = 0.25;
+  seri::buffer buffer;
+  ASSERT_EQ(buffer.end(),
+            seri::serialize(buffer.begin(), buffer.end(), &value));
+  ASSERT_EQ(0x04, buffer[3]);
+  ASSERT_EQ(0xfe, buffer[43]);
+  ASSERT_EQ(0xff, buffer[44]);
+
+  // 足りないバッファ
+  ASSERT_THROW(
+      loleseri::serialize_bounded(buffer.begin(), buffer.end() - 1, &value),
+      loleseri::buffer_overrun);
+
+  std::deque<char> deq(buffer.begin(), buffer.end());
+  Wide r{};
+  loleseri::deserialize(deq.cbegin(), deq.cend(), &r);
+  ASSERT_EQ(5, r.m[2]);
+  ASSERT_EQ(value.a0, r.a0);
+  ASSERT_EQ(value.a9, r.a9);
+  ASSERT_EQ(value.b0, r.b0);
+  ASSERT_EQ(value.b9, r.b9);
+  ASSERT_EQ(value.c, r.c);
+}
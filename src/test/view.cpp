@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <loleseri/view.hpp>
+#include <tuple>
+
+namespace {
+struct Foo {
+  std::uint8_t hoge;
+  float fuga;
+};
+
+bool operator==(Foo const &a, Foo const &b) {
+  return a.hoge == b.hoge && a.fuga == b.fuga;
+}
+
+struct Bar {
+  std::uint16_t orange;
+  Foo banana;
+  std::array<Foo, 3> grape;
+  std::int32_t kiwi[4];
+};
+
+} // namespace
+
+namespace loleseri {
+
+template <> struct items<Foo> {
+  using list_type = std::tuple<std::uint8_t Foo::*, float Foo::*>;
+  static inline list_type list() { return {&Foo::hoge, &Foo::fuga}; }
+};
+
+template <> struct items<Bar> {
+  using list_type =
+      std::tuple<std::uint16_t Bar::*, Foo Bar::*, std::array<Foo, 3> Bar::*,
+                 std::int32_t(Bar::*)[4]>;
+  static inline list_type list() {
+    return {&Bar::orange, &Bar::banana, &Bar::grape, &Bar::kiwi};
+  }
+};
+} // namespace loleseri
+
+TEST(View, Offset) {
+  using view_t = loleseri::view<Bar>;
+  static_assert(view_t::offset<0>() == 0, "orange is at 0");
+  static_assert(view_t::offset<1>() == 2, "banana is at 2");
+  static_assert(view_t::offset<2>() == 7, "grape is at 7");
+  static_assert(view_t::offset<3>() == 22, "kiwi is at 22");
+  static_assert(view_t::size == 38, "size of Bar is 38");
+  static_assert(view_t::item_count == 4, "Bar has 4 items");
+}
+
+TEST(View, Struct) {
+  Bar value = {0x9876,
+               {11, 2233.4455f},
+               {{{1, 1.5f}, {2, 2.5f}, {3, 3.5f}}},
+               {-1, 2, -3, 4}};
+  loleseri::serializer<Bar>::buffer buffer;
+  loleseri::serialize(buffer.begin(), buffer.end(), &value);
+
+  auto v = loleseri::make_view<Bar>(buffer.cbegin(), buffer.cend());
+  ASSERT_EQ(buffer.cbegin(), v.begin());
+  ASSERT_EQ(buffer.cend(), v.end());
+  ASSERT_EQ(0x9876, v.get<0>());
+  ASSERT_EQ(value.banana, v.get<1>());
+  ASSERT_EQ(2233.4455f, v.at<1>().get<1>());
+  ASSERT_EQ(value.grape, v.get<2>());
+  ASSERT_EQ(value.grape[1], v.at<2>()[1].get());
+  ASSERT_EQ(3.5f, v.at<2>()[2].get<1>());
+  ASSERT_EQ(value.grape[2], v.at<2>().get(2));
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(value.kiwi[i], v.at<3>()[i].get());
+  }
+
+  std::int32_t kiwi[4];
+  v.at<3>().deserialize(&kiwi);
+  ASSERT_EQ(0, std::memcmp(kiwi, value.kiwi, sizeof(kiwi)));
+
+  Bar restored = v.get();
+  ASSERT_EQ(value.orange, restored.orange);
+  ASSERT_EQ(value.grape, restored.grape);
+}
+
+TEST(View, ByteOrder) {
+  Foo value = {0x7b, 987.654f};
+  std::array<std::uint8_t, 5> buffer;
+  loleseri::serialize<loleseri::byte_order::big>(buffer.begin(), buffer.end(),
+                                                 &value);
+  auto v = loleseri::make_view<loleseri::byte_order::big, Foo>(buffer.cbegin(),
+                                                               buffer.cend());
+  ASSERT_EQ(987.654f, v.get<1>());
+}